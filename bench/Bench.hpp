@@ -0,0 +1,41 @@
+#ifndef FLEXUS_BENCH_BENCH_HPP_INCLUDED
+#define FLEXUS_BENCH_BENCH_HPP_INCLUDED
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace nBench {
+
+// Advances the cycle count seen by components (theFlexus->cycleCount())
+void
+advanceCycles(uint64_t aCycles = 1);
+
+// Length of the pre-generated address streams; a power of two so benchmarks
+// can wrap around it with a mask
+static const size_t kStreamLength = 1 << 16;
+
+// Block addresses of which roughly aHitPercent percent fall into a working set
+// of aResidentBlocks blocks (and thus hit once the structure is warm), the
+// rest streaming through never reused blocks.
+inline std::vector<uint64_t>
+addressStream(uint64_t aResidentBlocks, int aHitPercent, uint64_t aBlockSize, uint64_t aSeed = 1)
+{
+    std::mt19937_64 random(aSeed);
+    std::uniform_int_distribution<uint64_t> resident(0, aResidentBlocks - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<uint64_t> stream;
+    stream.reserve(kStreamLength);
+    uint64_t fresh = aResidentBlocks;
+    for (size_t i = 0; i < kStreamLength; ++i) {
+        uint64_t block = percent(random) < aHitPercent ? resident(random) : fresh++;
+        stream.push_back(block * aBlockSize);
+    }
+    return stream;
+}
+
+} // namespace nBench
+
+#endif // FLEXUS_BENCH_BENCH_HPP_INCLUDED
@@ -0,0 +1,105 @@
+// Micro-benchmarks of the simulator's hot data structures, built as
+// flexus-bench when configured with -DFLEXUS_BENCH=ON. Nothing here needs
+// QEMU: this file provides an empty layout and a stand-in for the Flexus
+// object, so the structures are timed exactly as the components use them.
+//
+// Results are written with the usual Google Benchmark options, e.g.
+//
+//    flexus-bench --benchmark_out=base.json --benchmark_out_format=json
+//
+// and two result files are compared with bench/compare.py.
+#define FLEXUS_WIRING_FILE
+#include <core/simulator_layout.hpp>
+
+#include <core/simulator_name.hpp>
+namespace Flexus {
+std::string theSimulatorName = "flexus-bench v1.0";
+}
+
+#include FLEXUS_BEGIN_DECLARATION_SECTION()
+
+// No components: the benchmarks construct the structures they time directly.
+// Component headers normally bring in the transport (and mpl) declarations.
+#include <core/component.hpp>
+#include <core/transport.hpp>
+
+#include FLEXUS_END_DECLARATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_CONFIGURATION_SECTION()
+
+bool initializeParameters() {
+  return false;
+}
+
+#include FLEXUS_END_COMPONENT_CONFIGURATION_SECTION()
+
+// clang-format off
+#include FLEXUS_BEGIN_COMPONENT_INSTANTIATION_SECTION()
+#include FLEXUS_END_COMPONENT_INSTANTIATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_WIRING_SECTION()
+#include FLEXUS_END_COMPONENT_WIRING_SECTION()
+
+#include FLEXUS_BEGIN_DRIVE_ORDER_SECTION()
+
+  mpl::vector < >
+,  mpl::vector < >
+
+#include FLEXUS_END_DRIVE_ORDER_SECTION()
+// clang-format on
+
+#include "Bench.hpp"
+
+#include <core/component.hpp>
+#include <core/flexus.hpp>
+#include <core/stats.hpp>
+
+namespace nBench {
+
+namespace {
+
+class BenchFlexus : public Flexus::Core::FlexusInterface
+{
+  public:
+    uint64_t theCycleCount = 0;
+
+    void initializeComponents() {}
+    void doCycle() { ++theCycleCount; }
+    void setCycle(uint64_t aCycle) { theCycleCount = aCycle; }
+    bool quiescing() const { return false; }
+    uint64_t cycleCount() const { return theCycleCount; }
+    void reset_core_watchdog(uint32_t) {}
+    void terminateSimulation() {}
+    void setDebug(std::string const& aDebugSeverity) {}
+    void setStatInterval(uint64_t) {}
+    void setStopCycle(uint64_t) {}
+    void set_log_delay(uint64_t) {}
+    void setFrequency(std::string const& aSpec) {}
+    void doLoad(std::string const& aDirName) {}
+    void doSave(std::string const& aDirName) {}
+    void writeMeasurement(std::string const& aMeasurement, std::string const& aFilename) {}
+} theBenchFlexus;
+
+} // namespace
+
+void
+advanceCycles(uint64_t aCycles)
+{
+    theBenchFlexus.theCycleCount += aCycles;
+}
+
+} // namespace nBench
+
+int
+main(int argc, char** argv)
+{
+    Flexus::Core::theFlexus = &nBench::theBenchFlexus;
+    Flexus::Core::ComponentManager::getComponentManager().instantiateComponents(1, nullptr);
+    Flexus::Stat::getStatManager()->initialize();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "Bench.hpp"
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/list.hpp>
+#include <core/boost_extensions/intrusive_ptr.hpp>
+#include <core/types.hpp>
+
+#include <components/Cache/AbstractArray.hpp>
+#include <components/Cache/BasicCacheState.hpp>
+#include <memory>
+
+namespace nBench {
+
+using nCache::AbstractArray;
+using nCache::BasicCacheState;
+using nCache::MemoryAddress;
+
+// A cache access as done by InclusiveMOESI: look the block up, touch it on a
+// hit, otherwise allocate it in place of the LRU victim.
+// Arguments: size (KB), associativity, hit rate (%)
+static void
+BM_StdArrayAccess(benchmark::State& state)
+{
+    const uint64_t block_size = 64;
+    const uint64_t size       = state.range(0) * 1024;
+    std::string config =
+      "STD:size=" + std::to_string(size) + ":assoc=" + std::to_string(state.range(1)) + ":repl=LRU";
+    std::unique_ptr<AbstractArray<BasicCacheState>> array(
+      nCache::constructArray<BasicCacheState, BasicCacheState::Invalid>(config, "bench", 0, block_size));
+
+    std::vector<uint64_t> stream = addressStream(size / block_size / 2, state.range(2), block_size);
+    size_t next                  = 0;
+    for (auto _ : state) {
+        MemoryAddress address(stream[next++ & (kStreamLength - 1)]);
+        auto lookup = (*array)[address];
+        if (lookup->hit()) {
+            array->recordAccess(lookup);
+        } else {
+            auto victim = array->allocate(lookup, address);
+            benchmark::DoNotOptimize(victim->state());
+            lookup->setState(BasicCacheState::Shared);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdArrayAccess)
+  ->ArgNames({ "KB", "assoc", "hit%" })
+  ->ArgsProduct({ { 64, 1024 }, { 4, 8, 16 }, { 50, 95 } });
+
+} // namespace nBench
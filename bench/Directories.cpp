@@ -0,0 +1,107 @@
+#include "Bench.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <components/CommonQEMU/MessageQueues.hpp>
+#include <core/boost_extensions/intrusive_ptr.hpp>
+#include <core/simulator_layout.hpp>
+
+#include <components/CMPCache/AbstractArray.hpp>
+#include <components/CMPCache/AbstractPolicy.hpp>
+#include <components/CMPCache/CacheState.hpp>
+#include <components/CMPCache/NonInclusiveMESIPolicy.hpp>
+#include <memory>
+
+namespace nBench {
+
+using nCMPCache::AbstractDirectory;
+using nCMPCache::CMPCacheInfo;
+using nCMPCache::MemoryAddress;
+using nCMPCache::SimpleDirectoryState;
+
+// Directory of one L2 bank of the given type ("std" or "infinite") tracking
+// aCores sharers, with the default knottykraken interleaving
+static std::unique_ptr<AbstractDirectory<SimpleDirectoryState, SimpleDirectoryState>>
+makeDirectory(std::string aType, std::string aConfig, int32_t aCores)
+{
+    std::string policy("NonInclusiveMESI"), cache_config;
+    CMPCacheInfo info(0,
+                      "bench",
+                      policy,
+                      aType,
+                      aConfig,
+                      cache_config,
+                      aCores,
+                      64,
+                      1,
+                      64,
+                      1,
+                      4096,
+                      32,
+                      16,
+                      16,
+                      false,
+                      eL2,
+                      3,
+                      1,
+                      1,
+                      1,
+                      1,
+                      1,
+                      16);
+    return std::unique_ptr<AbstractDirectory<SimpleDirectoryState, SimpleDirectoryState>>(
+      nCMPCache::constructDirectory<SimpleDirectoryState, SimpleDirectoryState>(info));
+}
+
+// A directory access as done by NonInclusiveMESIPolicy::doRequest: look the
+// block up and add the requester as a sharer, allocating an entry on a miss.
+// Victims pushed to the directory evict buffer are retired immediately.
+static void
+runDirectory(benchmark::State& state,
+             AbstractDirectory<SimpleDirectoryState, SimpleDirectoryState>& aDirectory,
+             std::vector<uint64_t> const& aStream,
+             int32_t aCores)
+{
+    auto* evict_buffer = aDirectory.getEvictBuffer();
+    size_t next        = 0;
+    for (auto _ : state) {
+        MemoryAddress address(aStream[next & (kStreamLength - 1)]);
+        int32_t requester = next++ % aCores;
+        auto lookup       = aDirectory.lookup(address);
+        if (lookup->found()) {
+            lookup->addSharer(requester);
+        } else {
+            SimpleDirectoryState sharers(aCores);
+            sharers.addSharer(requester);
+            aDirectory.allocate(lookup, address, sharers);
+        }
+        if (!evict_buffer->empty()) evict_buffer->remove(evict_buffer->oldestRequiringInvalidates()->address());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Arguments: sets, associativity, cores, hit rate (%)
+static void
+BM_StdDirectoryAccess(benchmark::State& state)
+{
+    int32_t cores = state.range(2);
+    auto directory =
+      makeDirectory("std", "sets=" + std::to_string(state.range(0)) + ":assoc=" + std::to_string(state.range(1)), cores);
+    runDirectory(state, *directory, addressStream(state.range(0) * state.range(1) / 2, state.range(3), 64), cores);
+}
+BENCHMARK(BM_StdDirectoryAccess)
+  ->ArgNames({ "sets", "assoc", "cores", "hit%" })
+  ->ArgsProduct({ { 1024, 16384 }, { 8, 16 }, { 4, 64 }, { 50, 95 } });
+
+// Arguments: tracked blocks (K), cores, hit rate (%)
+static void
+BM_InfiniteDirectoryAccess(benchmark::State& state)
+{
+    int32_t cores  = state.range(1);
+    auto directory = makeDirectory("infinite", "", cores);
+    runDirectory(state, *directory, addressStream(state.range(0) * 1024, state.range(2), 64), cores);
+}
+BENCHMARK(BM_InfiniteDirectoryAccess)
+  ->ArgNames({ "Kblocks", "cores", "hit%" })
+  ->ArgsProduct({ { 16, 256 }, { 4, 64 }, { 50, 95 } });
+
+} // namespace nBench
@@ -0,0 +1,68 @@
+#include "Bench.hpp"
+
+#include <components/Decoder/SemanticActions.hpp>
+
+namespace nBench {
+
+using nDecoder::eOpType;
+using nDecoder::execute_kernel;
+using nDecoder::Operand;
+using nDecoder::OperandSpan;
+using nDecoder::Operation;
+
+// The integer operations timed below, as range(0)
+static const eOpType kOpTypes[] = { nDecoder::kADDS64_, nDecoder::kSUB_ };
+
+// Random operand pairs, the same for the kernel and the Operation runs
+static std::vector<uint64_t>
+operandStream()
+{
+    std::mt19937_64 random(1);
+    std::vector<uint64_t> operands;
+    for (size_t i = 0; i < 2 * kStreamLength; ++i) {
+        operands.push_back(random());
+    }
+    return operands;
+}
+
+// The execute kernel ExecuteAction calls for an operation that has one: a
+// plain call through the kernel pointer over native operands.
+// Arguments: operation (0 ADDS64, 1 SUB)
+static void
+BM_ExecuteKernel(benchmark::State& state)
+{
+    bool sets_flags;
+    execute_kernel kernel          = nDecoder::executeKernel(kOpTypes[state.range(0)], sets_flags);
+    std::vector<uint64_t> operands = operandStream();
+
+    size_t next = 0;
+    for (auto _ : state) {
+        uint64_t const* op = &operands[2 * (next++ & (kStreamLength - 1))];
+        benchmark::DoNotOptimize(kernel(op, 2));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteKernel)->ArgNames({ "op" })->DenseRange(0, 1);
+
+// The same operations through the virtual Operation::operator() over Operand
+// variants, the path ExecuteAction takes without a kernel, reading the NZCV
+// bits as it does when the operation sets flags.
+// Arguments: operation (0 ADDS64, 1 SUB)
+static void
+BM_ExecuteOperation(benchmark::State& state)
+{
+    std::unique_ptr<Operation> operation = nDecoder::operation(kOpTypes[state.range(0)]);
+    std::vector<uint64_t> values         = operandStream();
+    std::vector<Operand> operands(values.begin(), values.end());
+
+    size_t next = 0;
+    for (auto _ : state) {
+        OperandSpan op(&operands[2 * (next++ & (kStreamLength - 1))], 2);
+        benchmark::DoNotOptimize((*operation)(op));
+        if (operation->hasNZCVFlags()) benchmark::DoNotOptimize(operation->getNZCVbits());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteOperation)->ArgNames({ "op" })->DenseRange(0, 1);
+
+} // namespace nBench
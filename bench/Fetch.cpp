@@ -0,0 +1,81 @@
+#include "Bench.hpp"
+
+#include <components/uFetch/SimCache.hpp>
+#include <components/uFetch/uFetchTypes.hpp>
+
+namespace nBench {
+
+// The L1i as uFetch drives it: look up every fetch block, and insert the
+// line on a miss as the fill would. Consecutive fetch blocks of one line
+// are looked up back to back.
+// Arguments: size (KB), associativity, hit rate (%), fetch blocks per line
+static void
+BM_L1iFetch(benchmark::State& state)
+{
+    const uint64_t block_size = 64;
+    SimCache cache;
+    cache.init(state.range(0) * 1024, state.range(1), block_size, "bench-L1i");
+
+    std::vector<uint64_t> lines = addressStream(state.range(0) * 1024 / block_size / 2, state.range(2), block_size);
+    std::vector<uint64_t> stream;
+    for (size_t i = 0; stream.size() < kStreamLength; ++i) {
+        for (int64_t j = 0; j < state.range(3) && stream.size() < kStreamLength; ++j) {
+            stream.push_back(lines[i] + j * block_size / state.range(3));
+        }
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        uint64_t address = stream[next++ & (kStreamLength - 1)];
+        if (!cache.lookup(address)) { benchmark::DoNotOptimize(cache.insert(address)); }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_L1iFetch)
+  ->ArgNames({ "KB", "assoc", "hit%", "per-line" })
+  ->ArgsProduct({ { 32, 64 }, { 4, 8 }, { 95, 100 }, { 1, 4 } });
+
+using Flexus::SharedTypes::FetchAddr;
+using Flexus::SharedTypes::FetchBundle;
+using Flexus::SharedTypes::FetchedOpcode;
+using Flexus::SharedTypes::pFetchBundle;
+using Flexus::SharedTypes::VirtualMemoryAddress;
+
+// The frontend queues over one cycle: the FAG fills the FAQ, uFetch moves
+// the addresses to the opcodes waiting for translation, the translations
+// resolve and the resolved opcodes leave in a bundle for the decoder.
+// Arguments: fetch width (instructions per cycle)
+static void
+BM_FetchQueueCycle(benchmark::State& state)
+{
+    const size_t width = state.range(0);
+    boost::circular_buffer<FetchAddr> faq(2 * width);
+    boost::circular_buffer<FetchedOpcode> waiting(2 * width);
+    pFetchBundle bundle(new FetchBundle);
+    bundle->theOpcodes.reserve(width);
+
+    uint64_t pc = 0x1000;
+    for (auto _ : state) {
+        for (size_t i = 0; i < width; ++i, pc += 4) {
+            faq.push_back(FetchAddr(VirtualMemoryAddress(pc)));
+        }
+        while (!faq.empty()) {
+            ringPush(waiting,
+                     FetchedOpcode(faq.front().theAddress, 0xefffffff, Flexus::SharedTypes::eL1I, nullptr, nullptr));
+            faq.pop_front();
+        }
+        for (auto& opcode : waiting) {
+            opcode.theOpcode = uint32_t(opcode.thePC);
+        }
+        bundle->clear();
+        while (!waiting.empty()) {
+            bundle->theOpcodes.push_back(waiting.front());
+            waiting.pop_front();
+        }
+        benchmark::DoNotOptimize(bundle->theOpcodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * width);
+}
+BENCHMARK(BM_FetchQueueCycle)->ArgName("width")->Arg(4)->Arg(8);
+
+} // namespace nBench
@@ -0,0 +1,60 @@
+#include "Bench.hpp"
+
+#include <core/debug/debug.hpp>
+#include <core/stats.hpp>
+
+namespace nBench {
+
+namespace Stat = Flexus::Stat;
+
+// Counter increments with the given number of periodic measurements open
+// over the counter, as when periodic stats are configured for phase analysis.
+// Arguments: open periodic measurements
+static void
+BM_StatCounterIncrement(benchmark::State& state)
+{
+    static int theRun = 0;
+    std::string name  = "bench-counter-" + std::to_string(theRun++);
+    // Stats stay registered with the StatManager, so they are never destroyed
+    Stat::StatCounter& counter = *new Stat::StatCounter(name);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        Stat::getStatManager()->openPeriodicMeasurement(
+          name + "-periodic-" + std::to_string(i), 100000, Flexus::Stat::accumulation_type::Reset, name);
+    }
+
+    for (auto _ : state) {
+        ++counter;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatCounterIncrement)->ArgName("measurements")->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+// Construction of the entry every enabled DBG_ statement builds before it is
+// filtered and formatted
+static void
+BM_DbgEntryConstruct(benchmark::State& state)
+{
+    for (auto _ : state) {
+        Flexus::Dbg::Entry entry(Flexus::Dbg::SevDev, __FILE__, __LINE__, __FUNCTION__, 0, 0);
+        entry.set("Message", "Found block 1000 in set 40");
+        benchmark::DoNotOptimize(entry);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DbgEntryConstruct);
+
+// A DBG_ statement below the minimum severity, i.e. the cost of leaving
+// VVerb messages in a hot path
+static void
+BM_DbgSuppressed(benchmark::State& state)
+{
+    uint64_t address = 0x1000;
+    for (auto _ : state) {
+        DBG_(VVerb, (<< "Found block " << std::hex << address));
+        benchmark::DoNotOptimize(address);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DbgSuppressed);
+
+} // namespace nBench
@@ -0,0 +1,79 @@
+#include "Bench.hpp"
+
+#include <components/BranchPredictor/TAGEImpl.hpp>
+#include <components/MMU/MMUImpl.hpp>
+
+namespace nBench {
+
+using Flexus::SharedTypes::BPredState;
+using Flexus::SharedTypes::kConditional;
+using Flexus::SharedTypes::TageGeometry;
+using Flexus::SharedTypes::TagePredictor;
+using Flexus::SharedTypes::Translation;
+using Flexus::SharedTypes::TranslationPtr;
+
+// One conditional branch through TAGE the way BranchPredictor handles it:
+// checkpoint the history, predict, then train with the outcome.
+// The default geometry has 7 tables, which has a specialized kernel; 8 tables
+// run the generic one.
+// Arguments: distinct branches, taken bias (%), tagged tables
+static void
+BM_TagePredictUpdate(benchmark::State& state)
+{
+    TageGeometry geometry;
+    geometry.NHIST = state.range(2);
+    std::unique_ptr<TagePredictor> tage(TagePredictor::create(geometry));
+    std::vector<uint64_t> pcs = addressStream(state.range(0), 100, 4);
+    std::mt19937 random(1);
+    std::vector<bool> outcomes;
+    for (size_t i = 0; i < kStreamLength; ++i) {
+        outcomes.push_back(int(random() % 100) < state.range(1));
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        uint64_t pc = 0x400000 + pcs[next & (kStreamLength - 1)];
+        bool taken  = outcomes[next++ & (kStreamLength - 1)];
+
+        BPredState bp_state;
+        bp_state.thePredictedType    = kConditional;
+        bp_state.theTageHistoryValid = false;
+        tage->checkpointHistory(bp_state);
+        benchmark::DoNotOptimize(tage->get_prediction(pc, bp_state));
+        tage->update_predictor(pc, bp_state, taken);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TagePredictUpdate)
+  ->ArgNames({ "branches", "taken%", "tables" })
+  ->ArgsProduct({ { 256, 16384 }, { 50, 90 }, { 7, 8 } });
+
+// A TLB lookup followed, on a miss, by the insert of the walked translation.
+// Arguments: entries, associativity, hit rate (%)
+static void
+BM_TLBLookupInsert(benchmark::State& state)
+{
+    nMMU::PAGEMASK = ~((1ULL << 12) - 1);
+    nMMU::TLB tlb;
+    tlb.resize(state.range(1), state.range(0) / state.range(1));
+
+    std::vector<uint64_t> pages = addressStream(state.range(0) / 2, state.range(2), 4096);
+    TranslationPtr tr(new Translation());
+    tr->theASID = 1;
+    tr->theNG   = true;
+
+    size_t next = 0;
+    for (auto _ : state) {
+        tr->theVaddr = VirtualMemoryAddress(pages[next++ & (kStreamLength - 1)]);
+        if (!tlb.lookUp(tr).first) {
+            tr->thePaddr = PhysicalMemoryAddress(uint64_t(tr->theVaddr) | (1ULL << 40));
+            tlb.insert(tr);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TLBLookupInsert)
+  ->ArgNames({ "entries", "assoc", "hit%" })
+  ->ArgsProduct({ { 64, 1024 }, { 4, 8 }, { 90, 99 } });
+
+} // namespace nBench
@@ -0,0 +1,64 @@
+#include "Bench.hpp"
+
+#include <components/CommonQEMU/MessageQueues.hpp>
+
+namespace nBench {
+
+using Flexus::SharedTypes::MemoryMessage;
+using Flexus::SharedTypes::MemoryMessageTag;
+using Flexus::SharedTypes::MemoryTransport;
+using Flexus::SharedTypes::PhysicalMemoryAddress;
+using Flexus::SharedTypes::VirtualMemoryAddress;
+using nMessageQueues::DelayFifo;
+using nMessageQueues::MessageQueue;
+
+static MemoryTransport
+makeTransport()
+{
+    MemoryTransport transport;
+    transport.set(MemoryMessageTag,
+                  new MemoryMessage(MemoryMessage::LoadReq, PhysicalMemoryAddress(0x1000), VirtualMemoryAddress(0)));
+    return transport;
+}
+
+// Cache controller style queue traffic: keep the queue at the given
+// occupancy and move one transport through it per iteration.
+// Arguments: occupancy
+static void
+BM_MessageQueueEnqueueDequeue(benchmark::State& state)
+{
+    MessageQueue<MemoryTransport> queue(state.range(0) + 1);
+    MemoryTransport transport = makeTransport();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        queue.enqueue(transport);
+    }
+
+    for (auto _ : state) {
+        if (queue.hasSpace(1)) queue.enqueue(transport);
+        benchmark::DoNotOptimize(queue.dequeue());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MessageQueueEnqueueDequeue)->ArgName("occupancy")->Arg(1)->Arg(16)->Arg(64);
+
+// Delayed delivery: one transport enters per cycle with the given latency and
+// whatever is ready leaves.
+// Arguments: latency (cycles)
+static void
+BM_DelayFifoCycle(benchmark::State& state)
+{
+    DelayFifo<MemoryTransport> fifo(state.range(0) + 1);
+    MemoryTransport transport = makeTransport();
+
+    for (auto _ : state) {
+        fifo.enqueue(transport, state.range(0));
+        while (fifo.ready()) {
+            benchmark::DoNotOptimize(fifo.dequeue());
+        }
+        advanceCycles();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DelayFifoCycle)->ArgName("latency")->Arg(1)->Arg(8)->Arg(32);
+
+} // namespace nBench
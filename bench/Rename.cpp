@@ -0,0 +1,136 @@
+#include "Bench.hpp"
+
+#include <components/Decoder/SemanticInstruction.hpp>
+#include <components/uArch/BypassNetwork.hpp>
+#include <components/uArch/MapTable.hpp>
+#include <components/uArch/RegisterFile.hpp>
+
+#include <deque>
+
+namespace nBench {
+
+using nuArch::BypassNetwork;
+using nuArch::InstructionDependance;
+using nuArch::mapped_reg;
+using nuArch::PhysicalMap;
+using nuArch::pRegister;
+using nuArch::regName;
+using nuArch::RegisterFile;
+
+// Architectural names of the integer map table (see kxRegs_Total)
+static const int32_t kNames = 32;
+
+// Rename at dispatch and free at retirement, the way the core model drives
+// the map table: each rename takes a register from the free list, and the
+// register it replaced returns there once a window of younger renames has
+// gone by. The in-flight renames must leave a free register over the
+// architectural names.
+// Arguments: physical registers, in-flight renames
+static void
+BM_RenameFree(benchmark::State& state)
+{
+    PhysicalMap map(kNames, state.range(0));
+    std::vector<uint64_t> names = addressStream(kNames, 100, 1);
+    std::deque<pRegister> retiring;
+
+    size_t next = 0;
+    for (auto _ : state) {
+        regName name = regName(names[next++ & (kStreamLength - 1)]);
+        retiring.push_back(map.create(name).second);
+        if (retiring.size() > size_t(state.range(1))) {
+            map.free(retiring.front());
+            retiring.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RenameFree)
+  ->ArgNames({ "registers", "in-flight" })
+  ->ArgsProduct({ { 128, 256 }, { 32, 90 } });
+
+// Consumers that wait on a register and are woken by its write
+struct Waiters
+{
+    std::vector<boost::intrusive_ptr<nuArch::Instruction>> theConsumers;
+    uint64_t theWoken = 0;
+
+    explicit Waiters(int64_t aCount)
+    {
+        for (int64_t i = 0; i < aCount; ++i) {
+            theConsumers.emplace_back(
+              new nDecoder::SemanticInstruction(VirtualMemoryAddress(0x400000 + 4 * i), 0, nullptr, 0, i));
+        }
+    }
+
+    InstructionDependance dependance(size_t anIndex)
+    {
+        InstructionDependance dep;
+        dep.instruction = theConsumers[anIndex];
+        dep.theTarget   = &theWoken;
+        dep.theArg      = 0;
+        dep.theSatisfy  = [](void* aTarget, int32_t) { ++*static_cast<uint64_t*>(aTarget); };
+        dep.theSquash   = [](void*, int32_t) {};
+        return dep;
+    }
+};
+
+// A physical register mapped by a producer, requested by its consumers,
+// then written, which wakes them, and unmapped once the producer retires.
+// Arguments: consumers per register
+static void
+BM_RegisterWakeup(benchmark::State& state)
+{
+    const uint32_t registers = 256;
+    RegisterFile file;
+    file.initialize(std::vector<uint32_t>{ registers, registers, registers });
+    nuArch::uArch core;
+    Waiters waiters(state.range(0));
+
+    uint32_t next = 0;
+    for (auto _ : state) {
+        mapped_reg reg;
+        reg.theType  = nuArch::xRegisters;
+        reg.theIndex = next++ % registers;
+        file.map(reg);
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            benchmark::DoNotOptimize(file.request(reg, waiters.dependance(i)));
+        }
+        file.write(reg, uint64_t(next), core, false);
+        file.unmap(reg);
+    }
+    benchmark::DoNotOptimize(waiters.theWoken);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RegisterWakeup)->ArgNames({ "consumers" })->Arg(1)->Arg(4);
+
+// The same through the bypass network: consumers connect to a register and
+// take the value as it is written.
+// Arguments: consumers per register
+static void
+BM_BypassWakeup(benchmark::State& state)
+{
+    const uint32_t registers = 256;
+    BypassNetwork bypass(registers, registers, registers);
+    nuArch::uArch core;
+    Waiters waiters(state.range(0));
+
+    uint32_t next = 0;
+    for (auto _ : state) {
+        mapped_reg reg;
+        reg.theType  = nuArch::xRegisters;
+        reg.theIndex = next++ % registers;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            bypass.connect(reg, waiters.theConsumers[i], [&waiters](nuArch::register_value) {
+                ++waiters.theWoken;
+                return true;
+            });
+        }
+        bypass.write(reg, uint64_t(next), core);
+        bypass.unmap(reg);
+    }
+    benchmark::DoNotOptimize(waiters.theWoken);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BypassWakeup)->ArgNames({ "consumers" })->Arg(1)->Arg(4);
+
+} // namespace nBench
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Compare two flexus-bench result files.
+
+Both files are Google Benchmark JSON output, e.g. from
+
+    flexus-bench --benchmark_out=base.json --benchmark_out_format=json
+
+Prints the CPU time per iteration of every benchmark present in both runs and
+the relative change, and exits with status 1 if any benchmark got slower by
+more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+
+    times = {}
+    for run in results["benchmarks"]:
+        # With --benchmark_repetitions only the aggregated median is compared
+        if run.get("run_type") == "aggregate" and run.get("aggregate_name") != "median":
+            continue
+        name = run.get("run_name", run["name"])
+        if run.get("run_type") == "aggregate" or name not in times:
+            times[name] = (run["cpu_time"], run["time_unit"])
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="results of the reference build")
+    parser.add_argument("contender", help="results of the build under test")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown in percent reported as a regression (default: 5)")
+    parser.add_argument("--filter", default="", help="only compare benchmarks whose name contains this string")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    names = [name for name in baseline if name in contender and args.filter in name]
+    if not names:
+        print("No common benchmarks to compare", file=sys.stderr)
+        return 1
+
+    width = max(len(name) for name in names)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>14}  {'Contender':>14}  {'Change':>8}")
+    regressions = 0
+    for name in names:
+        (base, unit), (new, new_unit) = baseline[name], contender[name]
+        if unit != new_unit:
+            print(f"{name:<{width}}  time units differ ({unit} vs {new_unit})")
+            continue
+        change = (new - base) / base * 100.0 if base else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}}  {base:>11.1f} {unit}  {new:>11.1f} {unit}  {change:>+7.1f}%{marker}")
+
+    for name in sorted(set(baseline) ^ set(contender)):
+        if args.filter in name:
+            print(f"{name}: only in {'baseline' if name in baseline else 'contender'}")
+
+    if regressions:
+        print(f"{regressions} benchmark(s) slower by more than {args.threshold}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -9,75 +9,154 @@ BTB::BTB(int32_t aBTBSets, int32_t aBTBAssoc)
 {
     // aBTBSize must be a power of 2
     DBG_Assert(((aBTBSets - 1) & (aBTBSets)) == 0);
-    theBTB.resize(aBTBSets, BTBSet(aBTBAssoc));
+    DBG_Assert(aBTBAssoc > 0 && (uint32_t)aBTBAssoc <= kMaxAssoc,
+               (<< "BTB associativity must be between 1 and " << kMaxAssoc << ", got " << aBTBAssoc));
+
+    theTags.assign(theBTBSets * theBTBAssoc, kInvalidTag);
+    theTargets.assign(theBTBSets * theBTBAssoc, 0);
+    theTypes.assign(theBTBSets * theBTBAssoc, kNonBranch);
+
+    // Way 0 is the least recently used
+    uint64_t order = 0;
+    for (uint32_t way = 0; way < theBTBAssoc; ++way) {
+        order |= uint64_t(way) << (4 * way);
+    }
+    theLRU.assign(theBTBSets, order);
 
     theIndexMask = aBTBSets - 1; // ! Shouldn't it be log2(aBTBSets) ?
+
+    switch (theBTBAssoc) {
+        case 1: theFind = &BTB::findFixed<1>; break;
+        case 2: theFind = &BTB::findFixed<2>; break;
+        case 4: theFind = &BTB::findFixed<4>; break;
+        case 8: theFind = &BTB::findFixed<8>; break;
+        case 16: theFind = &BTB::findFixed<16>; break;
+        default: theFind = &BTB::findAny; break;
+    }
+}
+
+// Branch-free compare of a whole set, which the compiler vectorizes for the
+// common associativities.
+template<uint32_t Ways>
+int32_t
+BTB::findFixed(uint32_t aSet, uint64_t aTag) const
+{
+    uint64_t const* tags = &theTags[aSet * Ways];
+    uint32_t hits        = 0;
+    for (uint32_t way = 0; way < Ways; ++way) {
+        hits |= uint32_t(tags[way] == aTag) << way;
+    }
+    return hits ? int32_t(aSet * Ways + __builtin_ctz(hits)) : -1;
+}
+
+int32_t
+BTB::findAny(uint32_t aSet, uint64_t aTag) const
+{
+    uint64_t const* tags = &theTags[aSet * theBTBAssoc];
+    for (uint32_t way = 0; way < theBTBAssoc; ++way) {
+        if (tags[way] == aTag) return aSet * theBTBAssoc + way;
+    }
+    return -1;
+}
+
+// Moves aWay to the most recently used end of the set's queue
+void
+BTB::touch(uint32_t aSet, uint32_t aWay)
+{
+    uint64_t order = theLRU[aSet];
+    uint32_t pos   = 0;
+    while (((order >> (4 * pos)) & 0xf) != aWay) {
+        ++pos;
+    }
+
+    uint64_t below = order & ((uint64_t(1) << (4 * pos)) - 1);
+    uint64_t above = (pos + 1 < 16) ? order >> (4 * (pos + 1)) : 0;
+    theLRU[aSet]   = below | (above << (4 * pos)) | (uint64_t(aWay) << (4 * (theBTBAssoc - 1)));
 }
 
-/* The PC is assumed to be word aligned so the index into the Set Associative structure is */
-/* INDEX_MASK anded with the PC >> 2 */
-uint32_t
-BTB::index(VirtualMemoryAddress anAddress)
+void
+BTB::insert(uint32_t aSet, VirtualMemoryAddress aPC, eBranchType aType, VirtualMemoryAddress aTarget)
 {
-    // Shift address by 2, since we assume word-aligned PCs
-    return (anAddress >> 2) & theIndexMask;
+    // TODO: Replacement is not needed if there is an invalid entry
+    uint32_t way        = theLRU[aSet] & 0xf;
+    uint32_t slot       = aSet * theBTBAssoc + way;
+    theTags[slot]       = aPC;
+    theTargets[slot]    = aTarget;
+    theTypes[slot]      = aType;
+    touch(aSet, way);
 }
 
 // Whether the BTB contains target for anAddress
 bool
-BTB::contains(VirtualMemoryAddress anAddress)
+BTB::contains(VirtualMemoryAddress anAddress) const
+{
+    return find(anAddress) >= 0;
+}
+
+uint64_t
+BTB::branches(VirtualMemoryAddress aBlock, uint32_t aCount) const
+{
+    DBG_Assert(aCount <= 64);
+
+    uint64_t hits = 0;
+    uint64_t pc   = aBlock;
+    uint32_t set  = index(aBlock);
+    for (uint32_t i = 0; i < aCount; ++i, pc += 4, set = (set + 1) & theIndexMask) {
+        hits |= uint64_t((this->*theFind)(set, pc) >= 0) << i;
+    }
+    return hits;
+}
+
+bool
+BTB::lookup(VirtualMemoryAddress anAddress, eBranchType& aType, VirtualMemoryAddress& aTarget)
 {
-    int32_t ind = index(anAddress);
-    return theBTB[ind].isHit(anAddress);
+    int32_t slot = find(anAddress);
+    if (slot < 0) return false;
+
+    touch(slot / theBTBAssoc, slot % theBTBAssoc);
+    aType   = eBranchType(theTypes[slot]);
+    aTarget = VirtualMemoryAddress(theTargets[slot]);
+    return true;
 }
 
 // The kind of branch corresponding to the address: conditional, direct, indirect, return, etc
 eBranchType
 BTB::type(VirtualMemoryAddress anAddress)
 {
-    int32_t ind = index(anAddress);
-    bool isHit  = theBTB[ind].isHit(anAddress);
-
-    if (!isHit) {
-        return kNonBranch;
-    } else {
-        return theBTB[ind].access(anAddress)->theBranchType;
-    }
+    eBranchType type;
+    VirtualMemoryAddress target;
+    return lookup(anAddress, type, target) ? type : kNonBranch;
 }
 
 // Target address of the branch
 boost::optional<VirtualMemoryAddress>
 BTB::target(VirtualMemoryAddress anAddress)
 {
-    int32_t ind = index(anAddress);
-    bool isHit  = theBTB[ind].isHit(anAddress);
-
-    if (!isHit) {
-        return boost::none;
-    } else {
-        return theBTB[ind].access(anAddress)->theTarget;
-    }
+    eBranchType type;
+    VirtualMemoryAddress target;
+    if (!lookup(anAddress, type, target)) return boost::none;
+    return target;
 }
 
 // Update or add a new entry to the BTB
 bool
 BTB::update(VirtualMemoryAddress aPC, eBranchType aType, VirtualMemoryAddress aTarget)
 {
-    int32_t ind = index(aPC);
-    bool isHit  = theBTB[ind].isHit(aPC);
+    uint32_t set = index(aPC);
+    int32_t slot = find(aPC);
 
-    if (isHit) {
+    if (slot >= 0) {
         if (aType == kNonBranch) {
-            theBTB[ind].invalidate(aPC); // [MADHUR] Mispredict
+            theTags[slot] = kInvalidTag; // [MADHUR] Mispredict
         } else {
-            BTBEntry* btbEntry = theBTB[ind].access(aPC); // [MADHUR] Access will also update the replacement queue
+            touch(set, slot % theBTBAssoc); // [MADHUR] Access will also update the replacement queue
 
-            btbEntry->theBranchType = aType;
+            theTypes[slot] = aType;
 
             if (aTarget) {
                 DBG_(Verb, (<< "BTB setting target for " << aPC << " to " << aTarget));
 
-                btbEntry->theTarget = aTarget;
+                theTargets[slot] = aTarget;
             }
         }
 
@@ -85,7 +164,7 @@ BTB::update(VirtualMemoryAddress aPC, eBranchType aType, VirtualMemoryAddress aT
     } else if (aType != kNonBranch) {
         DBG_(Verb, (<< "BTB adding new branch for " << aPC << " to " << aTarget));
 
-        theBTB[ind].insert(BTBEntry(aPC, aType, aTarget)); // [MADHUR] Inserting a new entry
+        insert(set, aPC, aType, aTarget); // [MADHUR] Inserting a new entry
 
         return true;
     }
@@ -108,13 +187,12 @@ BTB::saveState() const
 
         checkpoint.emplace_back(json::array());
 
-        auto block = theBTB[i].blocks.begin();
-        auto end   = theBTB[i].blocks.end();
+        for (size_t j = 0; j < theBTBAssoc; j++) {
+            size_t slot = i * theBTBAssoc + j;
+            if (theTags[slot] == kInvalidTag) continue;
 
-        size_t j = 0;
-        for (; block != end; block++, j++) {
             uint8_t type = 15;
-            switch (block->theBranchType) {
+            switch (theTypes[slot]) {
                 case kNonBranch: type = 0; break;
                 case kConditional: type = 1; break;
                 case kUnconditional: type = 2; break;
@@ -124,11 +202,7 @@ BTB::saveState() const
                 case kReturn: type = 6; break;
                 default: DBG_Assert(false, (<< "Don't know how to save branch type")); break;
             }
-            if (block->valid) {
-                checkpoint[i][j] = { { "PC", (uint64_t)block->thePC },
-                                     { "target", (uint64_t)block->theTarget },
-                                     { "type", (uint8_t)type } };
-            }
+            checkpoint[i][j] = { { "PC", theTags[slot] }, { "target", theTargets[slot] }, { "type", (uint8_t)type } };
         }
     }
 
@@ -147,7 +221,9 @@ BTB::loadState(json checkpoint)
 
         DBG_Assert(blockSize <= (size_t)theBTBAssoc);
 
-        theBTB[set].invalidateAll();
+        for (size_t way = 0; way < theBTBAssoc; way++) {
+            theTags[set * theBTBAssoc + way] = kInvalidTag;
+        }
         uint64_t ts = 0;
 
         for (size_t block = 0; block < blockSize; block++) {
@@ -176,7 +252,7 @@ BTB::loadState(json checkpoint)
                 default: DBG_Assert(false, (<< "Don't know how to load type: " << aType)); break;
             }
 
-            theBTB[set].insert(BTBEntry(VirtualMemoryAddress(aPC), type, VirtualMemoryAddress(aTarget)));
+            insert(set, VirtualMemoryAddress(aPC), type, VirtualMemoryAddress(aTarget));
         }
     }
 };
@@ -1,22 +1,53 @@
 #ifndef FLEXUS_BTB
 #define FLEXUS_BTB
 
-#include "BTBSet.hpp"
 #include "components/uFetch/uFetchTypes.hpp"
 #include "core/checkpoint/json.hpp"
 #include "core/types.hpp"
 
+#include <cstdint>
 #include <vector>
 
 using json = nlohmann::json;
 using namespace Flexus::SharedTypes;
 
+/*
+ * Set associative BTB laid out as flat arrays: the tags of a set are
+ * contiguous, and consecutive (word aligned) PCs map to consecutive sets, so a
+ * fetch block is looked up with one sequential sweep over the tag array.
+ * Targets and branch types live in their own arrays and are only touched on a
+ * hit.
+ *
+ * Replacement is LRU. The order of each set is packed into one 64-bit word of
+ * 4-bit way numbers, least recently used in the lowest nibble, which bounds
+ * the associativity to 16.
+ */
 class BTB
 {
+  public:
+    static constexpr uint32_t kMaxAssoc = 16;
+
   private:
-    std::vector<BTBSet> theBTB; // Array of Sets make up a cache
+    // Invalid ways hold a tag no word aligned PC can match
+    static constexpr uint64_t kInvalidTag = ~uint64_t(0);
+
+    std::vector<uint64_t> theTags;   // [set * assoc + way]
+    std::vector<uint64_t> theTargets;
+    std::vector<uint8_t> theTypes;
+    std::vector<uint64_t> theLRU;    // [set]
     uint64_t theIndexMask;
 
+    // Way lookup specialised on the associativity when the BTB is built
+    int32_t (BTB::*theFind)(uint32_t aSet, uint64_t aTag) const;
+
+    template<uint32_t Ways>
+    int32_t findFixed(uint32_t aSet, uint64_t aTag) const;
+    int32_t findAny(uint32_t aSet, uint64_t aTag) const;
+
+    int32_t find(VirtualMemoryAddress anAddress) const { return (this->*theFind)(index(anAddress), anAddress); }
+    void touch(uint32_t aSet, uint32_t aWay);
+    void insert(uint32_t aSet, VirtualMemoryAddress aPC, eBranchType aType, VirtualMemoryAddress aTarget);
+
   public:
     uint32_t theBTBSets;
     uint32_t theBTBAssoc;
@@ -28,9 +59,13 @@ class BTB
     BTB(int32_t aBTBSets, int32_t aBTBAssoc);
     /* The PC is assumed to be word aligned so the index into the Set Associative structure is */
     /* INDEX_MASK anded with the PC >> 2 */
-    uint32_t index(VirtualMemoryAddress anAddress);
+    uint32_t index(VirtualMemoryAddress anAddress) const { return (anAddress >> 2) & theIndexMask; }
     // Whether the BTB contains target for anAddress
-    bool contains(VirtualMemoryAddress anAddress);
+    bool contains(VirtualMemoryAddress anAddress) const;
+    // Bit i is set if the instruction at aBlock + 4 * i hits in the BTB (aCount <= 64)
+    uint64_t branches(VirtualMemoryAddress aBlock, uint32_t aCount) const;
+    // Type and target of the branch at anAddress, false on a miss
+    bool lookup(VirtualMemoryAddress anAddress, eBranchType& aType, VirtualMemoryAddress& aTarget);
     // The kind of branch corresponding to the address: conditional, direct, indirect, return, etc
     eBranchType type(VirtualMemoryAddress anAddress);
     // Target address of the branch
@@ -43,4 +78,4 @@ class BTB
     void loadState(json checkpoint);
 };
 
-#endif
\ No newline at end of file
+#endif
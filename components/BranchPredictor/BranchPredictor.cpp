@@ -13,11 +13,16 @@ using json = nlohmann::json;
 // #define DBG_SetDefaultOps    AddCat(BPred)
 // #include DBG_Control()
 
-BranchPredictor::BranchPredictor(std::string const& aName, uint32_t anIndex, uint32_t aBTBSets, uint32_t aBTBWays)
+BranchPredictor::BranchPredictor(std::string const& aName,
+                                 uint32_t anIndex,
+                                 uint32_t aBTBSets,
+                                 uint32_t aBTBWays,
+                                 TageGeometry const& aTageGeometry)
   : theName(aName)
   , theIndex(anIndex)
   , theSerial(0)
   , theBTB(aBTBSets, aBTBWays)
+  , theTage(TagePredictor::create(aTageGeometry))
   , theBranches(aName + "-branches")
 
   , theBranchMispredictionPenalty(aName + "-mispredict:penalty")
@@ -41,17 +46,19 @@ BranchPredictor::BranchPredictor(std::string const& aName, uint32_t anIndex, uin
  * If the prediction is taken, we jump to the target address (if present) as given by the BTB
  */
 VirtualMemoryAddress
-BranchPredictor::predictConditional(VirtualMemoryAddress anAddress, BPredState& aBPState)
+BranchPredictor::predictConditional(VirtualMemoryAddress anAddress,
+                                    VirtualMemoryAddress aTarget,
+                                    BPredState& aBPState)
 {
     ++thePredictions_TAGE;
 
-    bool isTaken = theTage.get_prediction((uint64_t)anAddress, aBPState);
+    bool isTaken = theTage->get_prediction((uint64_t)anAddress, aBPState);
 
     aBPState.thePrediction = isTaken ? kTaken : kNotTaken;
 
-    if (aBPState.thePrediction <= kTaken && theBTB.target(anAddress)) { 
+    if (aBPState.thePrediction <= kTaken) {
         ++thePredictions_BTB;
-        return *theBTB.target(anAddress); 
+        return aTarget;
     }
 
     return VirtualMemoryAddress(0);
@@ -60,7 +67,7 @@ BranchPredictor::predictConditional(VirtualMemoryAddress anAddress, BPredState&
 void
 BranchPredictor::recoverHistory(const BPredRedictRequest& aRequest)
 {
-    theTage.restore_history(*aRequest.theBPState);
+    theTage->restore_history(*aRequest.theBPState);
 
     if (!aRequest.theInsertNewHistory) {
         return;
@@ -74,14 +81,14 @@ BranchPredictor::recoverHistory(const BPredRedictRequest& aRequest)
 
     if (aBPState.theActualType == kConditional) {
         if (aBPState.theActualDirection == kTaken) {
-            theTage.update_history(aBPState, true, aBPState.pc);
+            theTage->update_history(aBPState, true, aBPState.pc);
         } else if (aBPState.theActualDirection == kNotTaken) {
-            theTage.update_history(aBPState, false, aBPState.pc);
+            theTage->update_history(aBPState, false, aBPState.pc);
         } else {
             DBG_Assert(false, (<< "Should never enter here"));
         }
     } else {
-        theTage.update_history(aBPState, true, aBPState.pc);
+        theTage->update_history(aBPState, true, aBPState.pc);
     }
 }
 
@@ -91,18 +98,28 @@ BranchPredictor::isBranch(VirtualMemoryAddress anAddress)
     return theBTB.contains(anAddress);
 }
 
+uint64_t
+BranchPredictor::branchesInBlock(VirtualMemoryAddress aBlock, uint32_t aCount) const
+{
+    return theBTB.branches(aBlock, aCount);
+}
+
 void
 BranchPredictor::checkpointHistory(BPredState& aBPState) const
 {
-    theTage.checkpointHistory(aBPState);
+    theTage->checkpointHistory(aBPState);
 }
 
 VirtualMemoryAddress
 BranchPredictor::predict(VirtualMemoryAddress anAddress, BPredState& aBPState)
 {
     // Implementation of predict function
+    VirtualMemoryAddress target(0);
+    eBranchType type = kNonBranch;
+    theBTB.lookup(anAddress, type, target);
+
     aBPState.pc                  = anAddress;
-    aBPState.thePredictedType    = theBTB.type(anAddress);
+    aBPState.thePredictedType    = type;
     aBPState.theSerial           = theSerial++;
     aBPState.thePredictedTarget  = VirtualMemoryAddress(0);
     aBPState.thePrediction       = kStronglyTaken;
@@ -114,7 +131,7 @@ BranchPredictor::predict(VirtualMemoryAddress anAddress, BPredState& aBPState)
             aBPState.thePredictedTarget = VirtualMemoryAddress(0);
             break;
         case kConditional:
-            aBPState.thePredictedTarget = predictConditional(VirtualMemoryAddress(anAddress), aBPState);
+            aBPState.thePredictedTarget = predictConditional(VirtualMemoryAddress(anAddress), target, aBPState);
             break;
         // TODO: These cases can be merged because they all have the same effect. However, when logging, they all
         // increment different stats. So they must be done in their individual cases and increment the corresponding
@@ -124,13 +141,9 @@ BranchPredictor::predict(VirtualMemoryAddress anAddress, BPredState& aBPState)
         case kUnconditional:
         case kCall:
         case kReturn:
-            if (theBTB.target(anAddress)) {
-                aBPState.thePredictedTarget = *theBTB.target(anAddress);
-            } else {
-                aBPState.thePredictedTarget = VirtualMemoryAddress(0);
-            }
-            // theTage.get_prediction((uint64_t)anAddress, aBPState);
-            theTage.update_history(aBPState, true, aBPState.pc);
+            aBPState.thePredictedTarget = target;
+            // theTage->get_prediction((uint64_t)anAddress, aBPState);
+            theTage->update_history(aBPState, true, aBPState.pc);
             break;
         default: aBPState.thePredictedTarget = VirtualMemoryAddress(0); break;
     }
@@ -231,8 +244,36 @@ BranchPredictor::train(const BPredState& aBPState)
 
     if (aBPState.thePredictedType == kConditional && aBPState.thePredictedType == kConditional) {
         bool taken = (aBPState.theActualDirection <= kTaken);
-        theTage.update_predictor(aBPState.pc, aBPState, taken);
+        theTage->update_predictor(aBPState.pc, aBPState, taken);
+    }
+}
+
+void
+BranchPredictor::warm(VirtualMemoryAddress anAddress, eBranchType aType, VirtualMemoryAddress aTarget)
+{
+    BPredState state;
+    VirtualMemoryAddress target(0);
+    theBTB.lookup(anAddress, state.thePredictedType, target);
+    if (aType == kNonBranch && state.thePredictedType == kNonBranch) return;
+
+    state.pc = anAddress;
+    theTage->checkpointHistory(state);
+    bool predicted = true;
+    if (state.thePredictedType == kConditional) {
+        predicted = theTage->get_prediction((uint64_t)anAddress, state);
+    } else if (state.thePredictedType != kNonBranch) {
+        theTage->update_history(state, true, state.pc);
     }
+
+    // A wrong type or direction is redirected with the actual outcome
+    bool taken = (aType != kConditional || (uint64_t)aTarget != (uint64_t)anAddress + 4);
+    if (aType != state.thePredictedType || (aType == kConditional && predicted != taken)) {
+        theTage->restore_history(state);
+        if (aType != kNonBranch) theTage->update_history(state, taken, state.pc);
+    }
+
+    theBTB.update(anAddress, aType, aTarget);
+    if (state.thePredictedType == kConditional) theTage->update_predictor(state.pc, state, taken);
 }
 
 void
@@ -246,7 +287,7 @@ BranchPredictor::loadState(std::string const& aDirName)
     ifs >> checkpoint;
 
     theBTB.loadState(checkpoint["btb"]);
-    theTage.loadState(checkpoint["tage"]);
+    theTage->loadState(checkpoint["tage"]);
     ifs.close();
 }
 
@@ -260,7 +301,7 @@ BranchPredictor::saveState(std::string const& aDirName)
     json checkpoint;
 
     checkpoint["btb"]  = theBTB.saveState();
-    checkpoint["tage"] = theTage.saveState();
+    checkpoint["tage"] = theTage->saveState();
 
     ofs << std::setw(4) << checkpoint << std::endl;
     ofs.close();
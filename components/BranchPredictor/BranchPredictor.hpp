@@ -7,6 +7,7 @@
 #include "core/types.hpp"
 
 #include <components/uFetch/uFetchTypes.hpp>
+#include <memory>
 
 namespace Stat = Flexus::Stat;
 
@@ -17,7 +18,7 @@ class BranchPredictor
     uint32_t theIndex;
     uint32_t theSerial;
     BTB theBTB;
-    PREDICTOR theTage;
+    std::unique_ptr<TagePredictor> theTage;
 
   public:
     Stat::StatCounter theBranches;
@@ -42,11 +43,19 @@ class BranchPredictor
      * If the prediction is NotTaken, there is no need to read the BTB as we will anyway jump to the next instruction
      * If the prediction is taken, we jump to the target address (if present) as given by the BTB
      */
-    VirtualMemoryAddress predictConditional(VirtualMemoryAddress anAddress, BPredState& aBPState);
+    VirtualMemoryAddress predictConditional(VirtualMemoryAddress anAddress,
+                                            VirtualMemoryAddress aTarget,
+                                            BPredState& aBPState);
 
   public:
-    BranchPredictor(std::string const& aName, uint32_t anIndex, uint32_t aBTBSets, uint32_t aBTBWays);
+    BranchPredictor(std::string const& aName,
+                    uint32_t anIndex,
+                    uint32_t aBTBSets,
+                    uint32_t aBTBWays,
+                    TageGeometry const& aTageGeometry = TageGeometry());
     bool isBranch(VirtualMemoryAddress anAddress);
+    // Bit i is set if the BTB holds a branch at aBlock + 4 * i (aCount <= 64)
+    uint64_t branchesInBlock(VirtualMemoryAddress aBlock, uint32_t aCount) const;
 
     void checkpointHistory(BPredState& aBPState) const;
 
@@ -58,6 +67,11 @@ class BranchPredictor
     // This function is called whenever an instruction triggering a prediction retires.
     void train(const BPredState& aBPState);
 
+    // Functional warming: the state predict(), recoverHistory() and train()
+    // leave for a branch of aType at anAddress that went to aTarget, without
+    // touching the statistics
+    void warm(VirtualMemoryAddress anAddress, eBranchType aType, VirtualMemoryAddress aTarget);
+
     void loadState(std::string const& aDirName);
     void saveState(std::string const& aDirName);
 };
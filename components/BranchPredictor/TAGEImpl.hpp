@@ -9,13 +9,13 @@ OGEHL predictor simulator from Andr� Seznec
 #define PREDICTOR_H_SEEN
 
 #include "core/debug/debug.hpp"
-#include <bitset>
 #include <cmath>
 #include <components/uFetch/uFetchTypes.hpp>
 #include <core/checkpoint/json.hpp>
 #include <core/types.hpp>
 #include <cstdlib>
 #include <inttypes.h>
+#include <vector>
 using json = nlohmann::json;
 
 #define TAGE
@@ -32,41 +32,13 @@ using json = nlohmann::json;
 // the bimodal table: hysteresis is shared among 4 counters: total size 5*2**(LOGB-2)
 // Remark a contrario from JILP paper, T0 is the table with the longest history, Sorry !
 
-// 32KB
-// #define BIG
-#ifdef BIG
-#define LOGB  14         // bimodal size
-#define NHIST 12         // number of tables
-#define TBITS 15         // tag bits
-#define LOGG  (LOGB - 4) // geo-table size
-// #define LOGG 15//geo-table size
-#define MAXHIST 640
-#define MINHIST 4
-#endif
-
-// #define FIVECOMPONENT
-#ifdef FIVECOMPONENT
-// a 64 Kbits predictor with 4 tagged tables
-#define LOGB  13
-#define NHIST 4
-#define TBITS 9
-#define LOGG  (LOGB - 3)
-#endif
-
-// #define FOURTEENCOMPONENT
-#ifdef FOURTEENCOMPONENT
-// a 64,5 Kbits predictor with 13 tagged tables
-#define LOGB  13
-#define NHIST 13
-#define TBITS 15
-#define LOGG  (LOGB - 5)
-#endif
-
-// bits per counter in the global history tables
-#ifndef CBITS
-#define CBITS 3
-#endif
+typedef uint64_t address_t;
 
+namespace Flexus {
+namespace SharedTypes {
+
+// The predictor geometry, set from the FetchAddressGenerate configuration.
+//
 // the default predictor
 // by default a 63.5  Kbits predictor, featuring 7 tagged components and a base bimodal component:
 // NHIST = 7, LOGB =13, LOGG=9, CBITS=3
@@ -75,72 +47,50 @@ using json = nlohmann::json;
 // 8 Kbits  for T1 and T2
 // 7.5 Kbits for T3 and T4
 // 7 Kbits for T5 and T6
+//
+// Other known configurations:
+// 32KB:                 LOGB=14 NHIST=12 TBITS=15 LOGG=10 MAXHIST=640 MINHIST=4
+// 64 Kbits, 4 tables:   LOGB=13 NHIST=4  TBITS=9  LOGG=10
+// 64,5 Kbits, 13 tables: LOGB=13 NHIST=13 TBITS=15 LOGG=8
+struct TageGeometry
+{
+    int LOGB    = 13;  // bimodal size
+    int NHIST   = 7;   // number of tables
+    int LOGG    = 9;   // base 2 logarithm of number of entries on each tagged component
+    int TBITS   = 12;  // Total width of an entry in the tagged table with the longest history length
+    int CBITS   = 3;   // bits per counter in the global history tables
+    int MAXHIST = 131; // AS: maximum global history length used (plus one) and minimum history length
+    int MINHIST = 5;
+};
 
-#ifndef LOGB
-#define LOGB 13
-#endif
-
-#ifndef NHIST
-#define NHIST 7
-#endif
-// base 2 logarithm of number of entries  on each tagged component
-#ifndef LOGG
-#define LOGG (LOGB - 4)
-#endif
-
-// Total width of an entry in the tagged table with the longest history length
-#ifndef TBITS
-#define TBITS 12
-#endif
-
-// AS: we use Geometric history length
-// AS: maximum global history length used and minimum history length
-#ifndef MAXHIST
-#define MAXHIST 131
-#define MINHIST 5
-#endif
-
-typedef uint64_t address_t;
-typedef std::bitset<MAXHIST> history_t;
+// History bits kept for recovery. A BPredState can restore the history it
+// checkpointed as long as fewer than kTageHistoryBuffer - MAXHIST branches were
+// predicted after it.
+static const int kTageHistoryBuffer = 1 << 12;
 
-namespace Flexus {
-namespace SharedTypes {
-
-// this is the cyclic shift register for folding
-// a long global history into a smaller number of bits
-// #define INITRAND
-class folded_history
+class TagePredictor
 {
   public:
-    unsigned comp;
-    int CLENGTH;
-    int OLENGTH;
-    int OUTPOINT;
-
-    folded_history() {}
-
-    void init(int original_length, int compressed_length)
-    {
-        comp     = 0;
-        OLENGTH  = original_length;
-        CLENGTH  = compressed_length;
-        OUTPOINT = OLENGTH % CLENGTH;
-        ASSERT(OLENGTH < MAXHIST);
-    }
-
-    void update(history_t h)
-    {
-        ASSERT((comp >> CLENGTH) == 0);
-        comp = (comp << 1) | h[0];
-        comp ^= h[OLENGTH] << OUTPOINT;
-        comp ^= (comp >> CLENGTH);
-        comp &= (1 << CLENGTH) - 1;
-    }
+    virtual ~TagePredictor() {}
+
+    // Picks the kernel specialized for the geometry's number of tables, if any
+    static TagePredictor* create(TageGeometry const& aGeometry);
+
+    virtual void checkpointHistory(BPredState& aBPState) const                                     = 0;
+    virtual void update_history(const BPredState& aBPState, bool taken, uint64_t instruction_addr) = 0;
+    virtual bool get_prediction(uint64_t instruction_addr, BPredState& aBPState)                   = 0;
+    virtual void restore_history(const BPredState& aBPState)                                       = 0;
+    virtual void update_predictor(uint64_t instruction_addr, const BPredState& aBPState, bool taken) = 0;
+    virtual json saveState() const                                                                 = 0;
+    virtual void loadState(json checkpoint)                                                        = 0;
 };
 
 // all the predictor is there
-
-class PREDICTOR
+//
+// Tables is the number of tagged tables, fixed at compile time so the
+// per-table loops unroll, or 0 to take it from the geometry.
+template<int Tables>
+class TageImpl : public TagePredictor
 {
   public:
     // bimodal table entry
@@ -156,12 +106,6 @@ class PREDICTOR
             pred = 0;
             //    hyst = 0;
             hyst = 1;
-
-#ifdef INITRAND
-
-            pred = random() & 1;
-            hyst = random() & 1;
-#endif
         }
     };
 
@@ -179,82 +123,125 @@ class PREDICTOR
             ctr  = 0;
             tag  = 0;
             ubit = 0;
-
-#ifdef INITRAND
-            ctr  = (random() & ((1 << CBITS) - 1)) - (1 << (CBITS - 1));
-            tag  = 0;
-            ubit = (random() & 3);
-
-#endif
         }
     };
 
+  private:
+    int LOGB, theTables, LOGG, TBITS, CBITS, MAXHIST, MINHIST;
+
+    int NHIST() const { return Tables > 0 ? Tables : theTables; }
+
     // predictor storage data
     // 4 bits to determine whether newly allocated entries should be considered as
     // valid or not for delivering  the prediction
     int TICK;
     int phist;
     // use a path history as for the OGEHL predictor
-    history_t ghist;
-    history_t ghist_retired;
-    folded_history ch_i[NHIST];
-    folded_history ch_t[2][NHIST];
-    bentry* btable;
-    gentry* gtable[NHIST];
+
+    // Global history as a ring: bit i of the history is theHistory[(theHead - i) % size], so
+    // checkpoints only remember theHead
+    std::vector<uint8_t> theHistory;
+    uint64_t theHead;
+
+    // Folded histories of every table, as cyclic shift registers folding
+    // the long global history into a smaller number of bits: ch_i feeds the
+    // index, ch_t[0] and ch_t[1] the tag
+    uint32_t ch_i[kTageMaxTables];
+    uint32_t ch_t[2][kTageMaxTables];
+    int theFoldLength[3][kTageMaxTables];
+    int theFoldOutpoint[3][kTageMaxTables];
+
     // used for storing the history lengths
-    int m[NHIST];
+    int m[kTageMaxTables];
+    int theIndexShift[kTageMaxTables];
+    int thePathLength[kTageMaxTables];
+    uint32_t theTagMask[kTageMaxTables];
+
+    std::vector<bentry> btable;
+    std::vector<gentry> gtable; // NHIST tables of 2**LOGG entries, back to back
     int Seed;
-    PREDICTOR()
+
+  public:
+    TageImpl(TageGeometry const& aGeometry)
+      : LOGB(aGeometry.LOGB)
+      , theTables(aGeometry.NHIST)
+      , LOGG(aGeometry.LOGG)
+      , TBITS(aGeometry.TBITS)
+      , CBITS(aGeometry.CBITS)
+      , MAXHIST(aGeometry.MAXHIST)
+      , MINHIST(aGeometry.MINHIST)
     {
+        DBG_Assert(Tables == 0 || Tables == theTables);
+        DBG_Assert(NHIST() >= 2 && NHIST() <= kTageMaxTables,
+                   (<< "TAGE supports 2 to " << kTageMaxTables << " tagged tables, not " << NHIST()));
+        DBG_Assert(LOGG >= NHIST() && LOGG <= 16, (<< "TAGE tagged tables need NHIST <= LOGG <= 16"));
+        DBG_Assert(TBITS - (NHIST() - 1 + (NHIST() & 1)) / 2 - 1 >= 1 && TBITS <= 16,
+                   (<< "TAGE tags must be 2 to 16 bits wide"));
+        DBG_Assert(CBITS >= 2 && CBITS <= 7);
+        DBG_Assert(MINHIST >= 1 && MINHIST < MAXHIST && MAXHIST <= kTageHistoryBuffer / 2,
+                   (<< "TAGE history lengths must satisfy 1 <= MINHIST < MAXHIST <= " << kTageHistoryBuffer / 2));
+
         int STORAGESIZE = 0;
 
         Seed = 0;
         TICK = 0;
 
-        phist          = 0;
+        phist = 0;
 
-        ghist          = 0;
-        ghist_retired  = 0;
+        theHistory.assign(kTageHistoryBuffer, 0);
+        theHead = 0;
         // computes the geometric history lengths
-        m[0]         = MAXHIST - 1;
-        m[NHIST - 1] = MINHIST;
-        for (int i = 1; i < NHIST - 1; i++) {
-            m[NHIST - 1 - i] = (int)(((double)MINHIST * pow((double)(MAXHIST - 1) / (double)MINHIST,
-                                                            (double)(i) / (double)((NHIST - 1)))) +
-                                     0.5);
+        m[0]           = MAXHIST - 1;
+        m[NHIST() - 1] = MINHIST;
+        for (int i = 1; i < NHIST() - 1; i++) {
+            m[NHIST() - 1 - i] = (int)(((double)MINHIST * pow((double)(MAXHIST - 1) / (double)MINHIST,
+                                                              (double)(i) / (double)((NHIST() - 1)))) +
+                                       0.5);
         }
 
         fprintf(stderr, "History Series:");
         STORAGESIZE = 0;
 
-        for (int i = NHIST - 1; i >= 0; i--) {
+        for (int i = NHIST() - 1; i >= 0; i--) {
 
             fprintf(stderr, "%d ", m[i]);
 
-            ch_i[i].init(m[i], LOGG);
-            STORAGESIZE += (1 << LOGG) * (5 + TBITS - ((i + (NHIST & 1)) / 2));
+            STORAGESIZE += (1 << LOGG) * (5 + TBITS - ((i + (NHIST() & 1)) / 2));
         }
         fprintf(stderr, "\n");
         STORAGESIZE += (1 << LOGB) + /*(1 << (LOGB - 2))*/ (1 << LOGB);
         fprintf(stderr,
                 "NHIST= %d; MINHIST= %d; MAXHIST= %d; STORAGESIZE= %d bits\n",
-                NHIST,
+                NHIST(),
                 MINHIST,
                 MAXHIST - 1,
                 STORAGESIZE);
 
-        for (int i = 0; i < NHIST; i++) {
-            ch_t[0][i].init(ch_i[i].OLENGTH, TBITS - ((i + (NHIST & 1)) / 2));
-            ch_t[1][i].init(ch_i[i].OLENGTH, TBITS - ((i + (NHIST & 1)) / 2) - 1);
-        }
+        for (int i = 0; i < NHIST(); i++) {
+            int tag_bits        = TBITS - ((i + (NHIST() & 1)) / 2);
+            theFoldLength[0][i] = LOGG;
+            theFoldLength[1][i] = tag_bits;
+            theFoldLength[2][i] = tag_bits - 1;
+            for (int f = 0; f < 3; f++) {
+                theFoldOutpoint[f][i] = m[i] % theFoldLength[f][i];
+            }
+            ch_i[i] = ch_t[0][i] = ch_t[1][i] = 0;
 
-        btable = new bentry[1 << LOGB];
-        for (int i = 0; i < NHIST; i++) {
-            gtable[i] = new gentry[1 << (LOGG)];
+            theIndexShift[i] = LOGG - NHIST() + i + 1;
+            thePathLength[i] = m[i] >= 16 ? 16 : m[i];
+            theTagMask[i]    = (1 << tag_bits) - 1;
         }
+
+        btable.resize(1 << LOGB);
+        gtable.resize(NHIST() << LOGG);
     }
 
-    ~PREDICTOR() {}
+    ~TageImpl() {}
+
+  private:
+    gentry& gt(int bank, int index) { return gtable[(bank << LOGG) + index]; }
+
+    bool history(int i) const { return theHistory[(theHead - i) & (kTageHistoryBuffer - 1)]; }
 
     // index function for the bimodal table
 
@@ -263,7 +250,7 @@ class PREDICTOR
     // index function for the global tables:
     // includes path history as in the OGEHL predictor
     // F serves to mix path history
-    int F(int A, int size, int bank)
+    int F(int A, int size, int bank) const
     {
         int A1, A2;
 
@@ -275,26 +262,15 @@ class PREDICTOR
         A  = ((A << bank) & ((1 << LOGG) - 1)) + (A >> (LOGG - bank));
         return (A);
     }
-    int gindex(address_t pc, int bank)
-    {
-        int index;
-
-        if (m[bank] >= 16)
-            index = pc ^ (pc >> ((LOGG - (NHIST - bank - 1)))) ^ ch_i[bank].comp ^ F(phist, 16, bank);
-
-        else
-            index = pc ^ (pc >> (LOGG - NHIST + bank + 1)) ^ ch_i[bank].comp ^ F(phist, m[bank], bank);
-
-        return (index & ((1 << (LOGG)) - 1));
-    }
 
-    //  tag computation
-    uint16_t gtag(address_t pc, int bank)
+    // Computes the index and tag (which does not use the same length for all
+    // the components) of every table in one pass
+    void gindex_gtag(address_t pc, uint16_t* GI, uint16_t* tags) const
     {
-
-        int tag = pc ^ ch_t[0][bank].comp ^ (ch_t[1][bank].comp << 1);
-        return (tag & ((1 << (TBITS - ((bank + (NHIST & 1)) / 2))) - 1));
-        // does not use the same length for all the components
+        for (int i = 0; i < NHIST(); i++) {
+            GI[i] = (pc ^ (pc >> theIndexShift[i]) ^ ch_i[i] ^ F(phist, thePathLength[i], i)) & ((1 << LOGG) - 1);
+            tags[i] = (pc ^ ch_t[0][i] ^ (ch_t[1][i] << 1)) & theTagMask[i];
+        }
     }
 
     // up-down saturating counter
@@ -307,67 +283,70 @@ class PREDICTOR
         }
     }
 
+    static uint32_t fold(uint32_t comp, uint32_t in, uint32_t out, int outpoint, int length)
+    {
+        comp = (comp << 1) | in;
+        comp ^= out << outpoint;
+        comp ^= (comp >> length);
+        return comp & ((1 << length) - 1);
+    }
+
     // prediction given by longest matching global history
     // altpred contains the alternate prediction
-    void read_prediction(address_t pc, BPredState& aBPState)
+    void read_prediction(address_t pc, BPredState& aBPState, uint16_t const* tags)
     {
-        aBPState.bank = NHIST;
-        aBPState.altbank = NHIST;
+        aBPState.bank    = NHIST();
+        aBPState.altbank = NHIST();
 
         {
-            for (int i = 0; i < NHIST; i++) {
-                if (gtable[i][aBPState.GI[i]].tag == gtag(pc, i)) {
+            for (int i = 0; i < NHIST(); i++) {
+                if (gt(i, aBPState.GI[i]).tag == tags[i]) {
                     aBPState.bank = i;
                     break;
                 }
             }
-            for (int i = aBPState.bank + 1; i < NHIST; i++) {
-                if (gtable[i][aBPState.GI[i]].tag == gtag(pc, i)) {
+            for (int i = aBPState.bank + 1; i < NHIST(); i++) {
+                if (gt(i, aBPState.GI[i]).tag == tags[i]) {
                     aBPState.altbank = i;
                     break;
                 }
             }
-            if (aBPState.bank < NHIST) {
-                if (aBPState.altbank < NHIST)
-                    aBPState.alt_pred = (gtable[aBPState.altbank][aBPState.GI[aBPState.altbank]].ctr >= 0);
+            if (aBPState.bank < NHIST()) {
+                if (aBPState.altbank < NHIST())
+                    aBPState.alt_pred = (gt(aBPState.altbank, aBPState.GI[aBPState.altbank]).ctr >= 0);
                 else
                     aBPState.alt_pred = getbim(pc, aBPState.BI);
                 // if the entry is recognized as a newly allocated entry and
                 // counter PWIN is negative use the alternate prediction
                 // see section 3.2.4
-                //	  if ((PWIN < 0) || (abs (2 * gtable[bank][GI[bank]].ctr + 1) != 1)
-                //	      || (gtable[bank][GI[bank]].ubit != 0))
-                //
-                //	    return (gtable[bank][GI[bank]].ctr >= 0);
-                //	  else
-                //	    return (altpred);
-                //	  DBG_(Tmp, ( << "Tage history prediciton"));
                 aBPState.bimodalPrediction = false;
-                aBPState.saturationCounter = gtable[aBPState.bank][aBPState.GI[aBPState.bank]].ctr + 4 /*To make the value positive (0 and 7) */;
-                aBPState.pred_taken = (gtable[aBPState.bank][aBPState.GI[aBPState.bank]].ctr >= 0);
+                aBPState.saturationCounter = gt(aBPState.bank, aBPState.GI[aBPState.bank]).ctr +
+                                             (1 << (CBITS - 1)) /*To make the value positive */;
+                aBPState.pred_taken = (gt(aBPState.bank, aBPState.GI[aBPState.bank]).ctr >= 0);
 
             } else {
                 aBPState.alt_pred = getbim(pc, aBPState.BI);
 
                 aBPState.bimodalPrediction = true;
                 aBPState.saturationCounter = getSatCounter(aBPState.BI);
-                aBPState.pred_taken = aBPState.alt_pred;
+                aBPState.pred_taken        = aBPState.alt_pred;
             }
         }
     }
 
+  public:
     void checkpointHistory(BPredState& aBPState) const
     {
         // This checkpoint only saves the global history and path history
         DBG_Assert(aBPState.theTageHistoryValid == false);
-        aBPState.phist = phist;
-        aBPState.ghist = std::bitset<MAXHIST>(ghist.to_string());
+        aBPState.phist      = phist;
+        aBPState.ghist_head = theHead;
 
         // Checkpoint ch_i and ch_t. They are the function of the global history.
-        for (int i = 0; i < NHIST; i++) {
-            aBPState.ch_i[i] = ch_i[i].comp;
-            aBPState.ch_t[0][i] = ch_t[0][i].comp;
-            aBPState.ch_t[1][i] = ch_t[1][i].comp;
+        for (int i = 0; i < NHIST(); i++) {
+            aBPState.ch_i[i]    = ch_i[i];
+            aBPState.ch_t[0][i] = ch_t[0][i];
+            aBPState.ch_t[1][i] = ch_t[1][i];
         }
 
         aBPState.theTageHistoryValid = true;
@@ -377,15 +356,17 @@ class PREDICTOR
     {
         // TODO: Check whether this function is called for non-conditional branches.
         // Update the state
-        ghist = (ghist << 1);
-        if ((!(aBPState.thePredictedType == kConditional)) | (taken)) ghist[0] = 1;
+        uint32_t in = (!(aBPState.thePredictedType == kConditional)) | (taken);
+        ++theHead;
+        theHistory[theHead & (kTageHistoryBuffer - 1)] = in;
 
         phist = (phist << 1) + (instruction_addr >> 2 & 1);
         phist = (phist & ((1 << 16) - 1));
-        for (int i = 0; i < NHIST; i++) {
-            ch_i[i].update(ghist);
-            ch_t[0][i].update(ghist);
-            ch_t[1][i].update(ghist);
+        for (int i = 0; i < NHIST(); i++) {
+            uint32_t out = history(m[i]);
+            ch_i[i]      = fold(ch_i[i], in, out, theFoldOutpoint[0][i], theFoldLength[0][i]);
+            ch_t[0][i]   = fold(ch_t[0][i], in, out, theFoldOutpoint[1][i], theFoldLength[1][i]);
+            ch_t[1][i]   = fold(ch_t[1][i], in, out, theFoldOutpoint[2][i], theFoldLength[2][i]);
         }
     }
 
@@ -397,11 +378,11 @@ class PREDICTOR
 
             address_t pc = instruction_addr >> 2;
             // computes the table addresses
-            for (int i = 0; i < NHIST; i++)
-                aBPState.GI[i] = gindex(pc, i);
+            uint16_t tags[kTageMaxTables];
+            gindex_gtag(pc, aBPState.GI, tags);
             aBPState.BI = bindex(pc);
 
-            read_prediction(pc, aBPState);
+            read_prediction(pc, aBPState, tags);
 
             update_history(aBPState, aBPState.pred_taken, instruction_addr);
 
@@ -415,6 +396,7 @@ class PREDICTOR
         __builtin_unreachable();
     }
 
+  private:
     bool getbim(address_t pc, int BI) { return (btable[BI].pred > 0); }
 
     int8_t getSatCounter(int BI) { return (btable[BI].pred << 1) + btable[BI].hyst; }
@@ -452,63 +434,49 @@ class PREDICTOR
 
     int MYRANDOM()
     {
-        Seed = ((1 << 2 * NHIST) + 1) * Seed + 0xf3f531;
-        Seed = (Seed & ((1 << (2 * (NHIST))) - 1));
+        Seed = ((1 << 2 * NHIST()) + 1) * Seed + 0xf3f531;
+        Seed = (Seed & ((1 << (2 * (NHIST()))) - 1));
         return (Seed);
     }
 
+  public:
     void restore_history(const BPredState& aBPState)
     {
 
         DBG_Assert(aBPState.theTageHistoryValid);
-
-        for (int i = 0; i < NHIST; i++) {
-            ch_i[i].comp    = aBPState.ch_i[i];
-            DBG_Assert((ch_i[i].comp >> ch_i[i].CLENGTH) == 0);
-            ch_t[0][i].comp = aBPState.ch_t[0][i];
-            DBG_Assert((ch_t[0][i].comp >> ch_t[0][i].CLENGTH) == 0);
-            ch_t[1][i].comp = aBPState.ch_t[1][i];
-            DBG_Assert((ch_t[1][i].comp >> ch_t[0][i].CLENGTH) == 0);
+        // The history of the checkpoint must not have been overwritten since
+        DBG_Assert(theHead - aBPState.ghist_head <= uint64_t(kTageHistoryBuffer - MAXHIST) ||
+                     aBPState.ghist_head - theHead <= uint64_t(kTageHistoryBuffer - MAXHIST),
+                   (<< "TAGE history checkpoint is " << theHead - aBPState.ghist_head << " branches old"));
+
+        for (int i = 0; i < NHIST(); i++) {
+            ch_i[i]    = aBPState.ch_i[i];
+            ch_t[0][i] = aBPState.ch_t[0][i];
+            ch_t[1][i] = aBPState.ch_t[1][i];
         }
 
-        phist = aBPState.phist;
-        ghist = std::bitset<MAXHIST>(aBPState.ghist.to_string());
+        phist   = aBPState.phist;
+        theHead = aBPState.ghist_head;
     }
 
     // PREDICTOR UPDATE
     void update_predictor(uint64_t instruction_addr, const BPredState& aBPState, bool taken)
     {
-
-        //	  std::cout << std::endl<< std::endl<< std::endl<< std::endl << "Tage update " << taken <<
-        // std::endl<< std::endl<< std::endl<< std::endl<< std::endl;
         DBG_(VVerb, (<< " TAGE feedback: " << std::hex << instruction_addr));
         if (aBPState.thePredictedType == kConditional) {
-            int phist_back;
-            history_t ghist_back;
-            folded_history ch_i_back[NHIST];
-            folded_history ch_t_back[2][NHIST];
-
-            /*Save the current history*/
-            phist_back = phist;
-            ghist_back = std::bitset<MAXHIST>(ghist.to_string());
-            for (int i = 0; i < NHIST; i++) {
-                ch_i_back[i].comp    = ch_i[i].comp;
-                ch_t_back[0][i].comp = ch_t[0][i].comp;
-                ch_t_back[1][i].comp = ch_t[1][i].comp;
-            }
-            /*Done*/
-            /*Restore the history when the branch was predicted*/
-            restore_history(aBPState);
+            // The tags are computed with the history the branch was predicted with, which
+            // the BPredState holds; the current history is left untouched.
+            DBG_Assert(aBPState.theTageHistoryValid);
 
             // GI, BI, bank, altbank, pred_taken, alt_pred
-            int GI[NHIST] = {0};
+            int GI[kTageMaxTables] = {0};
             int BI = 0;
             int bank = 0;
             bool alt_pred = false;
             bool pred_taken = false;
 
             if (aBPState.theTagePredictionValid) {
-                for (int i = 0; i < NHIST; i++)
+                for (int i = 0; i < NHIST(); i++)
                     GI[i] = aBPState.GI[i];
                 BI        = aBPState.BI;
                 bank      = aBPState.bank;
@@ -526,10 +494,10 @@ class PREDICTOR
              */
             bool ALLOC = ((pred_taken != taken) & (bank > 0));
 
-            if (bank < NHIST) {
-                bool loctaken = (gtable[bank][GI[bank]].ctr >= 0);
+            if (bank < NHIST()) {
+                bool loctaken = (gt(bank, GI[bank]).ctr >= 0);
                 bool PseudoNewAlloc =
-                  (abs(2 * gtable[bank][GI[bank]].ctr + 1) == 1) && (gtable[bank][GI[bank]].ubit == 0);
+                  (abs(2 * gt(bank, GI[bank]).ctr + 1) == 1) && (gt(bank, GI[bank]).ubit == 0);
                 // is entry "pseudo-new allocated"
 
                 if (PseudoNewAlloc) {
@@ -538,17 +506,6 @@ class PREDICTOR
                     // if the provider component  was delivering the correct prediction; no need to allocate a
                     // new entry
                     // even if the overall prediction was false
-
-                    // see section 3.2.4
-                    // if (loctaken != alt_pred) {
-                    //     if (alt_pred == taken) {
-
-                    //         if (PWIN < 7) PWIN++;
-                    //     }
-
-                    //     else if (PWIN > -8)
-                    //         PWIN--;
-                    // }
                 }
             }
 
@@ -559,14 +516,14 @@ class PREDICTOR
                 // is there some "unuseful" entry to allocate
                 int8_t min = 3;
                 for (int i = 0; i < bank; i++) {
-                    if (gtable[i][GI[i]].ubit < min) min = gtable[i][GI[i]].ubit;
+                    if (gt(i, GI[i]).ubit < min) min = gt(i, GI[i]).ubit;
                 }
 
                 if (min > 0) {
 
                     // NO UNUSEFUL ENTRY TO ALLOCATE: age all possible targets, but do not allocate
                     for (int i = bank - 1; i >= 0; i--) {
-                        gtable[i][GI[i]].ubit--;
+                        gt(i, GI[i]).ubit--;
                     }
 
                 } else {
@@ -585,12 +542,10 @@ class PREDICTOR
 
                     {
                         int T = i;
-                        if (gtable[T][GI[T]].ubit == min) {
-                            //		    		std::cout << "Bank alloc " << T << std::endl;
-
-                            gtable[T][GI[T]].tag  = gtag(pc, T);
-                            gtable[T][GI[T]].ctr  = (taken) ? 0 : -1;
-                            gtable[T][GI[T]].ubit = 0;
+                        if (gt(T, GI[T]).ubit == min) {
+                            gt(T, GI[T]).tag  = (pc ^ aBPState.ch_t[0][T] ^ (aBPState.ch_t[1][T] << 1)) & theTagMask[T];
+                            gt(T, GI[T]).ctr  = (taken) ? 0 : -1;
+                            gt(T, GI[T]).ubit = 0;
                             break;
                         }
                     }
@@ -602,40 +557,28 @@ class PREDICTOR
             if ((TICK & ((1 << 18) - 1)) == 0) {
                 int X = (TICK >> 18) & 1;
                 if ((X & 1) == 0) X = 2;
-                for (int i = 0; i < NHIST; i++)
-                    for (int j = 0; j < (1 << LOGG); j++)
-                        gtable[i][j].ubit = gtable[i][j].ubit & X;
+                for (auto& entry : gtable)
+                    entry.ubit = entry.ubit & X;
             }
 
             // update the counter that provided the prediction, and only this counter
-            if (bank < NHIST) {
-                ctrupdate(gtable[bank][GI[bank]].ctr, taken, CBITS);
+            if (bank < NHIST()) {
+                ctrupdate(gt(bank, GI[bank]).ctr, taken, CBITS);
             } else {
                 baseupdate(pc, taken, BI);
             }
             // update the ubit counter
             if ((pred_taken != alt_pred)) {
-                ASSERT(bank < NHIST);
+                ASSERT(bank < NHIST());
 
                 if (pred_taken == taken) {
 
-                    if (gtable[bank][GI[bank]].ubit < 3) gtable[bank][GI[bank]].ubit++;
+                    if (gt(bank, GI[bank]).ubit < 3) gt(bank, GI[bank]).ubit++;
 
                 } else {
-                    if (gtable[bank][GI[bank]].ubit > 0) gtable[bank][GI[bank]].ubit--;
+                    if (gt(bank, GI[bank]).ubit > 0) gt(bank, GI[bank]).ubit--;
                 }
             }
-
-            /*Restore the current history*/
-            phist = phist_back;
-            ghist = std::bitset<MAXHIST>(ghist_back.to_string());
-            for (int i = 0; i < NHIST; i++) {
-                ch_i[i].comp    = ch_i_back[i].comp;
-                ch_t[0][i].comp = ch_t_back[0][i].comp;
-                ch_t[1][i].comp = ch_t_back[1][i].comp;
-            }
-
-            /*Done*/
         }
     }
 
@@ -647,7 +590,7 @@ class PREDICTOR
         checkpoint["SEED"]    = Seed;
         checkpoint["PHIST"]   = phist;
         checkpoint["LOGB"]    = LOGB;
-        checkpoint["NHIST"]   = NHIST;
+        checkpoint["NHIST"]   = NHIST();
         checkpoint["LOGG"]    = LOGG;
         checkpoint["TBITS"]   = TBITS;
         checkpoint["MAXHIST"] = MAXHIST;
@@ -655,7 +598,7 @@ class PREDICTOR
         checkpoint["CBITS"]   = CBITS;
 
         for (int i = 0; i < MAXHIST; ++i) {
-            checkpoint["GHIST"].push_back(ghist[i]);
+            checkpoint["GHIST"].push_back(history(i));
         }
 
         // bimodal table
@@ -668,15 +611,16 @@ class PREDICTOR
             checkpoint["btable"].push_back(btable_json);
         }
 
-        for (int i = 0; i < NHIST; i++) {
+        for (int i = 0; i < NHIST(); i++) {
             json gtable_array_json;
 
             for (int j = 0; j < (1 << LOGG); j++) {
                 json gtable_json;
+                gentry const& entry = gtable[(i << LOGG) + j];
 
-                gtable_json["ctr"]  = (int)gtable[i][j].ctr;
-                gtable_json["tag"]  = (int)gtable[i][j].tag;
-                gtable_json["ubit"] = (int)gtable[i][j].ubit;
+                gtable_json["ctr"]  = (int)entry.ctr;
+                gtable_json["tag"]  = (int)entry.tag;
+                gtable_json["ubit"] = (int)entry.ubit;
 
                 gtable_array_json.push_back(gtable_json);
             }
@@ -684,12 +628,12 @@ class PREDICTOR
             checkpoint["gtable"].push_back(gtable_array_json);
         };
 
-        for (int i = 0; i < NHIST; i++) {
+        for (int i = 0; i < NHIST(); i++) {
             json ch_i_json;
 
-            ch_i_json["comp"]     = (uint32_t)ch_i[i].comp;
-            ch_i_json["c_length"] = (uint32_t)ch_i[i].CLENGTH;
-            ch_i_json["o_length"] = (uint32_t)ch_i[i].OLENGTH;
+            ch_i_json["comp"]     = (uint32_t)ch_i[i];
+            ch_i_json["c_length"] = (uint32_t)theFoldLength[0][i];
+            ch_i_json["o_length"] = (uint32_t)m[i];
 
             checkpoint["ch_i"].push_back(ch_i_json);
         }
@@ -697,12 +641,12 @@ class PREDICTOR
         for (int j = 0; j < 2; j++) {
             json ch_t_array_json;
 
-            for (int i = 0; i < NHIST; i++) {
+            for (int i = 0; i < NHIST(); i++) {
                 json ch_t_json;
 
-                ch_t_json["comp"]      = (uint32_t)ch_t[j][i].comp;
-                ch_t_json["o_length"]  = (uint32_t)ch_t[j][i].OLENGTH;
-                ch_t_json["out_point"] = (uint32_t)ch_t[j][i].OUTPOINT;
+                ch_t_json["comp"]      = (uint32_t)ch_t[j][i];
+                ch_t_json["o_length"]  = (uint32_t)m[i];
+                ch_t_json["out_point"] = (uint32_t)theFoldOutpoint[j + 1][i];
 
                 ch_t_array_json.push_back(ch_t_json);
             }
@@ -710,7 +654,7 @@ class PREDICTOR
             checkpoint["ch_t"].push_back(ch_t_array_json);
         }
 
-        for (int i = 0; i < NHIST; i++) {
+        for (int i = 0; i < NHIST(); i++) {
             checkpoint["m"].push_back(m[i]);
         };
 
@@ -721,7 +665,7 @@ class PREDICTOR
     {
 
         DBG_Assert(LOGB == checkpoint["LOGB"]);
-        DBG_Assert(NHIST == checkpoint["NHIST"]);
+        DBG_Assert(NHIST() == checkpoint["NHIST"]);
         DBG_Assert(LOGG == checkpoint["LOGG"]);
         DBG_Assert(TBITS == checkpoint["TBITS"]);
         DBG_Assert(MAXHIST == checkpoint["MAXHIST"]);
@@ -733,8 +677,9 @@ class PREDICTOR
         phist = checkpoint["PHIST"];
 
         // Load the g history
+        theHead = MAXHIST;
         for (int i = 0; i < MAXHIST; i++) {
-            ghist[i] = checkpoint["GHIST"][i];
+            theHistory[(theHead - i) & (kTageHistoryBuffer - 1)] = checkpoint["GHIST"][i];
         }
 
         // bimodal table
@@ -743,34 +688,44 @@ class PREDICTOR
             btable[i].pred = checkpoint["btable"][i]["pred"];
         }
 
-        for (int i = 0; i < NHIST; i++) {
+        for (int i = 0; i < NHIST(); i++) {
             for (int j = 0; j < (1 << LOGG); j++) {
-                gtable[i][j].ctr  = checkpoint["gtable"][i][j]["ctr"];
-                gtable[i][j].tag  = checkpoint["gtable"][i][j]["tag"];
-                gtable[i][j].ubit = checkpoint["gtable"][i][j]["ubit"];
+                gentry& entry = gt(i, j);
+                entry.ctr     = checkpoint["gtable"][i][j]["ctr"];
+                entry.tag     = checkpoint["gtable"][i][j]["tag"];
+                entry.ubit    = checkpoint["gtable"][i][j]["ubit"];
             }
         };
 
-        for (int i = 0; i < NHIST; i++) {
-            ch_i[i].comp    = checkpoint["ch_i"][i]["comp"];
-            ch_i[i].CLENGTH = checkpoint["ch_i"][i]["c_length"];
-            ch_i[i].OLENGTH = checkpoint["ch_i"][i]["o_length"];
+        for (int i = 0; i < NHIST(); i++) {
+            ch_i[i] = checkpoint["ch_i"][i]["comp"];
         }
 
         for (int j = 0; j < 2; j++) {
-            for (int i = 0; i < NHIST; i++) {
-                ch_t[j][i].comp     = checkpoint["ch_t"][j][i]["comp"];
-                ch_t[j][i].OLENGTH  = checkpoint["ch_t"][j][i]["o_length"];
-                ch_t[j][i].OUTPOINT = checkpoint["ch_t"][j][i]["out_point"];
+            for (int i = 0; i < NHIST(); i++) {
+                ch_t[j][i] = checkpoint["ch_t"][j][i]["comp"];
             }
         }
 
-        for (int i = 0; i < NHIST; i++) {
+        for (int i = 0; i < NHIST(); i++) {
             // Check whether two m are the same.
             DBG_Assert(m[i] == checkpoint["m"][i]);
         }
     };
-}; // namespace SharedTypes
-} // namespace Flexus
+};
+
+inline TagePredictor*
+TagePredictor::create(TageGeometry const& aGeometry)
+{
+    switch (aGeometry.NHIST) {
+        case 4: return new TageImpl<4>(aGeometry);
+        case 7: return new TageImpl<7>(aGeometry);
+        case 12: return new TageImpl<12>(aGeometry);
+        case 13: return new TageImpl<13>(aGeometry);
+        default: return new TageImpl<0>(aGeometry);
+    }
 }
+
+} // namespace SharedTypes
+} // namespace Flexus
 #endif // PREDICTOR_H_SEEN
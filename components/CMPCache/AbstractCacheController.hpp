@@ -59,6 +59,8 @@ class AbstractCacheController
 
     virtual void loadState(std::string const& aDirName) = 0;
 
+    Flexus::Core::Warming::SharedCache* warming() { return thePolicy->warming(); }
+
     inline void reserveSnoopOut(ProcessEntry_p process, uint8_t n)
     {
 
@@ -1,10 +1,38 @@
 #ifndef __ABSTRACT_DIRECTORY_HPP__
 #define __ABSTRACT_DIRECTORY_HPP__
 
+#include <core/option_schema.hpp>
 #include <string>
 
 namespace nCMPCache {
 
+// The options of a directory slice, "sets=<sets>:assoc=<ways>[:skew=true]",
+// where total_sets may replace sets to give the sets of all the slices. As
+// before the schema, only skew=true skews the sets; a bare skew or skew=1
+// leaves them unskewed. An infinite directory accepts and ignores them.
+struct DirectoryOptions
+{
+    int32_t sets       = 0;
+    int32_t total_sets = 0;
+    int32_t assoc      = 0;
+    std::string skew   = "false";
+
+    // The associativities the set lookup is compiled for
+    typedef Flexus::Core::Specializations<int32_t, 2, 4, 8, 16> assoc_specializations;
+
+    static Flexus::Core::OptionSchema<DirectoryOptions> const& schema()
+    {
+        static const Flexus::Core::OptionSchema<DirectoryOptions> theSchema =
+          Flexus::Core::OptionSchema<DirectoryOptions>("directory")
+            .option("sets", &DirectoryOptions::sets, "sets in this slice")
+            .option("total_sets|global_sets", &DirectoryOptions::total_sets, "sets in all the slices")
+            .option("assoc|associativity", &DirectoryOptions::assoc, "ways per set", assoc_specializations())
+            .option("skew|skew_set", &DirectoryOptions::skew, "hash the set index with the upper address bits")
+            .exclusive("sets", "total_sets");
+        return theSchema;
+    }
+};
+
 template<typename _State>
 class AbstractLookupResult : public boost::counted_base
 {
@@ -55,37 +83,13 @@ template<typename _State, typename _EState>
 AbstractDirectory<_State, _EState>*
 constructDirectory(const CMPCacheInfo& params)
 {
-    std::string args = params.theDirParams;
-
-    // First, extract the Name of the type of array to consruct
-    std::string::size_type loc = args.find(':', 0);
-    std::string name           = args.substr(0, loc);
-
-    // Now create a list of key,value pairs
-    std::list<std::pair<std::string, std::string>> arg_list;
-    std::string key;
-    std::string value;
-    std::string::size_type pos = 0;
-    do {
-        pos                              = args.find(':', 0);
-        std::string cur_arg              = args.substr(0, pos);
-        std::string::size_type equal_pos = cur_arg.find('=', 0);
-        if (equal_pos == std::string::npos) {
-            key   = cur_arg;
-            value = "1";
-        } else {
-            key   = cur_arg.substr(0, equal_pos);
-            value = cur_arg.substr(equal_pos + 1);
-        }
-        if (key != "") { arg_list.push_back(std::make_pair(key, value)); }
-        if (pos != std::string::npos) { args = args.substr(pos + 1); }
-    } while (pos != std::string::npos);
+    DirectoryOptions options = DirectoryOptions::schema().parse(params.theDirParams);
 
     const std::string& type = params.theDirType;
     if (strcasecmp(type.c_str(), "std") == 0 || strcasecmp(type.c_str(), "standard") == 0) {
-        return new StdDirectory<_State, _EState>(params, arg_list);
+        return new StdDirectory<_State, _EState>(params, options);
     } else if (strcasecmp(type.c_str(), "infinite") == 0 || strcasecmp(type.c_str(), "inf") == 0) {
-        return new InfiniteDirectory<_State, _EState>(params, arg_list);
+        return new InfiniteDirectory<_State, _EState>(params, options);
     }
 
     DBG_Assert(false, (<< "Failed to create instance of '" << type << "' directory. Type unknown."));
@@ -7,6 +7,7 @@
 #include <components/CMPCache/EvictBuffer.hpp>
 #include <components/CMPCache/ProcessEntry.hpp>
 #include <components/CommonQEMU/AbstractFactory.hpp>
+#include <core/warming.hpp>
 #include <iostream>
 
 namespace nCMPCache {
@@ -57,6 +58,9 @@ class AbstractPolicy
     virtual void load_dir_from_ckpt(std::string const&)   = 0;
     virtual void load_cache_from_ckpt(std::string const&) = 0;
 
+    // The policy's functional side, if it can be warmed
+    virtual Flexus::Core::Warming::SharedCache* warming() { return nullptr; }
+
     virtual void reserveArrayEvictResource(int32_t n)   = 0;
     virtual void unreserveArrayEvictResource(int32_t n) = 0;
 
@@ -51,7 +51,7 @@ COMPONENT_INTERFACE(
   PORT(PushInput, MemoryTransport, Request_In)
   PORT(PushInput, MemoryTransport, Snoop_In)
   PORT(PushInput, MemoryTransport, Reply_In)
-  DRIVE(CMPCacheDrive)
+  INDEPENDENT_DRIVE(CMPCacheDrive)
 );
 
 #include FLEXUS_END_COMPONENT_DECLARATION()
@@ -77,6 +77,8 @@ class FLEXUS_COMPONENT(CMPCache)
         //	theController.reset(new CMPCacheController(theInfo));
         theController.reset(
           AbstractFactory<AbstractCacheController, CMPCacheInfo>::createInstance(cfg.ControllerType, theInfo));
+
+        if (auto* shared = theController->warming()) { Warming::attachShared(flexusIndex(), shared); }
     }
 
     void finalize() {}
@@ -154,13 +156,16 @@ class FLEXUS_COMPONENT(CMPCache)
 
     // DirectoryDrive
     //----------
+    // The banks run processMessages() concurrently; what they produce stays
+    // in the controller's out queues until commit().
     void drive(interface::CMPCacheDrive const&)
     {
         DBG_(VVerb, Comp(*this)(<< "drive()"));
         theController->processMessages();
-        busCycle();
     }
 
+    void commit(interface::CMPCacheDrive const&) { busCycle(); }
+
     void busCycle()
     {
         FLEXUS_PROFILE();
@@ -120,7 +120,7 @@ class InfiniteDirectory : public AbstractDirectory<_State, _EState>
     typedef InfiniteLookupResult LookupResult;
     typedef typename boost::intrusive_ptr<LookupResult> LookupResult_p;
 
-    InfiniteDirectory(const CMPCacheInfo& theInfo, std::list<std::pair<std::string, std::string>>& args)
+    InfiniteDirectory(const CMPCacheInfo& theInfo, DirectoryOptions const&)
       : theEvictBuffer(theInfo.theDirEBSize)
       , theSameSetReturnValue(false)
       , theName(theInfo.theName)
@@ -197,7 +197,18 @@ class InfiniteDirectory : public AbstractDirectory<_State, _EState>
 
             DBG_Assert(node_idx_of_cacheline == theNodeId, (<< "Address " << std::hex << address << " is not in the correct node. Expected node " << theNodeId << " but got node " << node_idx_of_cacheline));
 
-            std::bitset<MAX_NUM_SHARERS> sharers(checkpoint.at(i)["sharers"].get<std::string>());
+            // Either a string of '0' and '1' characters, or the list of the
+            // sharers, which is far shorter for the usual one or two sharers
+            std::bitset<MAX_NUM_SHARERS> sharers;
+            json const& entry_sharers = checkpoint.at(i)["sharers"];
+            if (entry_sharers.is_string()) {
+                sharers = std::bitset<MAX_NUM_SHARERS>(entry_sharers.get<std::string>());
+            } else {
+                for (json const& sharer : entry_sharers) {
+                    DBG_Assert(sharer.get<uint32_t>() < MAX_NUM_SHARERS, (<< "Sharer out of range"));
+                    sharers.set(sharer.get<uint32_t>());
+                }
+            }
 
             DBG_Assert(sharers.size() <= MAX_NUM_SHARERS, (<< "Sharers size mismatch"));
 
@@ -1719,20 +1719,9 @@ NonInclusiveMESIPolicy::wakeMAFs(MemoryAddress anAddress)
     DirLookupResult_p d_lookup = theDirectory->lookup(anAddress);
     if (d_lookup->found()) { d_lookup->setProtected(false); }
 
-    MissAddressFile::order_iterator iter = theMAF.ordered_begin();
-    MissAddressFile::order_iterator next = iter;
-
-    while (iter != theMAF.ordered_end()) {
-        next++;
-
-        if ((iter->state() == eWaitRequest) && (iter->address() == anAddress)) {
-            theMAF.wake(iter);
-        } else if ((iter->state() == eWaitSet) && theDirectory->sameSet(anAddress, iter->address())) {
-            theMAF.wake(iter);
-        }
-
-        iter = next;
-    }
+    theMAF.wakeAll(anAddress, eWaitRequest);
+    theMAF.wakeIf(eWaitSet,
+                  [this, anAddress](MemoryAddress anOther) { return theDirectory->sameSet(anAddress, anOther); });
 }
 
 int32_t
@@ -1766,4 +1755,116 @@ NonInclusiveMESIPolicy::evictCacheBlock(CacheLookupResult_p victim)
     }
 }
 
+// Functional warming: the states doRequest(), doEvict() and handleReply()
+// leave, without messages, MAF entries or statistics. The caches are
+// quiesced, so no entry is protected and the evict buffers are empty.
+
+using Flexus::Core::Warming;
+
+Warming::eGrant
+NonInclusiveMESIPolicy::warmRequest(int32_t aSharer, uint64_t anAddress, Warming::eAccess anAccess)
+{
+    MemoryAddress address        = theCache->blockAddress(MemoryAddress(anAddress));
+    DirLookupResult_p dir_lookup = theDirectory->lookup(address);
+    if (!dir_lookup->found()) {
+        if (!allocateDirectoryEntry(dir_lookup, address, theDefaultState)) return Warming::kNone;
+        warmDirEvictions();
+    }
+    CacheLookupResult_p c_lookup = (*theCache)[address];
+
+    if (anAccess == Warming::kStore) {
+        std::list<int> sharers;
+        dir_lookup->state().getOtherSharers(sharers, aSharer);
+        for (int32_t sharer : sharers) {
+            Warming::invalidate(sharer, address);
+        }
+        if (c_lookup->state() != CacheState::Invalid) {
+            c_lookup->setState(CacheState::Invalid);
+            theCache->invalidateBlock(c_lookup);
+        }
+        dir_lookup->setSharer(aSharer);
+        return Warming::kModified;
+    }
+
+    // Not on chip: memory replies writable to a read
+    if (dir_lookup->state().noSharers() && c_lookup->state() == CacheState::Invalid) {
+        dir_lookup->addSharer(aSharer);
+        return anAccess == Warming::kFetch ? Warming::kShared : Warming::kExclusive;
+    }
+
+    // A sharer may hold it modified: it supplies the block and keeps a copy
+    if (c_lookup->state() == CacheState::Invalid ||
+        (dir_lookup->state().oneSharer() && c_lookup->state() == CacheState::Exclusive)) {
+        int32_t sharer       = pickSharer(dir_lookup->state(), aSharer, theCMPCacheInfo.theNodeId);
+        Warming::eGrant held = Warming::downgrade(sharer, address);
+        if (c_lookup->state() == CacheState::Invalid) {
+            warmAllocate(address, held == Warming::kModified ? CacheState::Modified : CacheState::Shared);
+        }
+        dir_lookup->addSharer(aSharer);
+        return Warming::kShared;
+    }
+
+    Warming::eGrant grant = Warming::kShared;
+    if (dir_lookup->state().noSharers() && c_lookup->state() != CacheState::Shared &&
+        anAccess != Warming::kFetch) {
+        grant = Warming::kExclusive;
+        if (c_lookup->state() == CacheState::Modified) {
+            grant = Warming::kModified;
+            c_lookup->setState(CacheState::Invalid);
+            theCache->invalidateBlock(c_lookup);
+        }
+    }
+    if (c_lookup->state() != CacheState::Invalid) theCache->recordAccess(c_lookup);
+    dir_lookup->addSharer(aSharer);
+    return grant;
+}
+
+void
+NonInclusiveMESIPolicy::warmEvict(int32_t aSharer, uint64_t anAddress, Warming::eGrant aGrant)
+{
+    MemoryAddress address        = theCache->blockAddress(MemoryAddress(anAddress));
+    DirLookupResult_p dir_lookup = theDirectory->lookup(address);
+    if (!dir_lookup->found() || !dir_lookup->state().isSharer(aSharer)) return;
+    dir_lookup->removeSharer(aSharer);
+
+    // Only dirty and writable evictions carry data
+    if (aGrant == Warming::kModified) {
+        warmAllocate(address, CacheState::Modified);
+    } else if (aGrant == Warming::kExclusive) {
+        CacheLookupResult_p c_lookup = (*theCache)[address];
+        warmAllocate(address, c_lookup->state() == CacheState::Invalid ? CacheState::Exclusive : CacheState::Modified);
+    }
+}
+
+void
+NonInclusiveMESIPolicy::warmAllocate(MemoryAddress anAddress, const CacheState& aState)
+{
+    CacheLookupResult_p c_lookup = (*theCache)[anAddress];
+    if (c_lookup->state() == CacheState::Invalid) {
+        // The victim would be written back to memory
+        theCache->allocate(c_lookup, anAddress);
+    } else {
+        theCache->recordAccess(c_lookup);
+    }
+    c_lookup->setState(aState);
+}
+
+// Directory victims lose their sharers at once, instead of through back
+// invalidates; a dirty copy is written to the cache
+void
+NonInclusiveMESIPolicy::warmDirEvictions()
+{
+    while (const AbstractDirEBEntry<State>* d_eb = theDirEvictBuffer->oldestRequiringInvalidates()) {
+        MemoryAddress address = d_eb->address();
+        std::list<int> sharers;
+        d_eb->state().getSharerList(sharers);
+        theDirEvictBuffer->remove(address);
+        for (int32_t sharer : sharers) {
+            if (Warming::invalidate(sharer, address) == Warming::kModified) {
+                warmAllocate(address, CacheState::Modified);
+            }
+        }
+    }
+}
+
 }; // namespace nCMPCache
@@ -14,7 +14,9 @@
 
 namespace nCMPCache {
 
-class NonInclusiveMESIPolicy : public AbstractPolicy
+class NonInclusiveMESIPolicy
+  : public AbstractPolicy
+  , public Flexus::Core::Warming::SharedCache
 {
 
   public:
@@ -56,6 +58,12 @@ class NonInclusiveMESIPolicy : public AbstractPolicy
     virtual void load_dir_from_ckpt(std::string const&);
     virtual void load_cache_from_ckpt(std::string const&);
 
+    virtual Flexus::Core::Warming::SharedCache* warming() { return this; }
+    virtual Flexus::Core::Warming::eGrant warmRequest(int32_t aSharer,
+                                                      uint64_t anAddress,
+                                                      Flexus::Core::Warming::eAccess anAccess);
+    virtual void warmEvict(int32_t aSharer, uint64_t anAddress, Flexus::Core::Warming::eGrant aGrant);
+
     virtual AbstractDirEvictBuffer& DirEB() { return *theDirEvictBuffer; }
     virtual AbstractEvictBuffer& CacheEB() { return theCacheEvictBuffer; }
     virtual const AbstractEvictBuffer& CacheEB() const { return theCacheEvictBuffer; }
@@ -91,6 +99,8 @@ class NonInclusiveMESIPolicy : public AbstractPolicy
 
     int32_t pickSharer(const SimpleDirectoryState& state, int32_t requester, int32_t dir);
     void evictCacheBlock(CacheLookupResult_p victim);
+    void warmAllocate(MemoryAddress anAddress, const CacheState& aState);
+    void warmDirEvictions();
 };
 
 }; // namespace nCMPCache
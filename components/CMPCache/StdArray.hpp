@@ -7,6 +7,7 @@
 #include "components/CommonQEMU/Util.hpp"
 #include "core/checkpoint/json.hpp"
 #include "core/debug/debug.hpp"
+#include "core/option_schema.hpp"
 #include "core/target.hpp"
 #include "core/types.hpp"
 
@@ -30,6 +31,31 @@ enum ReplacementPolicy
     REPLACEMENT_LRU,
 };
 
+// The options of a StdArray slice, "STD:sets=<sets>:assoc=<ways>:repl=lru",
+// where total_sets may replace sets to give the sets of all the slices
+struct StdArrayOptions
+{
+    uint64_t sets       = 0;
+    uint64_t total_sets = 0;
+    uint64_t assoc      = 0;
+    std::string repl    = "lru";
+
+    // The associativities the set lookup is compiled for
+    typedef Flexus::Core::Specializations<uint64_t, 2, 4, 8, 16> assoc_specializations;
+
+    static Flexus::Core::OptionSchema<StdArrayOptions> const& schema()
+    {
+        static const Flexus::Core::OptionSchema<StdArrayOptions> theSchema =
+          Flexus::Core::OptionSchema<StdArrayOptions>("StdArray")
+            .option("sets", &StdArrayOptions::sets, "sets in this slice")
+            .option("total_sets", &StdArrayOptions::total_sets, "sets in all the slices")
+            .option("assoc|associativity", &StdArrayOptions::assoc, "ways per set", assoc_specializations())
+            .option("repl|replacement", &StdArrayOptions::repl, "replacement policy, lru")
+            .exclusive("sets", "total_sets");
+        return theSchema;
+    }
+};
+
 // This is a cache block.  The accessor functions are braindead simple.
 template<typename _State, const _State& _DefaultState>
 class Block
@@ -133,12 +159,20 @@ class Set
 
     LookupResult_p lookupBlock(const MemoryAddress anAddress)
     {
+        // The common associativities get loops of a known length
+        return StdArrayOptions::assoc_specializations::dispatch(
+          theAssociativity, [&](auto anAssoc) { return lookupIn<decltype(anAssoc)::value>(anAddress); });
+    }
+
+    // Assoc is the associativity, or 0 for theAssociativity
+    template<uint64_t Assoc>
+    LookupResult_p lookupIn(const MemoryAddress anAddress)
+    {
+        const uint64_t assoc = Assoc ? Assoc : theAssociativity;
         uint64_t i, t = 0xffffffffffffffffULL;
 
         // Linearly search through the set for the matching block
-        // This could be made faster for higher-associativity sets
-        // Through other search methods
-        for (i = 0; i < theAssociativity; i++) {
+        for (i = 0; i < assoc; i++) {
             if (theBlocks[i].tag() == anAddress) {
                 if (theBlocks[i].valid()) {
                     return LookupResult_p(new LookupResult(this, &(theBlocks[i]), anAddress, true));
@@ -433,9 +467,7 @@ class StdArray : public AbstractArray<_State>
 
   public:
     virtual ~StdArray() {}
-    StdArray(CMPCacheInfo& aCacheInfo,
-             const uint64_t aBlockSize,
-             const std::list<std::pair<std::string, std::string>>& theConfiguration)
+    StdArray(CMPCacheInfo& aCacheInfo, const uint64_t aBlockSize, StdArrayOptions const& anOptions)
       : theInfo(aCacheInfo)
     {
         theBlockSize         = aBlockSize;
@@ -447,31 +479,16 @@ class StdArray : public AbstractArray<_State>
         theNumNodes = Flexus::Core::ComponentManager::getComponentManager().systemWidth();
         DBG_Assert(theNumNodes > 0);
 
-        std::list<std::pair<std::string, std::string>>::const_iterator iter = theConfiguration.begin();
-        for (; iter != theConfiguration.end(); iter++) {
-            if (iter->first == "sets") {
-                theNumSets = strtoll(iter->second.c_str(), nullptr, 0);
-            } else if (iter->first == "total_sets") {
-                uint64_t total_sets = strtoll(iter->second.c_str(), nullptr, 0);
-                DBG_Assert(total_sets % theNumNodes == 0);
-                theNumSets = total_sets / theNumNodes;
-            } else if (strcasecmp(iter->first.c_str(), "assoc") == 0 ||
-                       strcasecmp(iter->first.c_str(), "associativity") == 0) {
-                theAssociativity = strtol(iter->second.c_str(), nullptr, 0);
-            } else if (strcasecmp(iter->first.c_str(), "repl") == 0 ||
-                       strcasecmp(iter->first.c_str(), "replacement") == 0) {
-                if (strcasecmp(iter->second.c_str(), "lru") == 0) {
-                    theReplacementPolicy = REPLACEMENT_LRU;
-                } else {
-                    DBG_Assert(false, (<< "Invalid replacement policy type " << iter->second));
-                }
-            } else {
-                DBG_Assert(false,
-                           (<< "Unknown configuration parameter '" << iter->first
-                            << "' while creating StdArray. Valid params are: "
-                               "sets, total_sets, assoc, repl"));
-            }
+        theNumSets = anOptions.sets;
+        if (anOptions.total_sets != 0) {
+            DBG_Assert(anOptions.total_sets % theNumNodes == 0);
+            theNumSets = anOptions.total_sets / theNumNodes;
         }
+        theAssociativity = anOptions.assoc;
+
+        DBG_Assert(strcasecmp(anOptions.repl.c_str(), "lru") == 0,
+                   (<< "Invalid replacement policy type " << anOptions.repl));
+        theReplacementPolicy = REPLACEMENT_LRU;
 
         init();
     }
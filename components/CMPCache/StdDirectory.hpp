@@ -114,8 +114,18 @@ class StdDirectory : public AbstractDirectory<_State, _EState>
 
         LookupResult_p lookup(MemoryAddress anAddress)
         {
+            // The common associativities get loops of a known length
+            return DirectoryOptions::assoc_specializations::dispatch(
+              theAssociativity, [&](auto anAssoc) { return lookupIn<decltype(anAssoc)::value>(anAddress); });
+        }
+
+        // Assoc is the associativity, or 0 for theAssociativity
+        template<int32_t Assoc>
+        LookupResult_p lookupIn(MemoryAddress anAddress)
+        {
+            const int32_t assoc = Assoc ? Assoc : theAssociativity;
             int32_t i;
-            for (i = 0; i < theAssociativity; i++) {
+            for (i = 0; i < assoc; i++) {
                 if (theBlocks[i].tag() == (uint64_t)anAddress) {
                     return LookupResult_p(new LookupResult(this, &(theBlocks[i]), anAddress, true));
                 }
@@ -232,7 +242,7 @@ class StdDirectory : public AbstractDirectory<_State, _EState>
         delete[] theSets;
     }
 
-    StdDirectory(const CMPCacheInfo& theInfo, const std::list<std::pair<std::string, std::string>>& theConfiguration)
+    StdDirectory(const CMPCacheInfo& theInfo, DirectoryOptions const& anOptions)
       : theEvictBuffer(theInfo.theDirEBSize)
       , theName(theInfo.theName)
     {
@@ -247,24 +257,20 @@ class StdDirectory : public AbstractDirectory<_State, _EState>
         theNumSharers        = theInfo.theCores;
         theTotalBanks        = theBanks * theGroups;
 
-        std::list<std::pair<std::string, std::string>>::const_iterator iter = theConfiguration.begin();
-        for (; iter != theConfiguration.end(); iter++) {
-            if (iter->first == "sets") {
-                theNumSets = strtoll(iter->second.c_str(), nullptr, 0);
-            } else if (iter->first == "total_sets" || iter->first == "global_sets") {
-                int32_t global_sets = strtol(iter->second.c_str(), nullptr, 0);
-                theNumSets          = global_sets / theTotalBanks;
-                DBG_Assert((theNumSets * theTotalBanks) == global_sets,
-                           (<< "global_sets (" << global_sets << ") is not divisible by number of banks ("
-                            << theTotalBanks << ")"));
-            } else if (iter->first == "assoc" || iter->first == "associativity") {
-                theAssociativity = strtol(iter->second.c_str(), nullptr, 0);
-            } else if (iter->first == "skew" || iter->first == "skew_set") {
-                theSkewSet = (strcasecmp(iter->second.c_str(), "true") == 0);
-            } else {
-                DBG_Assert(false,
-                           (<< "Unknown configuration parameter '" << iter->first << "' while creating StdArray"));
-            }
+        theNumSets = anOptions.sets;
+        if (anOptions.total_sets != 0) {
+            theNumSets = anOptions.total_sets / theTotalBanks;
+            DBG_Assert((theNumSets * theTotalBanks) == anOptions.total_sets,
+                       (<< "global_sets (" << anOptions.total_sets << ") is not divisible by number of banks ("
+                        << theTotalBanks << ")"));
+        }
+        theAssociativity = anOptions.assoc;
+        theSkewSet       = (strcasecmp(anOptions.skew.c_str(), "true") == 0);
+        DBG_Assert(theSkewSet || anOptions.skew == "1" || anOptions.skew == "0" ||
+                     strcasecmp(anOptions.skew.c_str(), "false") == 0,
+                   (<< "Invalid value '" << anOptions.skew << "' for option 'skew' of directory"));
+        if (anOptions.skew == "1") {
+            DBG_(Crit, (<< "Directory option 'skew' without '=true' leaves the sets unskewed"));
         }
 
         init();
@@ -115,49 +115,24 @@ namespace nCache {
  *
  * <Type> is the name of the array type to be created
  * and it is followed by an optional series of key,value pairs
- * that describe a configuration appropriate for that type
+ * that describe a configuration appropriate for that type, checked
+ * against the schema of that type
  *
  */
 template<typename _State, const _State& _Default>
 AbstractArray<_State>*
-constructArray(std::string& anArrayConfiguration, const std::string& theName, int32_t theNodeId, int32_t theBlockSize)
+constructArray(std::string const& anArrayConfiguration,
+               const std::string& theName,
+               int32_t theNodeId,
+               int32_t theBlockSize)
 {
-    std::string& args = anArrayConfiguration;
-
-    // First, extract the Name of the type of array to consruct
-    std::string::size_type loc = args.find(':', 0);
-    std::string name           = args.substr(0, loc);
-    if (loc != std::string::npos) {
-        args = args.substr(loc + 1);
-    } else {
-        args = "";
-    }
-
-    // Now create a list of key,value pairs
-    std::list<std::pair<std::string, std::string>> arg_list;
-    std::string key;
-    std::string value;
-    std::string::size_type pos = 0;
-    do {
-        pos                              = args.find(':', 0);
-        std::string cur_arg              = args.substr(0, pos);
-        std::string::size_type equal_pos = cur_arg.find('=', 0);
-        if (equal_pos == std::string::npos) {
-            key   = cur_arg;
-            value = "1";
-        } else {
-            key   = cur_arg.substr(0, equal_pos);
-            value = cur_arg.substr(equal_pos + 1);
-        }
-        arg_list.push_back(std::make_pair(key, value));
-
-        if (pos != std::string::npos) { args = args.substr(pos + 1); }
-    } while (pos != std::string::npos);
+    std::pair<std::string, std::string> spec = Flexus::Core::splitOptionType(anArrayConfiguration);
+    std::string const& name                  = spec.first;
 
     // Now construct an array of the appropriate type
     // BlockSize is always passed separately to avoid specifying it more than once
     if (name == "std" || name == "Std" || name == "STD") {
-        return new StdArray<_State, _Default>(theBlockSize, arg_list);
+        return new StdArray<_State, _Default>(theBlockSize, StdArrayOptions::schema().parse(spec.second));
     }
 
     DBG_Assert(false, (<< "Failed to create Instance of '" << name << "'"));
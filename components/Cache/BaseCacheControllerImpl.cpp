@@ -179,6 +179,96 @@ BaseCacheControllerImpl::loadState(std::string const& ckpt_dirname)
     ifs.close();
 }
 
+///////////////////////////
+// Functional Warming
+
+using Flexus::Core::Warming;
+
+namespace {
+
+typedef AbstractArray<BasicCacheState>::LookupResult_p LookupResult_p;
+
+// What the shared cache knows of a block held in aState
+Warming::eGrant
+grantOf(BasicCacheState const& aState)
+{
+    if (aState == BasicCacheState::Modified || aState == BasicCacheState::Owned) return Warming::kModified;
+    if (aState == BasicCacheState::Exclusive) return Warming::kExclusive;
+    if (aState == BasicCacheState::Shared) return Warming::kShared;
+    return Warming::kNone;
+}
+
+} // namespace
+
+bool
+BaseCacheControllerImpl::warmHit(uint64_t anAddress, Warming::eAccess anAccess)
+{
+    AbstractArray<BasicCacheState>& array = warmingArray();
+    LookupResult_p lookup                 = array[MemoryAddress(anAddress)];
+    if (!lookup->hit() || !lookup->state().isValid()) return false;
+
+    if (anAccess == Warming::kStore) {
+        if (lookup->state() != BasicCacheState::Modified && lookup->state() != BasicCacheState::Exclusive) {
+            return false;
+        }
+        lookup->setState(BasicCacheState::Modified);
+    }
+    array.recordAccess(lookup);
+    return true;
+}
+
+std::pair<Warming::eGrant, uint64_t>
+BaseCacheControllerImpl::warmFill(uint64_t anAddress, Warming::eGrant aGrant)
+{
+    AbstractArray<BasicCacheState>& array = warmingArray();
+    MemoryAddress address(anAddress);
+    LookupResult_p lookup = array[address];
+
+    std::pair<Warming::eGrant, uint64_t> victim(Warming::kNone, 0);
+    if (lookup->hit() && lookup->state().isValid()) {
+        array.recordAccess(lookup);
+    } else {
+        if (!array.canAllocate(lookup, address)) return victim;
+        LookupResult_p evictee = array.allocate(lookup, address);
+        victim                 = std::make_pair(grantOf(evictee->state()), uint64_t(evictee->blockAddress()));
+        // A writable block is only evicted with its data when it has to be
+        if (victim.first == Warming::kExclusive && !theInit->theWritableEvictsHaveData) {
+            victim.first = Warming::kShared;
+        }
+    }
+
+    switch (aGrant) {
+        case Warming::kModified: lookup->setState(BasicCacheState::Modified); break;
+        case Warming::kExclusive: lookup->setState(BasicCacheState::Exclusive); break;
+        default: lookup->setState(BasicCacheState::Shared); break;
+    }
+    return victim;
+}
+
+Warming::eGrant
+BaseCacheControllerImpl::warmInvalidate(uint64_t anAddress)
+{
+    AbstractArray<BasicCacheState>& array = warmingArray();
+    LookupResult_p lookup                 = array[MemoryAddress(anAddress)];
+    if (!lookup->hit()) return Warming::kNone;
+
+    Warming::eGrant held = grantOf(lookup->state());
+    lookup->setState(BasicCacheState::Invalid);
+    array.invalidateBlock(lookup);
+    return held;
+}
+
+Warming::eGrant
+BaseCacheControllerImpl::warmDowngrade(uint64_t anAddress)
+{
+    LookupResult_p lookup = warmingArray()[MemoryAddress(anAddress)];
+    if (!lookup->hit()) return Warming::kNone;
+
+    Warming::eGrant held = grantOf(lookup->state());
+    if (held != Warming::kNone) lookup->setState(BasicCacheState::Shared);
+    return held;
+}
+
 ///////////////////////////
 // Eviction Processing
 
@@ -16,6 +16,7 @@
 #include <core/stats.hpp>
 #include <core/target.hpp>
 #include <core/types.hpp>
+#include <core/warming.hpp>
 #include <list>
 
 namespace nCache {
@@ -182,7 +183,9 @@ namespace nCache {
 // It understands the cache protocol and does all the work.  It does NOT know
 // about transport object, just MemoryMessages and TransactionTrackers.  This
 // allows it to compile separately from the Flexus wiring.
-struct BaseCacheControllerImpl
+// As a Warming::PrivateCache it also updates its array in place while QEMU
+// fast-forwards.
+struct BaseCacheControllerImpl : public Flexus::Core::Warming::PrivateCache
 {
 
   protected:
@@ -354,6 +357,14 @@ struct BaseCacheControllerImpl
     virtual void loadState(std::string const& aDirName);
     virtual void load_from_ckpt(std::istream& is) = 0;
 
+    // Functional warming, straight on the array (see Warming)
+    virtual AbstractArray<BasicCacheState>& warmingArray() = 0;
+    virtual bool warmHit(uint64_t anAddress, Flexus::Core::Warming::eAccess anAccess);
+    virtual std::pair<Flexus::Core::Warming::eGrant, uint64_t> warmFill(uint64_t anAddress,
+                                                                         Flexus::Core::Warming::eGrant aGrant);
+    virtual Flexus::Core::Warming::eGrant warmInvalidate(uint64_t anAddress);
+    virtual Flexus::Core::Warming::eGrant warmDowngrade(uint64_t anAddress);
+
     virtual MemoryAddress getBlockAddress(MemoryAddress const& anAddress) const        = 0;
     virtual BlockOffset getBlockOffset(MemoryAddress const& anAddress) const           = 0;
     virtual std::function<bool(MemoryAddress a, MemoryAddress b)> setCompareFn() const = 0;
@@ -207,6 +207,12 @@ CacheController::loadState(std::string const& aDirName)
     theCacheControllerImpl->loadState(aDirName);
 }
 
+Flexus::Core::Warming::PrivateCache*
+CacheController::warming()
+{
+    return theCacheControllerImpl.get();
+}
+
 CacheController::CacheController(std::string const& aName,
                                  int32_t aCores,
                                  std::string const& anArrayConfiguration,
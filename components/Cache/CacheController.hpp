@@ -25,6 +25,7 @@
 using namespace boost::multi_index;
 #include <boost/none.hpp>
 #include <components/CommonQEMU/MessageQueues.hpp>
+#include <components/CommonQEMU/MissTable.hpp>
 #include <components/CommonQEMU/Slices/ExecuteState.hpp>
 #include <components/CommonQEMU/Transports/MemoryTransport.hpp>
 #include <list>
@@ -133,14 +134,7 @@ struct MafEntry
 class MissAddressFile
 {
     // MAF entries are indexed by their block address and state
-    struct by_state
-    {};
-
-    typedef multi_index_container<
-      MafEntry,
-      indexed_by<ordered_non_unique<composite_key<MafEntry,
-                                                  member<MafEntry, MemoryAddress, &MafEntry::theBlockAddress>,
-                                                  member<MafEntry, MafStates, &MafEntry::state>>>>>
+    typedef nMissTable::MissTable<MafEntry, MemoryAddress, MafStates, &MafEntry::theBlockAddress, &MafEntry::state>
       maf_t;
     maf_t theMshrs;
 
@@ -161,7 +155,8 @@ class MissAddressFile
     typedef maf_t::iterator maf_iter;
 
     MissAddressFile(std::string const& aStatName, uint32_t aSize, uint32_t aMaxTargetsPerRequest)
-      : theSize(aSize)
+      : theMshrs(aSize)
+      , theSize(aSize)
       , theMaxTargetsPerRequest(aMaxTargetsPerRequest)
       , theWaitResponseEntries(0)
       , theLastAccounting(0)
@@ -260,13 +255,12 @@ class MissAddressFile
     maf_iter allocPlaceholderEntry(MemoryAddress aBlockAddress, Transport& aTransport)
     {
         DBG_Assert(!full());
-        theMshrs.insert(MafEntry(aBlockAddress, aTransport, kWaitResponse, kRead));
+        maf_iter iter = theMshrs.insert(MafEntry(aBlockAddress, aTransport, kWaitResponse, kRead));
         ++theWaitResponseEntries;
         theMaxMAFMisses << theWaitResponseEntries;
         theMaxMAFTargets << theMshrs.size();
         account(kRead, 1);
 
-        maf_iter iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitResponse));
         modifyState(iter, kCompleted);
 
         return iter;
@@ -308,8 +302,7 @@ class MissAddressFile
     void modifyState(maf_iter iter, MafStates aState)
     {
         if (iter->state == kWaitResponse) { --theWaitResponseEntries; }
-        // theMshrs.modify(iter, [aState](auto& x){ return x.state = aState; });
-        theMshrs.modify(iter, ll::bind(&MafEntry::state, ll::_1) = aState);
+        theMshrs.setState(iter, aState);
         if (aState == kWaitResponse) {
             ++theWaitResponseEntries;
             theMaxMAFMisses << theWaitResponseEntries;
@@ -319,18 +312,18 @@ class MissAddressFile
     bool contains(const MemoryAddress& aBlockAddress) const
     {
         DBG_(VVerb, (<< "Searching MAF for block " << std::hex << aBlockAddress));
-        return theMshrs.count(std::make_tuple(aBlockAddress)) > 0;
+        return theMshrs.contains(aBlockAddress);
     }
 
     bool contains(const MemoryAddress& aBlockAddress, MafStates aState) const
     {
-        return theMshrs.count(std::make_tuple(aBlockAddress, aState)) > 0;
+        return theMshrs.contains(aBlockAddress, aState);
     }
 
     std::pair<boost::intrusive_ptr<MemoryMessage>, boost::intrusive_ptr<TransactionTracker>> getWaitingMAFEntry(
       const MemoryAddress& aBlockAddress)
     {
-        maf_t::iterator iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitResponse));
+        maf_iter iter = theMshrs.find(aBlockAddress, kWaitResponse);
         if (iter == theMshrs.end()) {
             DBG_(VVerb, (<< "Expected to find MAF entry for " << aBlockAddress << " but found none."));
             return std::make_pair(boost::intrusive_ptr<MemoryMessage>(0), boost::intrusive_ptr<TransactionTracker>(0));
@@ -341,17 +334,17 @@ class MissAddressFile
 
     maf_iter getWaitingMAFEntryIter(const MemoryAddress& aBlockAddress)
     {
-        return theMshrs.find(std::make_tuple(aBlockAddress, kWaitResponse));
+        return theMshrs.find(aBlockAddress, kWaitResponse);
     }
 
     maf_iter getProbingMAFEntry(const MemoryAddress& aBlockAddress)
     {
-        return theMshrs.find(std::make_tuple(aBlockAddress, kWaitProbe));
+        return theMshrs.find(aBlockAddress, kWaitProbe);
     }
 
     Transport getWaitingMAFEntryTransport(const MemoryAddress& aBlockAddress)
     {
-        maf_t::iterator iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitResponse));
+        maf_iter iter = theMshrs.find(aBlockAddress, kWaitResponse);
         DBG_Assert(iter != theMshrs.end());
         return iter->transport;
     }
@@ -359,7 +352,7 @@ class MissAddressFile
     Transport removeWaitingMafEntry(const MemoryAddress& aBlockAddress)
     {
         Transport ret_val;
-        maf_t::iterator iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitResponse));
+        maf_iter iter = theMshrs.find(aBlockAddress, kWaitResponse);
         DBG_Assert(iter != theMshrs.end());
         --theWaitResponseEntries;
         ret_val         = iter->transport;
@@ -369,22 +362,22 @@ class MissAddressFile
         return ret_val;
     }
 
-    maf_t::iterator getBlockedMafEntry(const MemoryAddress& aBlockAddress)
+    maf_iter getBlockedMafEntry(const MemoryAddress& aBlockAddress)
     {
         // Need to prioritize waiting MAFs WaitRegion -> WaitSnoop -> Wait Address
 
-        maf_t::iterator iter;
-        iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitRegion));
+        maf_iter iter;
+        iter = theMshrs.find(aBlockAddress, kWaitRegion);
         if (iter == theMshrs.end()) {
-            iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitSnoop));
+            iter = theMshrs.find(aBlockAddress, kWaitSnoop);
             if (iter != theMshrs.end()) {
                 modifyState(iter, kWaking);
             } else {
-                iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitEvict));
+                iter = theMshrs.find(aBlockAddress, kWaitEvict);
                 if (iter != theMshrs.end()) {
                     modifyState(iter, kWaking);
                 } else {
-                    iter = theMshrs.find(std::make_tuple(aBlockAddress, kWaitAddress));
+                    iter = theMshrs.find(aBlockAddress, kWaitAddress);
                 }
             }
         }
@@ -394,40 +387,30 @@ class MissAddressFile
     std::list<boost::intrusive_ptr<MemoryMessage>> getAllMessages(const MemoryAddress& aBlockAddress)
     {
         std::list<boost::intrusive_ptr<MemoryMessage>> ret_val;
-        maf_t::iterator iter, end;
-        std::tie(iter, end) = theMshrs.equal_range(std::make_tuple(aBlockAddress));
-        while (iter != end) {
-            ret_val.push_back(iter->transport[MemoryMessageTag]);
-            ++iter;
-        }
+        theMshrs.forEachInBlock(aBlockAddress,
+                                [&ret_val](maf_iter iter) { ret_val.push_back(iter->transport[MemoryMessageTag]); });
         return ret_val;
     }
 
     std::list<boost::intrusive_ptr<MemoryMessage>> getAllUncompletedMessages(const MemoryAddress& aBlockAddress)
     {
         std::list<boost::intrusive_ptr<MemoryMessage>> ret_val;
-        maf_t::iterator iter, end;
-        std::tie(iter, end) = theMshrs.equal_range(std::make_tuple(aBlockAddress));
-        while (iter != end) {
+        theMshrs.forEachInBlock(aBlockAddress, [&ret_val](maf_iter iter) {
             if (iter->state != kCompleted) { ret_val.push_back(iter->transport[MemoryMessageTag]); }
-            ++iter;
-        }
+        });
         return ret_val;
     }
 
     void dump(void)
     {
-        maf_t::iterator iter = theMshrs.begin();
-
         DBG_(VVerb,
              Set((CompName) << theName)(<< theName << " MAF content dump (" << theMshrs.size() << "/" << theSize));
 
-        while (iter != theMshrs.end()) {
+        theMshrs.forEach([this](maf_iter iter) {
             DBG_(VVerb,
                  Set((CompName) << theName)(<< "entry[" << iter->state << ":" << iter->type
                                             << "]: " << *iter->transport[MemoryMessageTag]));
-            iter++;
-        }
+        });
 
         DBG_(VVerb, Set((CompName) << theName)(<< theName << " MAF content finished"));
     }
@@ -674,7 +657,7 @@ operator<<(std::ostream& s, ProcessEntry& process);
 
 struct SnoopTransportEntry
 {
-    int32_t serial;
+    uint64_t serial;
     mutable Transport transport;
 
     SnoopTransportEntry(intrusive_ptr<ProcessEntry> process)
@@ -685,7 +668,7 @@ struct SnoopTransportEntry
 };
 
 typedef multi_index_container<SnoopTransportEntry,
-                              indexed_by<hashed_unique<member<SnoopTransportEntry, int, &SnoopTransportEntry::serial>>>>
+                              indexed_by<hashed_unique<member<SnoopTransportEntry, uint64_t, &SnoopTransportEntry::serial>>>>
   snoop_transport_hash_t;
 
 // Since the MessageQueues and the MissAddressFile contain
@@ -796,6 +779,8 @@ class CacheController
 
     void loadState(std::string const& aDirName);
 
+    Flexus::Core::Warming::PrivateCache* warming();
+
     CacheController(std::string const& aName,
                     int32_t aCores,
                     std::string const& anArrayConfiguration,
@@ -77,6 +77,7 @@ class FLEXUS_COMPONENT(Cache)
 
         auto cores = cfg.Cores ?: Flexus::Core::ComponentManager::getComponentManager().systemWidth();
 
+        Flexus::Core::ComponentArena::Scope tables(coreArena());
         theController.reset(new CacheController(statName(),
                                                 cores,
                                                 cfg.ArrayConfiguration,
@@ -106,6 +107,11 @@ class FLEXUS_COMPONENT(Cache)
 
         DBG_Assert(cfg.BusTime_Data > 0);
         DBG_Assert(cfg.BusTime_NoData > 0);
+
+        // The L1s are the private caches QEMU's references warm
+        if (cfg.CacheLevel == eL1 || cfg.CacheLevel == eL1I) {
+            Warming::attachPrivate(Warming::sharer(flexusIndex(), cfg.CacheLevel == eL1I), theController->warming());
+        }
     }
 
     void finalize() {}
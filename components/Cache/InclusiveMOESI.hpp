@@ -69,6 +69,8 @@ class InclusiveMOESI : public BaseCacheControllerImpl
   protected:
     virtual void load_from_ckpt(std::istream& is) { return theArray->load_from_ckpt(is, theNodeId); }
 
+    virtual AbstractArray<State>& warmingArray() { return *theArray; }
+
     virtual void setProtectedBlock(MemoryAddress addr, bool flag)
     {
         LookupResult_p lookup = (*theArray)[addr];
@@ -6,6 +6,7 @@
 #include "components/CommonQEMU/Util.hpp"
 #include "core/checkpoint/json.hpp"
 #include "core/debug/debug.hpp"
+#include "core/option_schema.hpp"
 #include "core/target.hpp"
 #include "core/types.hpp"
 
@@ -27,6 +28,27 @@ enum ReplacementPolicy
     REPLACEMENT_LRU,
 };
 
+// The options of a StdArray, "STD:size=<bytes>:assoc=<ways>:repl=lru"
+struct StdArrayOptions
+{
+    uint64_t size = 0;
+    int32_t assoc = 0;
+    std::string repl = "lru";
+
+    // The associativities the set lookup is compiled for
+    typedef Flexus::Core::Specializations<int32_t, 2, 4, 8, 16> assoc_specializations;
+
+    static Flexus::Core::OptionSchema<StdArrayOptions> const& schema()
+    {
+        static const Flexus::Core::OptionSchema<StdArrayOptions> theSchema =
+          Flexus::Core::OptionSchema<StdArrayOptions>("StdArray")
+            .option("size", &StdArrayOptions::size, "capacity in bytes")
+            .option("assoc|associativity", &StdArrayOptions::assoc, "ways per set", assoc_specializations())
+            .option("repl|replacement", &StdArrayOptions::repl, "replacement policy, lru");
+        return theSchema;
+    }
+};
+
 // This is a cache block.  The accessor functions are braindead simple.
 template<typename _State, const _State& _DefaultState>
 class Block
@@ -121,12 +143,20 @@ class Set
 
     LookupResult_p lookupBlock(const MemoryAddress anAddress)
     {
+        // The common associativities get loops of a known length
+        return StdArrayOptions::assoc_specializations::dispatch(
+          theAssociativity, [&](auto anAssoc) { return lookupIn<decltype(anAssoc)::value>(anAddress); });
+    }
+
+    // Assoc is the associativity, or 0 for theAssociativity
+    template<int32_t Assoc>
+    LookupResult_p lookupIn(const MemoryAddress anAddress)
+    {
+        const int32_t assoc = Assoc ? Assoc : theAssociativity;
         int32_t i, t = -1;
 
         // Linearly search through the set for the matching block
-        // This could be made faster for higher-associativity sets
-        // Through other search methods
-        for (i = 0; i < theAssociativity; i++) {
+        for (i = 0; i < assoc; i++) {
             if (theBlocks[i].tag() == anAddress) {
                 if (theBlocks[i].valid()) {
                     return LookupResult_p(new LookupResult(this, &(theBlocks[i]), anAddress, true));
@@ -354,31 +384,15 @@ class StdArray : public AbstractArray<_State>
 
   public:
     virtual ~StdArray() {}
-    StdArray(const int32_t aBlockSize, const std::list<std::pair<std::string, std::string>>& theConfiguration)
+    StdArray(const int32_t aBlockSize, StdArrayOptions const& anOptions)
     {
-        theBlockSize = aBlockSize;
-
-        std::list<std::pair<std::string, std::string>>::const_iterator iter = theConfiguration.begin();
-        for (; iter != theConfiguration.end(); iter++) {
-            if (strcasecmp(iter->first.c_str(), "size") == 0) {
-                theCacheSize = strtoull(iter->second.c_str(), nullptr, 0);
-            } else if (strcasecmp(iter->first.c_str(), "assoc") == 0 ||
-                       strcasecmp(iter->first.c_str(), "associativity") == 0) {
-                theAssociativity = strtol(iter->second.c_str(), nullptr, 0);
-            } else if (strcasecmp(iter->first.c_str(), "repl") == 0 ||
-                       strcasecmp(iter->first.c_str(), "replacement") == 0) {
-                if (strcasecmp(iter->second.c_str(), "lru") == 0) {
-                    theReplacementPolicy = REPLACEMENT_LRU;
-                } else {
-                    DBG_Assert(false, (<< "Invalid replacement policy type " << iter->second));
-                }
-            } else {
-                DBG_Assert(false,
-                           (<< "Unknown configuration parameter '" << iter->first
-                            << "' while creating StdArray. Valid params are: "
-                               "size,assoc,repl"));
-            }
-        }
+        theBlockSize     = aBlockSize;
+        theCacheSize     = anOptions.size;
+        theAssociativity = anOptions.assoc;
+
+        DBG_Assert(strcasecmp(anOptions.repl.c_str(), "lru") == 0,
+                   (<< "Invalid replacement policy type " << anOptions.repl));
+        theReplacementPolicy = REPLACEMENT_LRU;
 
         init();
     }
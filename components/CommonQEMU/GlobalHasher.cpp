@@ -1,5 +1,6 @@
 #include "GlobalHasher.hpp"
 
+#include <algorithm>
 #include <components/CommonQEMU/Util.hpp>
 #include <core/debug/debug.hpp>
 #include <core/stats.hpp>
@@ -23,79 +24,111 @@ namespace nGlobalHasher {
 
 GlobalHasher::GlobalHasher() {}
 
-std::set<int>
-GlobalHasher::hashAddr(const Address& addr)
+void
+CompiledHash::buildTable(int32_t aTableBits)
 {
-    std::set<int> ret;
-    hash_iterator_t hash = theHashList.begin();
-    for (; hash != theHashList.end(); hash++) {
-        ret.insert((*hash)(addr));
+    uint64_t used = 0;
+    for (int32_t j = 0; j < theBits; ++j) {
+        used |= theMasks[j];
+    }
+    if (theKind != kLinear || used == 0 || aTableBits <= 0) return;
+
+    int32_t top      = 63 - __builtin_clzll(used);
+    theTableShift    = std::max(0, top + 1 - aTableBits);
+    int32_t bits     = top - theTableShift + 1;
+    uint64_t covered = ((1ULL << bits) - 1) << theTableShift;
+
+    theTable.resize(1ULL << bits);
+    for (uint64_t v = 0; v < theTable.size(); ++v) {
+        uint64_t addr = v << theTableShift;
+        uint32_t out  = 0;
+        for (int32_t j = 0; j < theBits; ++j) {
+            out |= static_cast<uint32_t>(__builtin_popcountll(addr & theMasks[j]) & 1) << j;
+        }
+        theTable[v] = out;
+    }
+    for (int32_t j = 0; j < theBits; ++j) {
+        theMasks[j] &= ~covered;
     }
-    return ret;
 }
 
-int32_t
-GlobalHasher::simple_hash(int32_t offset, const Address& addr) const
+CompiledHash
+GlobalHasher::linearHash(int32_t offset) const
 {
-    return ((addr >> theHashShift) & theHashMask) + offset;
+    CompiledHash ret;
+    ret.theKind       = CompiledHash::kLinear;
+    ret.theOffset     = offset;
+    ret.theBits       = log_base2(theHashMask) + 1;
+    ret.thePrime      = 0;
+    ret.theTableShift = 0;
+    for (int32_t j = 0; j < kMaxHashBits; ++j) {
+        ret.theMasks[j] = 0;
+    }
+    return ret;
 }
 
-int32_t
-GlobalHasher::xor_hash(int32_t offset, int32_t xor_shift, const Address& addr) const
+// Sets output bit j of aHash to address bit aBit, for the bits in the mask
+static void
+addInput(CompiledHash& aHash, int32_t aMask, int32_t j, int32_t aBit)
 {
-    //  int32_t ret = (((addr >> theHashShift) ^ (addr >> xor_shift)) &
-    //  theHashMask) + offset;
-    return (((addr >> theHashShift) ^ (addr >> xor_shift)) & theHashMask) + offset;
+    if (((aMask >> j) & 1) && aBit >= 0 && aBit < 64) { aHash.theMasks[j] ^= 1ULL << aBit; }
 }
 
-int32_t
-GlobalHasher::shift_hash(int32_t offset, int32_t shift, const Address& addr) const
+CompiledHash
+GlobalHasher::simpleHash(int32_t offset) const
 {
-    return ((addr >> (theHashShift + shift)) & theHashMask) + offset;
+    // ((addr >> theHashShift) & theHashMask) + offset
+    CompiledHash ret = linearHash(offset);
+    for (int32_t j = 0; j < ret.theBits; ++j) {
+        addInput(ret, theHashMask, j, theHashShift + j);
+    }
+    return ret;
 }
 
-int32_t
-GlobalHasher::full_prime_hash(int32_t offset, int32_t prime, const Address& addr) const
+CompiledHash
+GlobalHasher::xorHash(int32_t offset, int32_t xor_shift) const
 {
-    return (addr % prime) + offset;
+    // (((addr >> theHashShift) ^ (addr >> xor_shift)) & theHashMask) + offset
+    CompiledHash ret = linearHash(offset);
+    for (int32_t j = 0; j < ret.theBits; ++j) {
+        addInput(ret, theHashMask, j, theHashShift + j);
+        addInput(ret, theHashMask, j, xor_shift + j);
+    }
+    return ret;
 }
 
-struct MatrixHash
+CompiledHash
+GlobalHasher::shiftHash(int32_t offset, int32_t shift) const
 {
-  public:
-    MatrixHash(const std::list<int>& matrix, int32_t shift, int32_t mask, int32_t offset)
-      : theMatrix(matrix)
-      , theHashShift(shift)
-      , theHashMask(mask)
-      , theOffset(offset)
-    {
-    }
-    int32_t operator()(uint64_t addr)
-    {
-        addr >>= theHashShift;
-        int32_t ret                 = 0;
-        std::list<int>::iterator it = theMatrix.begin();
-        for (; it != theMatrix.end(); it++, addr >>= 1) {
-            if ((addr & 1) != 0) { ret ^= *it; }
-        }
-        return (ret & theHashMask) + theOffset;
+    // ((addr >> (theHashShift + shift)) & theHashMask) + offset
+    CompiledHash ret = linearHash(offset);
+    for (int32_t j = 0; j < ret.theBits; ++j) {
+        addInput(ret, theHashMask, j, theHashShift + shift + j);
     }
+    return ret;
+}
 
-  private:
-    std::list<int> theMatrix;
-    int32_t theHashShift;
-    int32_t theHashMask;
-    int theOffset;
-};
+CompiledHash
+GlobalHasher::fullPrimeHash(int32_t offset, int32_t prime) const
+{
+    // (addr % prime) + offset
+    CompiledHash ret = linearHash(offset);
+    ret.theKind      = CompiledHash::kPrime;
+    ret.thePrime     = prime;
+    return ret;
+}
 
-std::function<int(int)>
-GlobalHasher::createMatrixHash(std::string args, int32_t num_buckets, int32_t shift, int32_t mask, int32_t offset) const
+// Row i of the matrix is XORed into the result when address bit
+// (theHashShift + i) is set, so output bit j folds in every such address
+// bit whose row has bit j set.
+CompiledHash
+GlobalHasher::matrixHash(std::string args, int32_t num_buckets, int32_t offset) const
 {
-    std::list<int> matrix;
+    std::vector<int> matrix;
     if (strncasecmp(args.c_str(), "random", 6) == 0) {
         uint32_t seed = boost::lexical_cast<uint32_t>(args.substr(7));
         std::srand(seed);
-        int32_t n  = 32 - shift;
+        int32_t n  = 32 - theHashShift;
         double max = num_buckets;
         // Generate a list of n numbers with theHashBits bits
         for (int32_t i = 0; i < n; i++) {
@@ -121,14 +154,63 @@ GlobalHasher::createMatrixHash(std::string args, int32_t num_buckets, int32_t sh
         DBG_Assert(false, (<< "Unknown Matrix Hash Type '" << args << "'"));
     }
 
-    return MatrixHash(matrix, shift, mask, offset);
+    CompiledHash ret = linearHash(offset);
+    for (int32_t i = 0; i < static_cast<int32_t>(matrix.size()); ++i) {
+        for (int32_t j = 0; j < ret.theBits; ++j) {
+            if ((static_cast<uint32_t>(matrix[i]) >> j) & 1) { addInput(ret, theHashMask, j, theHashShift + i); }
+        }
+    }
+    return ret;
+}
+
+void
+GlobalHasher::validate() const
+{
+    // Block-granular strides as well as scattered addresses
+    static const int32_t kSamples = 1 << 16;
+    int32_t buckets               = theHashMask + 1;
+
+    for (int32_t h = 0; h < static_cast<int32_t>(theHashes.size()); ++h) {
+        CompiledHash const& hash = theHashes[h];
+        int32_t range            = (hash.theKind == CompiledHash::kPrime) ? hash.thePrime : buckets;
+        std::vector<int64_t> counts(range, 0);
+
+        uint64_t random = 0x9E3779B97F4A7C15ULL;
+        for (int32_t i = 0; i < kSamples; ++i) {
+            uint64_t addr;
+            if (i & 1) {
+                random ^= random << 13;
+                random ^= random >> 7;
+                random ^= random << 17;
+                addr = random & ((1ULL << 40) - 1);
+            } else {
+                addr = static_cast<uint64_t>(i / 2) << theHashShift;
+            }
+            int32_t bank = hash(addr) - hash.theOffset;
+            if (bank >= 0 && bank < range) ++counts[bank];
+        }
+
+        int64_t max = *std::max_element(counts.begin(), counts.end());
+        int64_t min = *std::min_element(counts.begin(), counts.end());
+        double mean = static_cast<double>(kSamples) / range;
+        if (min == 0 || max > 2 * mean) {
+            DBG_(Crit,
+                 (<< "GlobalHasher: hash " << h << " is unbalanced over " << range << " banks: " << min
+                  << " to " << max << " of " << kSamples << " synthetic addresses per bank (mean " << mean << ")"));
+        } else {
+            DBG_(Dev,
+                 (<< "GlobalHasher: hash " << h << " spreads " << kSamples << " synthetic addresses over " << range
+                  << " banks, " << min << " to " << max << " per bank"));
+        }
+    }
 }
 
 void
 GlobalHasher::initialize(std::list<std::string>& hash_configs,
                          int32_t initial_shift,
                          int32_t buckets_per_hash,
-                         bool partitioned)
+                         bool partitioned,
+                         int32_t aTableBits)
 {
     if (!has_been_initialized) {
         int32_t first_bucket = 0;
@@ -136,46 +218,43 @@ GlobalHasher::initialize(std::list<std::string>& hash_configs,
 
         theHashShift = initial_shift;
         theHashMask  = (buckets_per_hash - 1);
+        DBG_Assert(log_base2(theHashMask) < kMaxHashBits);
+        DBG_Assert(aTableBits <= kMaxTableBits);
 
         std::list<std::string>::iterator cfg = hash_configs.begin();
         for (; cfg != hash_configs.end(); cfg++, first_bucket += offset) {
             if (strcasecmp(cfg->c_str(), "simple") == 0) {
-                theHashList.push_back([this, first_bucket](const Address& x) {
-                    return this->simple_hash(first_bucket, x);
-                }); // std::bind(&GlobalHasher::simple_hash, this, first_bucket, _1));
+                theHashes.push_back(simpleHash(first_bucket));
                 DBG_(Dev, (<< "Added simple hash function to global hasher."));
             } else if (strncasecmp(cfg->c_str(), "xor", 3) == 0) {
                 int32_t xor_shift = boost::lexical_cast<int>(cfg->substr(4));
-                theHashList.push_back([this, first_bucket, xor_shift](const Address& x) {
-                    return this->xor_hash(first_bucket, xor_shift, x);
-                }); // std::bind(&GlobalHasher::xor_hash, this, first_bucket,
-                    // xor_shift, _1));
+                theHashes.push_back(xorHash(first_bucket, xor_shift));
                 DBG_(Dev,
                      (<< "Added XOR hash function to global hasher. XOR Shift = " << xor_shift
                       << ", first = " << first_bucket));
             } else if (strncasecmp(cfg->c_str(), "shift", 5) == 0) {
                 int32_t shift = boost::lexical_cast<int>(cfg->substr(6));
-                theHashList.push_back([this, first_bucket, shift](const Address& x) {
-                    return this->shift_hash(first_bucket, shift, x);
-                }); // std::bind(&GlobalHasher::shift_hash, this, first_bucket, shift,
-                    // _1));
+                theHashes.push_back(shiftHash(first_bucket, shift));
                 DBG_(Dev, (<< "Added Shift hash function to global hasher. Shift = " << shift));
             } else if (strncasecmp(cfg->c_str(), "matrix", 6) == 0) {
-                theHashList.push_back(
-                  createMatrixHash(cfg->substr(7), buckets_per_hash, theHashShift, theHashMask, first_bucket));
+                theHashes.push_back(matrixHash(cfg->substr(7), buckets_per_hash, first_bucket));
                 DBG_(Dev, (<< "Added Matrix hash function to global hasher. Args = " << cfg->substr(7)));
             } else if (strcasecmp(cfg->c_str(), "full_prime") == 0) {
                 int32_t closest_prime = nCommonUtil::get_closest_prime(buckets_per_hash);
-                theHashList.push_back([this, closest_prime, first_bucket](const Address& x) {
-                    return this->shift_hash(closest_prime, first_bucket, x);
-                }); // std::bind(&GlobalHasher::shift_hash, this, closest_prime,
-                    // first_bucket, _1));
+                theHashes.push_back(fullPrimeHash(first_bucket, closest_prime));
                 DBG_(Dev,
                      (<< "Added Full Prime hash function to global hasher. "
                          "Closest prime = "
                       << closest_prime));
+            } else {
+                continue;
             }
+            theHashes.back().buildTable(aTableBits);
         }
+        DBG_Assert(theHashes.size() <= static_cast<size_t>(kMaxHashes),
+                   (<< "GlobalHasher supports at most " << kMaxHashes << " hash functions"));
+        theNumBanks = partitioned ? first_bucket : buckets_per_hash;
+        validate();
         has_been_initialized = true;
     }
 }
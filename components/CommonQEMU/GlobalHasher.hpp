@@ -4,52 +4,145 @@
 #include "core/types.hpp"
 
 #include <cstdint>
-#include <functional>
 #include <list>
-#include <set>
+#include <string>
+#include <vector>
 
 namespace nGlobalHasher {
 
 typedef Flexus::SharedTypes::PhysicalMemoryAddress Address;
 
+static const int32_t kMaxHashes    = 16;
+static const int32_t kMaxHashBits  = 32;
+static const int32_t kMaxTableBits = 16;
+
+// The banks an address maps to, at most one per hash function. Kept inline
+// and sorted so that hashing an address allocates nothing.
+class BankSet
+{
+    int32_t theBanks[kMaxHashes];
+    int32_t theSize;
+
+  public:
+    typedef int32_t const* const_iterator;
+
+    BankSet()
+      : theSize(0)
+    {
+    }
+
+    void insert(int32_t aBank)
+    {
+        int32_t i = theSize;
+        while (i > 0 && theBanks[i - 1] > aBank) {
+            --i;
+        }
+        if (i > 0 && theBanks[i - 1] == aBank) return;
+        for (int32_t j = theSize; j > i; --j) {
+            theBanks[j] = theBanks[j - 1];
+        }
+        theBanks[i] = aBank;
+        ++theSize;
+    }
+
+    int32_t size() const { return theSize; }
+    bool empty() const { return theSize == 0; }
+    bool count(int32_t aBank) const
+    {
+        for (int32_t i = 0; i < theSize; ++i) {
+            if (theBanks[i] == aBank) return true;
+        }
+        return false;
+    }
+    const_iterator begin() const { return theBanks; }
+    const_iterator end() const { return theBanks + theSize; }
+};
+
+// One hash function, compiled from its configuration string.
+//
+// simple, shift, xor and matrix hashes are linear over GF(2): output bit j
+// is the parity of the address bits in theMasks[j]. full_prime is the only
+// other kind. A linear hash may also look the contribution of its top input
+// bits up in a table, leaving fewer bits to the masks.
+struct CompiledHash
+{
+    enum eKind
+    {
+        kLinear,
+        kPrime
+    };
+
+    eKind theKind;
+    int32_t theOffset;
+    int32_t theBits;
+    uint64_t theMasks[kMaxHashBits];
+    uint64_t thePrime;
+
+    std::vector<uint32_t> theTable;
+    int32_t theTableShift;
+
+    int32_t operator()(uint64_t anAddress) const
+    {
+        if (theKind == kPrime) return static_cast<int32_t>(anAddress % thePrime) + theOffset;
+
+        uint32_t ret = 0;
+        if (!theTable.empty()) { ret = theTable[(anAddress >> theTableShift) & (theTable.size() - 1)]; }
+        for (int32_t j = 0; j < theBits; ++j) {
+            ret ^= static_cast<uint32_t>(__builtin_popcountll(anAddress & theMasks[j]) & 1) << j;
+        }
+        return static_cast<int32_t>(ret) + theOffset;
+    }
+
+    // Moves the top aTableBits input bits of the masks into theTable
+    void buildTable(int32_t aTableBits);
+};
+
 class GlobalHasher
 {
   private:
-    typedef std::function<int(const Address&)> hash_fn_t;
-    typedef std::list<hash_fn_t>::iterator hash_iterator_t;
-
     GlobalHasher();
 
     int32_t theHashShift;
     int32_t theHashMask;
+    int32_t theNumBanks;
 
-    std::list<hash_fn_t> theHashList;
+    std::vector<CompiledHash> theHashes;
 
     bool has_been_initialized;
 
-    int32_t simple_hash(int32_t offset, const Address& addr) const;
-    int32_t xor_hash(int32_t offset, int32_t xor_shift, const Address& addr) const;
-    int32_t shift_hash(int32_t offset, int32_t shift, const Address& addr) const;
-    int32_t full_prime_hash(int32_t offset, int32_t prime, const Address& addr) const;
+    CompiledHash linearHash(int32_t offset) const;
+    CompiledHash simpleHash(int32_t offset) const;
+    CompiledHash xorHash(int32_t offset, int32_t xor_shift) const;
+    CompiledHash shiftHash(int32_t offset, int32_t shift) const;
+    CompiledHash fullPrimeHash(int32_t offset, int32_t prime) const;
+    CompiledHash matrixHash(std::string args, int32_t num_buckets, int32_t offset) const;
 
-    std::function<int(int)> createMatrixHash(std::string args,
-                                             int32_t num_buckets,
-                                             int32_t shift,
-                                             int32_t mask,
-                                             int32_t offset) const;
+    // Warns when a synthetic address stream spreads unevenly over the banks
+    void validate() const;
 
   public:
-    std::set<int> hashAddr(const Address& addr);
-
+    BankSet hashAddr(const Address& addr) const
+    {
+        BankSet ret;
+        for (auto const& hash : theHashes) {
+            ret.insert(hash(static_cast<uint64_t>(addr)));
+        }
+        return ret;
+    }
+
+    // aTableBits > 0 looks the top aTableBits input bits of each linear hash
+    // up in a table instead of folding them with the masks
     void initialize(std::list<std::string>& hash_configs,
                     int32_t initial_shift,
                     int32_t buckets_per_hash,
-                    bool partitioned);
+                    bool partitioned,
+                    int32_t aTableBits = 0);
 
-    int32_t numHashes() { return theHashList.size(); }
+    int32_t numHashes() { return theHashes.size(); }
+    int32_t numBanks() { return theNumBanks; }
 
     static GlobalHasher& theHasher();
 };
 }; // namespace nGlobalHasher
 
-#endif // ! _GLOBAL_HASHER_HPP_
\ No newline at end of file
+#endif // ! _GLOBAL_HASHER_HPP_
@@ -0,0 +1,354 @@
+#ifndef FLEXUS_COMMON_MISS_TABLE_HPP_INCLUDED
+#define FLEXUS_COMMON_MISS_TABLE_HPP_INCLUDED
+
+#include <core/debug/debug.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace nMissTable {
+
+// The entry storage of a miss address file.
+//
+// Entries live in a pool sized once from the MAF size. An open-addressed
+// index maps a block address to the chain of that block's entries, kept in
+// insertion order, together with a bitmask of the states they are in. A
+// lookup by (address, state) therefore hashes once and walks only the few
+// entries of one block, and nothing is allocated on the miss path.
+//
+// Entry keeps its own block address and state in AddressMember and
+// StateMember; the table writes the state through setState(). States must be
+// enumerators below 32.
+template<class Entry, class Address, class State, Address Entry::*AddressMember, State Entry::*StateMember>
+class MissTable
+{
+    static const int32_t kNone      = -1;
+    static const uint32_t kMaxState = 32;
+
+    struct Slot
+    {
+        std::optional<Entry> theEntry;
+        int32_t theNextInBlock; // also links the free slots
+        int32_t theOlder;
+        int32_t theNewer;
+    };
+
+    struct Bucket
+    {
+        Address theAddress;
+        int32_t theHead; // kNone when the bucket is empty
+        uint32_t theStates;
+    };
+
+    std::vector<Slot> theSlots;
+    std::vector<Bucket> theBuckets;
+    uint32_t theBucketShift;
+    int32_t theFree;
+    int32_t theOldest;
+    int32_t theNewest;
+    uint32_t theSize;
+    uint32_t theStateCount[kMaxState];
+
+  public:
+    // Walks the entries of one block that are in one state, in insertion
+    // order. A default constructed iterator is end().
+    class iterator
+    {
+        MissTable* theTable;
+        int32_t theSlot;
+
+        friend class MissTable;
+        iterator(MissTable* aTable, int32_t aSlot)
+          : theTable(aTable)
+          , theSlot(aSlot)
+        {
+        }
+
+      public:
+        iterator()
+          : theTable(nullptr)
+          , theSlot(kNone)
+        {
+        }
+
+        Entry const& operator*() const { return *theTable->theSlots[theSlot].theEntry; }
+        Entry const* operator->() const { return &*theTable->theSlots[theSlot].theEntry; }
+
+        iterator& operator++()
+        {
+            State state = (**this).*StateMember;
+            do {
+                theSlot = theTable->theSlots[theSlot].theNextInBlock;
+            } while (theSlot != kNone && (**this).*StateMember != state);
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator ret_val(*this);
+            ++*this;
+            return ret_val;
+        }
+
+        bool operator==(iterator const& other) const { return theSlot == other.theSlot; }
+        bool operator!=(iterator const& other) const { return theSlot != other.theSlot; }
+    };
+
+    MissTable(uint32_t aCapacity)
+      : theOldest(kNone)
+      , theNewest(kNone)
+      , theSize(0)
+    {
+        for (uint32_t i = 0; i < kMaxState; ++i) {
+            theStateCount[i] = 0;
+        }
+        grow(aCapacity > 0 ? aCapacity : 1);
+    }
+
+    uint32_t size() const { return theSize; }
+    bool empty() const { return theSize == 0; }
+    uint32_t count(State aState) const { return theStateCount[aState]; }
+
+    iterator end() const { return iterator(); }
+
+    iterator insert(Entry const& anEntry)
+    {
+        if (theFree == kNone) {
+            // Controllers bound their MAF through reservations; one that
+            // overcommits still works, at the cost of a rehash.
+            DBG_(Dev, (<< "MissTable over its capacity of " << theSlots.size() << ", growing"));
+            grow(theSlots.size() * 2);
+        }
+
+        int32_t slot = theFree;
+        Slot& s      = theSlots[slot];
+        theFree      = s.theNextInBlock;
+        s.theEntry.emplace(anEntry);
+        s.theNextInBlock = kNone;
+        s.theOlder       = theNewest;
+        s.theNewer       = kNone;
+        if (theNewest != kNone) {
+            theSlots[theNewest].theNewer = slot;
+        } else {
+            theOldest = slot;
+        }
+        theNewest = slot;
+
+        State state = anEntry.*StateMember;
+        DBG_Assert(static_cast<uint32_t>(state) < kMaxState);
+        Bucket& b = theBuckets[bucketFor(anEntry.*AddressMember)];
+        if (b.theHead == kNone) {
+            b.theAddress = anEntry.*AddressMember;
+            b.theHead    = slot;
+            b.theStates  = 0;
+        } else {
+            int32_t tail = b.theHead;
+            while (theSlots[tail].theNextInBlock != kNone) {
+                tail = theSlots[tail].theNextInBlock;
+            }
+            theSlots[tail].theNextInBlock = slot;
+        }
+        b.theStates |= 1U << state;
+        ++theStateCount[state];
+        ++theSize;
+        return iterator(this, slot);
+    }
+
+    void erase(iterator anEntry)
+    {
+        int32_t slot = anEntry.theSlot;
+        Slot& s      = theSlots[slot];
+        DBG_Assert(s.theEntry);
+
+        uint32_t bucket = bucketFor((*s.theEntry).*AddressMember);
+        Bucket& b       = theBuckets[bucket];
+        if (b.theHead == slot) {
+            b.theHead = s.theNextInBlock;
+        } else {
+            int32_t prev = b.theHead;
+            while (theSlots[prev].theNextInBlock != slot) {
+                prev = theSlots[prev].theNextInBlock;
+            }
+            theSlots[prev].theNextInBlock = s.theNextInBlock;
+        }
+
+        if (s.theOlder != kNone) {
+            theSlots[s.theOlder].theNewer = s.theNewer;
+        } else {
+            theOldest = s.theNewer;
+        }
+        if (s.theNewer != kNone) {
+            theSlots[s.theNewer].theOlder = s.theOlder;
+        } else {
+            theNewest = s.theOlder;
+        }
+
+        --theStateCount[(*s.theEntry).*StateMember];
+        --theSize;
+        s.theEntry.reset();
+        s.theNextInBlock = theFree;
+        theFree          = slot;
+
+        if (b.theHead == kNone) {
+            removeBucket(bucket);
+        } else {
+            recomputeStates(b);
+        }
+    }
+
+    void setState(iterator anEntry, State aState)
+    {
+        DBG_Assert(static_cast<uint32_t>(aState) < kMaxState);
+        Entry& entry = *theSlots[anEntry.theSlot].theEntry;
+        --theStateCount[entry.*StateMember];
+        ++theStateCount[aState];
+        entry.*StateMember = aState;
+        recomputeStates(theBuckets[bucketFor(entry.*AddressMember)]);
+    }
+
+    // Non-key members of an entry are modified in place
+    Entry& modify(iterator anEntry) { return *theSlots[anEntry.theSlot].theEntry; }
+
+    // The entry of the block in the lowest state, as an index ordered by
+    // (address, state) would return
+    iterator find(Address const& anAddress)
+    {
+        Bucket const* b = lookup(anAddress);
+        if (!b) return end();
+        int32_t best = b->theHead;
+        for (int32_t i = theSlots[best].theNextInBlock; i != kNone; i = theSlots[i].theNextInBlock) {
+            if ((*theSlots[i].theEntry).*StateMember < (*theSlots[best].theEntry).*StateMember) best = i;
+        }
+        return iterator(this, best);
+    }
+
+    // The oldest entry of the block in aState; ++ walks the others
+    iterator find(Address const& anAddress, State aState)
+    {
+        Bucket const* b = lookup(anAddress);
+        if (!b || !(b->theStates & (1U << aState))) return end();
+        int32_t i = b->theHead;
+        while ((*theSlots[i].theEntry).*StateMember != aState) {
+            i = theSlots[i].theNextInBlock;
+        }
+        return iterator(this, i);
+    }
+
+    bool contains(Address const& anAddress) const { return lookup(anAddress) != nullptr; }
+
+    bool contains(Address const& anAddress, State aState) const
+    {
+        Bucket const* b = lookup(anAddress);
+        return b && (b->theStates & (1U << aState));
+    }
+
+    // Calls aFunc with every entry of the block, in insertion order
+    template<class Func>
+    void forEachInBlock(Address const& anAddress, Func aFunc)
+    {
+        Bucket const* b = lookup(anAddress);
+        if (!b) return;
+        for (int32_t i = b->theHead, next; i != kNone; i = next) {
+            next = theSlots[i].theNextInBlock;
+            aFunc(iterator(this, i));
+        }
+    }
+
+    // Calls aFunc with every entry, oldest first. aFunc may change the
+    // entry's state but must not insert or erase.
+    template<class Func>
+    void forEach(Func aFunc)
+    {
+        for (int32_t i = theOldest; i != kNone; i = theSlots[i].theNewer) {
+            aFunc(iterator(this, i));
+        }
+    }
+
+    // The oldest entry in aState, or end()
+    iterator oldest(State aState)
+    {
+        if (theStateCount[aState] == 0) return end();
+        int32_t i = theOldest;
+        while ((*theSlots[i].theEntry).*StateMember != aState) {
+            i = theSlots[i].theNewer;
+        }
+        return iterator(this, i);
+    }
+
+  private:
+    uint32_t hash(Address const& anAddress) const
+    {
+        return (static_cast<uint64_t>(anAddress) * 0x9E3779B97F4A7C15ULL) >> theBucketShift;
+    }
+
+    uint32_t bucketFor(Address const& anAddress) const
+    {
+        uint32_t mask = theBuckets.size() - 1;
+        uint32_t i    = hash(anAddress);
+        while (theBuckets[i].theHead != kNone && !(theBuckets[i].theAddress == anAddress)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    Bucket const* lookup(Address const& anAddress) const
+    {
+        Bucket const& b = theBuckets[bucketFor(anAddress)];
+        return b.theHead == kNone ? nullptr : &b;
+    }
+
+    void recomputeStates(Bucket& aBucket)
+    {
+        aBucket.theStates = 0;
+        for (int32_t i = aBucket.theHead; i != kNone; i = theSlots[i].theNextInBlock) {
+            aBucket.theStates |= 1U << (*theSlots[i].theEntry).*StateMember;
+        }
+    }
+
+    // Backward-shift deletion keeps every bucket reachable from its home
+    // without tombstones
+    void removeBucket(uint32_t aBucket)
+    {
+        uint32_t mask = theBuckets.size() - 1;
+        uint32_t hole = aBucket;
+        for (uint32_t i = (hole + 1) & mask; theBuckets[i].theHead != kNone; i = (i + 1) & mask) {
+            uint32_t home = hash(theBuckets[i].theAddress);
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                theBuckets[hole] = theBuckets[i];
+                hole             = i;
+            }
+        }
+        theBuckets[hole].theHead = kNone;
+    }
+
+    void grow(uint32_t aCapacity)
+    {
+        uint32_t old_capacity = theSlots.size();
+        theSlots.resize(aCapacity);
+        theFree = kNone;
+        for (int32_t i = aCapacity - 1; i >= static_cast<int32_t>(old_capacity); --i) {
+            theSlots[i].theNextInBlock = theFree;
+            theFree                    = i;
+        }
+
+        // At most half the buckets are in use
+        uint32_t buckets = 2;
+        theBucketShift   = 63;
+        while (buckets < 2 * aCapacity) {
+            buckets <<= 1;
+            --theBucketShift;
+        }
+        std::vector<Bucket> old_buckets;
+        old_buckets.swap(theBuckets);
+        theBuckets.resize(buckets);
+        for (auto& b : theBuckets) {
+            b.theHead = kNone;
+        }
+        for (auto& b : old_buckets) {
+            if (b.theHead != kNone) theBuckets[bucketFor(b.theAddress)] = b;
+        }
+    }
+};
+
+} // namespace nMissTable
+
+#endif // FLEXUS_COMMON_MISS_TABLE_HPP_INCLUDED
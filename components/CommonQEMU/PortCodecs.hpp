@@ -0,0 +1,273 @@
+#ifndef FLEXUS_COMMON_PORT_CODECS_HPP_INCLUDED
+#define FLEXUS_COMMON_PORT_CODECS_HPP_INCLUDED
+
+#include <components/CommonQEMU/Translation.hpp>
+#include <components/CommonQEMU/Transports/MemoryTransport.hpp>
+#include <components/uFetch/uFetchTypes.hpp>
+#include <core/port_recorder.hpp>
+
+/*
+ * Encodings of the payloads that port recordings (core/port_recorder.hpp)
+ * capture. Only the simulated state is kept: pointers into the rest of the
+ * simulator (instructions, branch predictor state) are dropped, and
+ * transaction trackers are recreated empty on replay.
+ */
+
+namespace Flexus {
+namespace Core {
+
+using Flexus::SharedTypes::DestinationMessage;
+using Flexus::SharedTypes::FetchBundle;
+using Flexus::SharedTypes::FetchedOpcode;
+using Flexus::SharedTypes::MemoryMessage;
+using Flexus::SharedTypes::MemoryTransport;
+using Flexus::SharedTypes::NetworkMessage;
+using Flexus::SharedTypes::pFetchBundle;
+using Flexus::SharedTypes::PhysicalMemoryAddress;
+using Flexus::SharedTypes::tFillLevel;
+using Flexus::SharedTypes::TransactionTracker;
+using Flexus::SharedTypes::Translation;
+using Flexus::SharedTypes::TranslationPtr;
+using Flexus::SharedTypes::VirtualMemoryAddress;
+
+template<>
+struct port_codec<MemoryTransport>
+{
+    static const bool recordable = true;
+    static char const* name() { return "MemoryTransport"; }
+
+    enum eSlices
+    {
+        kMemoryMessage      = 1,
+        kDestination        = 2,
+        kNetworkMessage     = 4,
+        kTransactionTracker = 8
+    };
+
+    static void write(PortWriter& out, MemoryTransport& aTransport)
+    {
+        boost::intrusive_ptr<MemoryMessage> msg       = aTransport[Flexus::SharedTypes::MemoryMessageTag];
+        boost::intrusive_ptr<DestinationMessage> dest = aTransport[Flexus::SharedTypes::DestinationTag];
+        boost::intrusive_ptr<NetworkMessage> net      = aTransport[Flexus::SharedTypes::NetworkMessageTag];
+        bool tracker = aTransport[Flexus::SharedTypes::TransactionTrackerTag] != nullptr;
+
+        out.put<uint8_t>((msg ? kMemoryMessage : 0) | (dest ? kDestination : 0) | (net ? kNetworkMessage : 0) |
+                         (tracker ? kTransactionTracker : 0));
+        if (msg) {
+            out.put<uint32_t>(msg->type());
+            out.put<uint64_t>(msg->address());
+            out.put<uint64_t>(msg->pc());
+            out.put<uint64_t>(uint64_t(msg->data()));
+            out.put<uint64_t>(uint64_t(msg->data() >> 64));
+            out.put<int32_t>(msg->reqSize());
+            out.put<int32_t>(msg->coreIdx());
+            out.put<int32_t>(msg->tl());
+            out.put<uint32_t>(msg->fillLevel());
+            out.put<uint32_t>(msg->fillType());
+            out.put<int32_t>(msg->outstandingMsgs());
+            out.put<uint32_t>(msg->branchType());
+            out.put<uint8_t>(msg->isPriv() | msg->isDstream() << 1 | msg->ackRequired() << 2 |
+                             msg->ackRequiresData() << 3 | msg->evictHasData() << 4 | msg->branchAnnul() << 5 |
+                             msg->isPageWalk() << 6 | msg->anyInvs() << 7);
+        }
+        if (dest) {
+            out.put<uint32_t>(dest->type);
+            out.put<int32_t>(dest->requester);
+            out.put<int32_t>(dest->directory);
+            out.put<int32_t>(dest->remote_directory);
+            out.put<int32_t>(dest->source);
+            out.put<int32_t>(dest->memory);
+            out.put<int32_t>(dest->other);
+            out.put<uint8_t>(dest->to_i_cache | dest->from_i_cache << 1);
+            out.put<uint32_t>(dest->multicast_list.size());
+            for (int node : dest->multicast_list) {
+                out.put<int32_t>(node);
+            }
+        }
+        if (net) {
+            out.put<int32_t>(net->src);
+            out.put<int32_t>(net->dest);
+            out.put<int32_t>(net->vc);
+            out.put<int32_t>(net->size);
+            out.put<int32_t>(net->src_port);
+            out.put<int32_t>(net->dst_port);
+        }
+    }
+
+    static void read(PortReader& in, MemoryTransport& aTransport)
+    {
+        uint8_t slices = in.get<uint8_t>();
+        if (slices & kMemoryMessage) {
+            auto type = MemoryMessage::MemoryMessageType(in.get<uint32_t>());
+            PhysicalMemoryAddress address(in.get<uint64_t>());
+            VirtualMemoryAddress pc(in.get<uint64_t>());
+            bits data = in.get<uint64_t>();
+            data |= bits(in.get<uint64_t>()) << 64;
+
+            boost::intrusive_ptr<MemoryMessage> msg(new MemoryMessage(type, address, pc, data));
+            msg->reqSize()         = in.get<int32_t>();
+            msg->coreIdx()         = in.get<int32_t>();
+            msg->tl()              = in.get<int32_t>();
+            msg->fillLevel()       = tFillLevel(in.get<uint32_t>());
+            msg->fillType()        = Flexus::SharedTypes::tFillType(in.get<uint32_t>());
+            msg->outstandingMsgs() = in.get<int32_t>();
+            msg->branchType()      = Flexus::SharedTypes::eBranchType(in.get<uint32_t>());
+            uint8_t flags          = in.get<uint8_t>();
+            msg->priv()            = flags & 1;
+            msg->dstream()         = flags & 2;
+            msg->ackRequired()     = flags & 4;
+            msg->ackRequiresData() = flags & 8;
+            msg->evictHasData()    = flags & 16;
+            msg->branchAnnul()     = flags & 32;
+            if (flags & 64) msg->setPageWalk();
+            if (flags & 128) msg->setInvs();
+            aTransport.set(Flexus::SharedTypes::MemoryMessageTag, msg);
+        }
+        if (slices & kDestination) {
+            boost::intrusive_ptr<DestinationMessage> dest(
+              new DestinationMessage(DestinationMessage::DestinationType(in.get<uint32_t>())));
+            dest->requester        = in.get<int32_t>();
+            dest->directory        = in.get<int32_t>();
+            dest->remote_directory = in.get<int32_t>();
+            dest->source           = in.get<int32_t>();
+            dest->memory           = in.get<int32_t>();
+            dest->other            = in.get<int32_t>();
+            uint8_t flags          = in.get<uint8_t>();
+            dest->to_i_cache       = flags & 1;
+            dest->from_i_cache     = flags & 2;
+            for (uint32_t count = in.get<uint32_t>(); count > 0; --count) {
+                dest->multicast_list.push_back(in.get<int32_t>());
+            }
+            aTransport.set(Flexus::SharedTypes::DestinationTag, dest);
+        }
+        if (slices & kNetworkMessage) {
+            boost::intrusive_ptr<NetworkMessage> net(new NetworkMessage());
+            net->src      = in.get<int32_t>();
+            net->dest     = in.get<int32_t>();
+            net->vc       = in.get<int32_t>();
+            net->size     = in.get<int32_t>();
+            net->src_port = in.get<int32_t>();
+            net->dst_port = in.get<int32_t>();
+            aTransport.set(Flexus::SharedTypes::NetworkMessageTag, net);
+        }
+        if (slices & kTransactionTracker) {
+            aTransport.set(Flexus::SharedTypes::TransactionTrackerTag, new TransactionTracker());
+        }
+    }
+};
+
+template<>
+struct port_codec<TranslationPtr>
+{
+    static const bool recordable = true;
+    static char const* name() { return "TranslationPtr"; }
+
+    static void write(PortWriter& out, TranslationPtr& aTranslation)
+    {
+        out.put<uint8_t>(aTranslation != nullptr);
+        if (!aTranslation) return;
+
+        Translation const& tr = *aTranslation;
+        out.put<uint64_t>(tr.theVaddr);
+        out.put<uint64_t>(tr.thePaddr);
+        out.put<int32_t>(tr.thePSTATE);
+        out.put<uint32_t>(tr.theIndex);
+        out.put<uint32_t>(tr.theType);
+        out.put<uint32_t>(tr.theTLBstatus);
+        out.put<uint32_t>(tr.theTLBtype);
+        out.put<int32_t>(tr.theException);
+        out.put<uint64_t>(tr.theTTEEntry);
+        out.put<uint8_t>(tr.theCurrentTranslationLevel);
+        out.put<uint64_t>(tr.rawTTEValue);
+        out.put<uint64_t>(tr.theID);
+        out.put<uint64_t>(tr.theTimeoutCounter);
+        out.put<uint16_t>(tr.theASID);
+        out.put<uint64_t>(tr.theSequence);
+        out.put<uint8_t>(tr.theReady | tr.theWaiting << 1 | tr.theDone << 2 | tr.theAnnul << 3 |
+                         tr.thePageFault << 4 | tr.inTraceMode << 5 | tr.theNG << 6);
+    }
+
+    static void read(PortReader& in, TranslationPtr& aTranslation)
+    {
+        if (!in.get<uint8_t>()) {
+            aTranslation = nullptr;
+            return;
+        }
+
+        aTranslation    = new Translation();
+        Translation& tr = *aTranslation;
+
+        tr.theVaddr                   = VirtualMemoryAddress(in.get<uint64_t>());
+        tr.thePaddr                   = PhysicalMemoryAddress(in.get<uint64_t>());
+        tr.thePSTATE                  = in.get<int32_t>();
+        tr.theIndex                   = in.get<uint32_t>();
+        tr.theType                    = Translation::eTranslationType(in.get<uint32_t>());
+        tr.theTLBstatus               = Translation::eTLBstatus(in.get<uint32_t>());
+        tr.theTLBtype                 = Translation::eTLBtype(in.get<uint32_t>());
+        tr.theException               = in.get<int32_t>();
+        tr.theTTEEntry                = in.get<uint64_t>();
+        tr.theCurrentTranslationLevel = in.get<uint8_t>();
+        tr.rawTTEValue                = in.get<uint64_t>();
+        tr.theID                      = in.get<uint64_t>();
+        tr.theTimeoutCounter          = in.get<uint64_t>();
+        tr.theASID                    = in.get<uint16_t>();
+        tr.theSequence                = in.get<uint64_t>();
+        uint8_t flags                 = in.get<uint8_t>();
+        tr.theReady                   = flags & 1;
+        tr.theWaiting                 = flags & 2;
+        tr.theDone                    = flags & 4;
+        tr.theAnnul                   = flags & 8;
+        tr.thePageFault               = flags & 16;
+        tr.inTraceMode                = flags & 32;
+        tr.theNG                      = flags & 64;
+    }
+};
+
+template<>
+struct port_codec<pFetchBundle>
+{
+    static const bool recordable = true;
+    static char const* name() { return "FetchBundle"; }
+
+    static void write(PortWriter& out, pFetchBundle& aBundle)
+    {
+        out.put<uint8_t>(aBundle != nullptr);
+        if (!aBundle) return;
+
+        out.put<int32_t>(aBundle->coreID);
+        out.put<uint32_t>(aBundle->theOpcodes.size());
+        for (auto const& opcode : aBundle->theOpcodes) {
+            out.put<uint64_t>(opcode.thePC);
+            out.put<uint32_t>(opcode.theOpcode);
+        }
+        out.put<uint32_t>(aBundle->theOpcodes.size());
+        for (auto const& opcode : aBundle->theOpcodes) {
+            out.put<uint32_t>(opcode.theFillLevel);
+        }
+    }
+
+    static void read(PortReader& in, pFetchBundle& aBundle)
+    {
+        if (!in.get<uint8_t>()) {
+            aBundle = nullptr;
+            return;
+        }
+
+        aBundle         = new FetchBundle();
+        aBundle->coreID = in.get<int32_t>();
+        for (uint32_t count = in.get<uint32_t>(); count > 0; --count) {
+            VirtualMemoryAddress pc(in.get<uint64_t>());
+            Flexus::SharedTypes::Opcode opcode = in.get<uint32_t>();
+            aBundle->theOpcodes.push_back(FetchedOpcode(pc, opcode, Flexus::SharedTypes::eL1I, nullptr, nullptr));
+        }
+        for (uint32_t i = 0, count = in.get<uint32_t>(); i < count; ++i) {
+            tFillLevel level(tFillLevel(in.get<uint32_t>()));
+            if (i < aBundle->theOpcodes.size()) aBundle->theOpcodes[i].theFillLevel = level;
+        }
+    }
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_COMMON_PORT_CODECS_HPP_INCLUDED
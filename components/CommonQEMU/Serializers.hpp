@@ -1,37 +1,53 @@
 #ifndef _COMMON_SERIALIZERS_HPP_
 #define _COMMON_SERIALIZERS_HPP_
 
+#include "core/boost_extensions/compact_serialization.hpp"
 #include "core/debug/debug.hpp"
 #include "core/types.hpp"
 
 #include <bitset>
 #include <boost/lambda/lambda.hpp>
+#include <boost/serialization/nvp.hpp>
 #include <boost/serialization/serialization.hpp>
+#include <boost/serialization/split_free.hpp>
 #include <boost/serialization/tracking.hpp>
+#include <boost/serialization/version.hpp>
 
 #define MAX_NUM_SHARERS 256
 
 namespace boost {
 namespace serialization {
 
+// Version 1 stores the bits as compact::save_bits, version 0 stored them as a
+// string of '0' and '1' characters.
 template<class Archive, std::size_t size>
 inline void
 save(Archive& ar, std::bitset<size> const& t, const unsigned int /* version */
 )
 {
-    const std::string bits =
-      t.template to_string<std::string::value_type, std::string::traits_type, std::string::allocator_type>();
-    ar << BOOST_SERIALIZATION_NVP(bits);
+    uint64_t words[(size + 63) / 64] = {};
+    for (std::size_t i = 0; i < size; ++i) {
+        if (t[i]) words[i / 64] |= uint64_t(1) << (i % 64);
+    }
+    compact::save_bits(ar, words, (size + 63) / 64);
 }
 
 template<class Archive, std::size_t size>
 inline void
-load(Archive& ar, std::bitset<size>& t, const unsigned int /* version */
-)
+load(Archive& ar, std::bitset<size>& t, const unsigned int version)
 {
-    std::string bits;
-    ar >> BOOST_SERIALIZATION_NVP(bits);
-    t = std::bitset<size>(bits);
+    if (version == 0) {
+        std::string bits;
+        ar >> BOOST_SERIALIZATION_NVP(bits);
+        t = std::bitset<size>(bits);
+        return;
+    }
+    uint64_t words[(size + 63) / 64];
+    compact::load_bits(ar, words, (size + 63) / 64);
+    t.reset();
+    for (std::size_t i = 0; i < size; ++i) {
+        if (words[i / 64] & (uint64_t(1) << (i % 64))) t.set(i);
+    }
 }
 
 template<class Archive, std::size_t size>
@@ -50,6 +66,14 @@ serialize(Archive& ar, std::bitset<size>& t, const unsigned int version)
 template<std::size_t size>
 struct tracking_level<std::bitset<size>> : mpl::int_<track_never>
 {};
+
+template<std::size_t size>
+struct version<std::bitset<size>>
+{
+    typedef mpl::integral_c_tag tag;
+    typedef mpl::int_<1> type;
+    BOOST_STATIC_CONSTANT(int, value = version::type::value);
+};
 }; // namespace serialization
 }; // namespace boost
 
@@ -1,14 +1,15 @@
 #include <components/CommonQEMU/Slices/MemoryMessage.hpp>
+#include <core/uncore_pool.hpp>
 
 namespace Flexus {
 namespace SharedTypes {
 
-static uint32_t theMemoryMessageSerial = 0;
-
-uint32_t
+// Messages built by an L2 bank draw from that bank's sequence, so that the
+// serials are the same whether or not the banks run on the uncore pool
+uint64_t
 memoryMessageSerial(void)
 {
-    return ++theMemoryMessageSerial;
+    return Flexus::Core::UncorePool::nextSerial(Flexus::Core::UncorePool::kMessageSerial);
 }
 
 std::ostream&
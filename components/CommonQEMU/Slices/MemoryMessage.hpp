@@ -17,7 +17,7 @@ namespace SharedTypes {
 using namespace Flexus::Core;
 using boost::intrusive_ptr;
 
-uint32_t
+uint64_t
 memoryMessageSerial(void);
 
 #define HEADER_SIZE 8
@@ -497,7 +497,7 @@ struct MemoryMessage : public boost::counted_base
     int32_t& coreIdx() { return theCoreIdx; }
     const tFillLevel fillLevel() const { return theFillLevel; }
     tFillLevel& fillLevel() { return theFillLevel; }
-    uint32_t serial() const { return theSerial; }
+    uint64_t serial() const { return theSerial; }
     const tFillType fillType() const { return theFillType; }
     tFillType& fillType() { return theFillType; }
 
@@ -951,7 +951,7 @@ struct MemoryMessage : public boost::counted_base
     bits theData;
     int32_t theReqSize;
     int32_t theCoreIdx;
-    uint32_t theSerial;
+    uint64_t theSerial;
     bool thePriv;
     int theTL;
     bool theAnyInvs;
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <components/CommonQEMU/Slices/TransactionTracker.hpp>
 #include <core/stats.hpp>
+#include <core/uncore_pool.hpp>
 #include <memory>
 
 #define DBG_DefineCategories TransactionTrace, TransactionDetailsTrace
@@ -14,11 +15,11 @@ namespace SharedTypes {
 namespace Stat = Flexus::Stat;
 // namespace ll = boost::lambda;
 
-uint64_t theGloballyUniqueId = 0;
+// Per L2 bank while the banks are driven, like the message serials
 uint64_t
 getTTGUID()
 {
-    return theGloballyUniqueId++;
+    return Flexus::Core::UncorePool::nextSerial(Flexus::Core::UncorePool::kTrackerSerial);
 }
 std::shared_ptr<TransactionTracer> TransactionTracker::theTracer;
 std::shared_ptr<TransactionStatManager> TransactionTracker::theTSM;
@@ -51,6 +51,7 @@ struct Translation : public boost::counted_base
       , inTraceMode(false)
       , theASID(0)
       , theNG(true)
+      , theSequence(0)
 
     {
     }
@@ -74,6 +75,7 @@ struct Translation : public boost::counted_base
         inTraceMode       = aTr.inTraceMode;
         theNG             = aTr.theNG;
         theASID           = aTr.theASID;
+        theSequence       = aTr.theSequence;
     }
 
     Translation& operator=(Translation& rhs)
@@ -95,6 +97,7 @@ struct Translation : public boost::counted_base
         inTraceMode       = rhs.inTraceMode;
         theNG             = rhs.theNG;
         theASID           = rhs.theASID;
+        theSequence       = rhs.theSequence;
 
         return *this;
     }
@@ -123,6 +126,7 @@ struct Translation : public boost::counted_base
     bool inTraceMode;
     uint16_t theASID; // Address Space Identifier
     bool theNG; // non-global bit
+    uint64_t theSequence; // of the fetched opcode waiting for it, in uFetch
 
     boost::intrusive_ptr<AbstractInstruction> theInstruction;
 
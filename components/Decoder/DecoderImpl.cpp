@@ -28,7 +28,7 @@ class FLEXUS_COMPONENT(Decoder)
     FLEXUS_COMPONENT_IMPL(Decoder);
 
     int64_t theInsnSequenceNo;
-    std::list<boost::intrusive_ptr<AbstractInstruction>> theFIQ;
+    boost::circular_buffer<boost::intrusive_ptr<AbstractInstruction>> theFIQ;
 
     bool theSyncInsnInProgress;
 
@@ -48,6 +48,7 @@ class FLEXUS_COMPONENT(Decoder)
     {
         theInsnSequenceNo     = 0;
         theSyncInsnInProgress = false;
+        theFIQ.set_capacity(cfg.FIQSize);
     }
 
     void finalize() {}
@@ -56,26 +57,22 @@ class FLEXUS_COMPONENT(Decoder)
     FLEXUS_PORT_ALWAYS_AVAILABLE(FetchBundleIn);
     void push(interface::FetchBundleIn const&, pFetchBundle& aBundle)
     {
-        std::list<std::shared_ptr<tFillLevel>>::iterator fill_iter = aBundle->theFillLevels.begin();
-        for (auto it = aBundle->theOpcodes.begin(); it != aBundle->theOpcodes.end(); it++) {
-            auto iter = *it;
-
+        for (auto const& op : aBundle->theOpcodes) {
             int32_t uop = 0;
             boost::intrusive_ptr<AbstractInstruction> insn;
             bool final_uop = false;
             // Note that multi-uop instructions can cause theFIQ to fill beyond its
-            // configured size.
+            // configured size, in which case the ring grows.
             while (!final_uop) {
-                boost::tie(insn, final_uop) = decode(*iter, aBundle->coreID, ++theInsnSequenceNo, uop++);
+                boost::tie(insn, final_uop) = decode(op, aBundle->coreID, ++theInsnSequenceNo, uop++);
                 if (insn) {
-                    insn->setFetchTransactionTracker(iter->theTransaction);
+                    insn->setFetchTransactionTracker(op.theTransaction);
                     // Set Fill Level for the insn
-                    insn->setSourceLevel(**fill_iter);
-                    theFIQ.push_back(insn);
+                    insn->setSourceLevel(op.theFillLevel);
+                    ringPush(theFIQ, insn);
                 } else
                     DBG_(VVerb, (<< "No INSTRUCTION"));
             }
-            ++fill_iter;
         }
     }
 
@@ -0,0 +1,183 @@
+#ifndef FLEXUS_DECODER_EXECUTEKERNELS_HPP_INCLUDED
+#define FLEXUS_DECODER_EXECUTEKERNELS_HPP_INCLUDED
+
+#include "OperandCode.hpp"
+#include "components/uArch/CoreModel/PSTATE.hpp"
+
+#include <core/debug/debug.hpp>
+#include <cstdint>
+
+namespace nDecoder {
+
+/*
+ * Execute kernels for the integer operations of Operations.cpp.
+ *
+ * A kernel is a plain function over native 64-bit operands, returning the
+ * result and the NZCV bits in registers. ExecuteAction calls it directly when
+ * the Operation it was built with has one, and falls back to the virtual
+ * Operation::operator() for everything else (128-bit results, preset operands,
+ * non-integer operands). Each kernel must compute exactly what the matching
+ * Operation computes.
+ */
+struct KernelResult
+{
+    uint64_t theValue;
+    uint32_t theNZCV;
+};
+
+typedef KernelResult (*execute_kernel)(uint64_t const* anOperands, uint32_t aCount);
+
+namespace kernels {
+
+inline uint32_t
+carryIn(uint64_t const* anOperands, uint32_t aCount, uint32_t aDefault)
+{
+    return (aCount == 3) ? (PSTATE(anOperands[2]).C() ? 1 : 0) : aDefault;
+}
+
+// AddWithCarry() of the ARM pseudocode, on N-bit operands
+template<uint32_t N>
+inline KernelResult
+addWithCarry(uint64_t x, uint64_t y, uint32_t aCarry)
+{
+    uint64_t result;
+    bool carry, overflow;
+    if (N == 64) {
+        unsigned __int128 usum = (unsigned __int128)x + y + aCarry;
+        __int128 ssum          = (__int128)(int64_t)x + (int64_t)y + aCarry;
+        result                 = uint64_t(usum);
+        carry                  = usum != result;
+        overflow               = ssum != (int64_t)result;
+    } else {
+        uint64_t usum = uint64_t(uint32_t(x)) + uint32_t(y) + aCarry;
+        int64_t ssum  = int64_t(int32_t(x)) + int32_t(y) + aCarry;
+        result        = uint32_t(usum);
+        carry         = usum != result;
+        overflow      = ssum != int64_t(int32_t(result));
+    }
+    uint32_t nzcv = ((result >> (N - 1)) & 1 ? PSTATE_N : 0) | (result == 0 ? PSTATE_Z : 0) |
+                    (carry ? PSTATE_C : 0) | (overflow ? PSTATE_V : 0);
+    return { result, nzcv };
+}
+
+inline uint32_t
+logicalFlags(uint64_t aResult)
+{
+    return ((aResult >> 63) ? PSTATE_N : 0) | (aResult == 0 ? PSTATE_Z : 0);
+}
+
+inline KernelResult
+add(uint64_t const* op, uint32_t n)
+{
+    return { op[0] + (n > 1 ? op[1] : 0) + carryIn(op, n, 0), 0 };
+}
+inline KernelResult
+sub(uint64_t const* op, uint32_t n)
+{
+    DBG_Assert(n == 2 || n == 3); // operand 3 is carry
+    return { op[0] - op[1] - (1 - carryIn(op, n, 1)), 0 };
+}
+template<uint32_t N>
+inline KernelResult
+adds(uint64_t const* op, uint32_t n)
+{
+    DBG_Assert(n == 2 || n == 3);
+    return addWithCarry<N>(op[0], op[1], carryIn(op, n, 0));
+}
+template<uint32_t N>
+inline KernelResult
+subs(uint64_t const* op, uint32_t n)
+{
+    DBG_Assert(n == 2 || n == 3);
+    return addWithCarry<N>(op[0], ~op[1], carryIn(op, n, 1));
+}
+inline KernelResult
+ands(uint64_t const* op, uint32_t)
+{
+    uint64_t result = op[0] & op[1];
+    return { result, logicalFlags(result) };
+}
+inline KernelResult
+andsn(uint64_t const* op, uint32_t)
+{
+    uint64_t result = op[0] & ~op[1];
+    return { result, logicalFlags(result) };
+}
+// clang-format off
+inline KernelResult and_(uint64_t const* op, uint32_t) { return { op[0] & op[1], 0 }; }
+inline KernelResult orr(uint64_t const* op, uint32_t) { return { op[0] | op[1], 0 }; }
+inline KernelResult xor_(uint64_t const* op, uint32_t) { return { op[0] ^ op[1], 0 }; }
+inline KernelResult andn(uint64_t const* op, uint32_t) { return { op[0] & ~op[1], 0 }; }
+inline KernelResult orn(uint64_t const* op, uint32_t) { return { op[0] | ~op[1], 0 }; }
+inline KernelResult eon(uint64_t const* op, uint32_t) { return { op[0] | ~op[1], 0 }; } // as EoN
+inline KernelResult xnor(uint64_t const* op, uint32_t) { return { op[0] ^ ~op[1], 0 }; }
+inline KernelResult not_(uint64_t const* op, uint32_t) { return { ~op[0], 0 }; }
+inline KernelResult mul(uint64_t const* op, uint32_t) { return { op[0] * op[1], 0 }; }
+inline KernelResult mov(uint64_t const* op, uint32_t) { return { op[0], 0 }; }
+inline KernelResult movn(uint64_t const* op, uint32_t) { return { ~op[0], 0 }; }
+inline KernelResult movk(uint64_t const* op, uint32_t) { return { (op[1] & op[2]) | op[0], 0 }; }
+inline KernelResult overwrite(uint64_t const* op, uint32_t) { return { (op[0] & op[2]) | op[1], 0 }; }
+inline KernelResult sextb(uint64_t const* op, uint32_t) { return { (op[0] & 0x80) ? op[0] | SIGNED_UPPER_BOUND_B : op[0], 0 }; }
+inline KernelResult sexth(uint64_t const* op, uint32_t) { return { (op[0] & 0x8000) ? op[0] | SIGNED_UPPER_BOUND_H : op[0], 0 }; }
+inline KernelResult zextb(uint64_t const* op, uint32_t) { return { op[0] & ~SIGNED_UPPER_BOUND_B, 0 }; }
+inline KernelResult zexth(uint64_t const* op, uint32_t) { return { op[0] & ~SIGNED_UPPER_BOUND_H, 0 }; }
+inline KernelResult zextw(uint64_t const* op, uint32_t) { return { op[0] & ~SIGNED_UPPER_BOUND_W, 0 }; }
+// clang-format on
+inline KernelResult
+lsl(uint64_t const* op, uint32_t)
+{
+    uint64_t mask = (op[2] == 32) ? 0xffffffff : 0xffffffffffffffff;
+    return { op[0] << (op[1] % op[2]) & mask, 0 };
+}
+inline KernelResult
+lsr(uint64_t const* op, uint32_t)
+{
+    uint64_t mask = (op[2] == 32) ? 0xffffffff : 0xffffffffffffffff;
+    return { op[0] >> (op[1] % op[2]) & mask, 0 };
+}
+
+} // namespace kernels
+
+// Kernel implementing anOpType, or nullptr if it has to go through Operation.
+// aSetsFlags tells whether the kernel produces NZCV.
+inline execute_kernel
+executeKernel(eOpType anOpType, bool& aSetsFlags)
+{
+    aSetsFlags = false;
+    switch (anOpType) {
+        case kADD_: return &kernels::add;
+        case kSUB_: return &kernels::sub;
+        case kADDS32_: aSetsFlags = true; return &kernels::adds<32>;
+        case kADDS64_: aSetsFlags = true; return &kernels::adds<64>;
+        case kSUBS32_: aSetsFlags = true; return &kernels::subs<32>;
+        case kSUBS64_: aSetsFlags = true; return &kernels::subs<64>;
+        case kANDS_: aSetsFlags = true; return &kernels::ands;
+        case kANDSN_: aSetsFlags = true; return &kernels::andsn;
+        case kAND_: return &kernels::and_;
+        case kORR_: return &kernels::orr;
+        case kXOR_: return &kernels::xor_;
+        case kAndN_: return &kernels::andn;
+        case kOrN_: return &kernels::orn;
+        case kEoN_: return &kernels::eon;
+        case kXnor_: return &kernels::xnor;
+        case kNot_: return &kernels::not_;
+        case kMulX_: return &kernels::mul;
+        case kMOV_: return &kernels::mov;
+        case kMOVN_: return &kernels::movn;
+        case kMOVK_: return &kernels::movk;
+        case kOVERWRITE_: return &kernels::overwrite;
+        case kSextB_: return &kernels::sextb;
+        case kSextH_: return &kernels::sexth;
+        case kZextB_: return &kernels::zextb;
+        case kZextH_: return &kernels::zexth;
+        case kZextW_: return &kernels::zextw;
+        case kZextX_: return &kernels::mov;
+        case kLSL_: return &kernels::lsl;
+        case kLSR_: return &kernels::lsr;
+        default: return nullptr;
+    }
+}
+
+} // namespace nDecoder
+
+#endif // FLEXUS_DECODER_EXECUTEKERNELS_HPP_INCLUDED
@@ -141,6 +141,7 @@ enum eOperandCode
     kocFPCR,
     kUopAddressOffset,
     kSopAddressOffset,
+    kNumOperandCodes, // number of real operand codes, not an operand
     kLastOperandCode = 0xDEAD
 };
 
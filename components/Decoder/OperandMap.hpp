@@ -1,10 +1,12 @@
-
 #ifndef FLEXUS_DECODER_OPERANDMAP_HPP_INCLUDED
 #define FLEXUS_DECODER_OPERANDMAP_HPP_INCLUDED
 
 #include "OperandCode.hpp"
 
+#include <bitset>
 #include <components/uArch/uArchInterfaces.hpp>
+#include <new>
+#include <vector>
 
 using namespace nuArch;
 
@@ -14,47 +16,137 @@ using operand_typelist_1 = mpl::push_front<register_value::types, mapped_reg>::t
 using operand_typelist   = mpl::push_front<operand_typelist_1, reg>::type;
 using Operand            = boost::make_variant_over<operand_typelist>::type;
 
+/*
+ * Non-owning view over a contiguous run of operands, handed to Operations so
+ * that semantic actions can gather their inputs on the stack instead of
+ * building a std::vector per execution.
+ */
+class OperandSpan
+{
+    Operand const* theBegin;
+    std::size_t theSize;
+
+  public:
+    OperandSpan()
+      : theBegin(nullptr)
+      , theSize(0)
+    {
+    }
+    OperandSpan(Operand const* aBegin, std::size_t aSize)
+      : theBegin(aBegin)
+      , theSize(aSize)
+    {
+    }
+    OperandSpan(std::vector<Operand> const& aVector)
+      : theBegin(aVector.data())
+      , theSize(aVector.size())
+    {
+    }
+    template<std::size_t N>
+    OperandSpan(Operand const (&anArray)[N])
+      : theBegin(anArray)
+      , theSize(N)
+    {
+    }
+
+    std::size_t size() const { return theSize; }
+    bool empty() const { return theSize == 0; }
+    Operand const& operator[](std::size_t anIndex) const { return theBegin[anIndex]; }
+    Operand const* begin() const { return theBegin; }
+    Operand const* end() const { return theBegin + theSize; }
+};
+
+/*
+ * Operands of a dynamic instruction, stored densely by operand code. Slots are
+ * raw storage that is only constructed when an operand is first set (or
+ * requested), and a bitmask records which slots are live, so building the map
+ * allocates nothing and every access is a single indexed load.
+ */
 class OperandMap
 {
+    std::bitset<kNumOperandCodes> thePresent;
+    alignas(Operand) unsigned char theStorage[kNumOperandCodes][sizeof(Operand)];
 
-    typedef std::map<eOperandCode, Operand> operand_map;
-    operand_map theOperandMap;
+    Operand* slot(eOperandCode anOperandId) { return reinterpret_cast<Operand*>(theStorage[anOperandId]); }
+    Operand const* slot(eOperandCode anOperandId) const
+    {
+        return reinterpret_cast<Operand const*>(theStorage[anOperandId]);
+    }
+
+    // Returns the live slot for anOperandId, default constructing it if needed
+    Operand& at(eOperandCode anOperandId)
+    {
+        DBG_Assert(anOperandId < kNumOperandCodes, (<< "Invalid operand code " << static_cast<int>(anOperandId)));
+        if (!thePresent[anOperandId]) {
+            new (slot(anOperandId)) Operand();
+            thePresent.set(anOperandId);
+        }
+        return *slot(anOperandId);
+    }
+
+    template<class T>
+    void assign(eOperandCode anOperandId, T const& aT)
+    {
+        DBG_Assert(anOperandId < kNumOperandCodes, (<< "Invalid operand code " << static_cast<int>(anOperandId)));
+        if (thePresent[anOperandId]) {
+            *slot(anOperandId) = aT;
+        } else {
+            new (slot(anOperandId)) Operand(aT);
+            thePresent.set(anOperandId);
+        }
+    }
+
+    void clear()
+    {
+        for (int32_t i = 0; i < kNumOperandCodes; ++i) {
+            if (thePresent[i]) slot(eOperandCode(i))->~Operand();
+        }
+        thePresent.reset();
+    }
 
   public:
+    OperandMap() {}
+    OperandMap(OperandMap const& anOther) { *this = anOther; }
+    OperandMap& operator=(OperandMap const& anOther)
+    {
+        if (this != &anOther) {
+            clear();
+            for (int32_t i = 0; i < kNumOperandCodes; ++i) {
+                if (anOther.thePresent[i]) assign(eOperandCode(i), *anOther.slot(eOperandCode(i)));
+            }
+        }
+        return *this;
+    }
+    ~OperandMap() { clear(); }
+
     template<class T>
     T& operand(eOperandCode anOperandId)
     {
-        return boost::get<T>(theOperandMap[anOperandId]);
+        return boost::get<T>(at(anOperandId));
     }
 
-    Operand& operand(eOperandCode anOperandId) { return theOperandMap[anOperandId]; }
+    Operand& operand(eOperandCode anOperandId) { return at(anOperandId); }
 
     template<class T>
     void set(eOperandCode anOperandId, T aT)
     {
-        theOperandMap[anOperandId] = aT;
+        assign(anOperandId, aT);
     }
 
-    void set(eOperandCode anOperandId, Operand const& aT) { theOperandMap[anOperandId] = aT; }
-
-    bool hasOperand(eOperandCode anOperandId) const { return (theOperandMap.find(anOperandId) != theOperandMap.end()); }
+    void set(eOperandCode anOperandId, Operand const& aT) { assign(anOperandId, aT); }
 
-    struct operandPrinter
+    bool hasOperand(eOperandCode anOperandId) const
     {
-        std::ostream& theOstream;
-        operandPrinter(std::ostream& anOstream)
-          : theOstream(anOstream)
-        {
-        }
-        void operator()(operand_map::value_type const& anEntry)
-        {
-            theOstream << "\t   " << anEntry.first << " = " << anEntry.second << "\n";
-        }
-    };
+        return anOperandId < kNumOperandCodes && thePresent[anOperandId];
+    }
 
     void dump(std::ostream& anOstream) const
     {
-        std::for_each(theOperandMap.begin(), theOperandMap.end(), operandPrinter(anOstream));
+        for (int32_t i = 0; i < kNumOperandCodes; ++i) {
+            if (thePresent[i]) {
+                anOstream << "\t   " << eOperandCode(i) << " = " << *slot(eOperandCode(i)) << "\n";
+            }
+        }
     }
 };
 
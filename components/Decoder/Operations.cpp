@@ -27,7 +27,7 @@ typedef struct OFFSET : public Operation
 {
     OFFSET() {}
     virtual ~OFFSET() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         if (theOperands.size()) {
             DBG_Assert(theOperands.size() == 1 || theOperands.size() == 2, (<< *theInstruction));
@@ -48,9 +48,9 @@ typedef struct ADD : public Operation
 {
     ADD() {}
     virtual ~ADD() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
-        std::vector<Operand> finalOperands = theOperands.size() ? theOperands : operands;
+        OperandSpan finalOperands = theOperands.size() ? OperandSpan(theOperands) : operands;
         SEMANTICS_DBG("ADDING with " << finalOperands.size());
         DBG_Assert(finalOperands.size() <= 3 && finalOperands.size() > 0,
                    (<< *theInstruction << "num operands: " << finalOperands.size()));
@@ -78,7 +78,7 @@ typedef struct ADDS : public Operation
     using Operation::Operation;
     virtual ~ADDS() {}
 
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2 || operands.size() == 3);
         uint64_t carry;
@@ -147,7 +147,7 @@ typedef struct SUB : public Operation
 {
     SUB() {}
     virtual ~SUB() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2 || operands.size() == 3); // operand 3 is carry
         if (operands.size() == 2) {
@@ -170,7 +170,7 @@ typedef struct SUBS : public Operation
         theSize = aSize;
     }
     virtual ~SUBS() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2 || operands.size() == 3);
         uint64_t carry;
@@ -239,7 +239,7 @@ typedef struct CONCAT32 : public Operation
 {
     CONCAT32() {}
     virtual ~CONCAT32() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op1 = boost::get<uint64_t>(operands[0]);
@@ -258,7 +258,7 @@ typedef struct CONCAT64 : public Operation
 {
     CONCAT64() {}
     virtual ~CONCAT64() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op1 = boost::get<uint64_t>(operands[0]);
@@ -274,7 +274,7 @@ typedef struct AND : public Operation
 {
     AND() {}
     virtual ~AND() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         DBG_(VVerb,
@@ -289,7 +289,7 @@ typedef struct ANDS : public Operation
 {
     ANDS() {}
     virtual ~ANDS() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t result = boost::get<uint64_t>(operands[0]) & boost::get<uint64_t>(operands[1]);
@@ -312,7 +312,7 @@ typedef struct ANDSN : public Operation
 {
     ANDSN() {}
     virtual ~ANDSN() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t result = boost::get<uint64_t>(operands[0]) & ~boost::get<uint64_t>(operands[1]);
@@ -335,7 +335,7 @@ typedef struct ORR : public Operation
 {
     ORR() {}
     virtual ~ORR() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) | boost::get<uint64_t>(operands[1]);
@@ -347,7 +347,7 @@ typedef struct XOR : public Operation
 {
     XOR() {}
     virtual ~XOR() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) ^ boost::get<uint64_t>(operands[1]);
@@ -360,7 +360,7 @@ typedef struct AndN : public Operation
 
     AndN() {}
     virtual ~AndN() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) & ~boost::get<uint64_t>(operands[1]);
@@ -373,7 +373,7 @@ typedef struct EoN : public Operation
     EoN() {}
     virtual ~EoN() {}
 
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) | ~boost::get<uint64_t>(operands[1]);
@@ -385,7 +385,7 @@ typedef struct OrN : public Operation
 {
     OrN() {}
     virtual ~OrN() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) | ~boost::get<uint64_t>(operands[1]);
@@ -397,7 +397,7 @@ typedef struct Not : public Operation
 {
     Not() {}
     virtual ~Not() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         return ~boost::get<uint64_t>(operands[0]);
@@ -409,7 +409,7 @@ typedef struct ROR : public Operation
 {
     ROR() {}
     virtual ~ROR() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 3);
         uint64_t input      = boost::get<uint64_t>(operands[0]);
@@ -427,7 +427,7 @@ typedef struct LSL : public Operation
 {
     LSL() {}
     virtual ~LSL() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 3);
         uint64_t op1       = boost::get<uint64_t>(operands[0]);
@@ -446,7 +446,7 @@ typedef struct ASR : public Operation
 {
     ASR() {}
     virtual ~ASR() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 3);
         uint64_t input      = boost::get<uint64_t>(operands[0]);
@@ -462,7 +462,7 @@ typedef struct LSR : public Operation
 {
     LSR() {}
     virtual ~LSR() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 3);
         uint64_t op1       = boost::get<uint64_t>(operands[0]);
@@ -479,7 +479,7 @@ typedef struct SextB : public Operation
 {
     SextB() {}
     virtual ~SextB() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         uint64_t op1 = (uint64_t)(boost::get<uint64_t>(operands[0]));
@@ -493,7 +493,7 @@ typedef struct SextH : public Operation
 {
     SextH() {}
     virtual ~SextH() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         uint64_t op1 = (uint64_t)(boost::get<uint64_t>(operands[0]));
@@ -507,7 +507,7 @@ typedef struct SextW : public Operation
 {
     SextW() {}
     virtual ~SextW() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         uint64_t op1 = (uint64_t)(boost::get<uint64_t>(operands[0]));
@@ -521,7 +521,7 @@ typedef struct SextX : public Operation
 {
     SextX() {}
     virtual ~SextX() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         return (uint64_t)(boost::get<uint64_t>(operands[0]) | SIGNED_UPPER_BOUND_X);
@@ -533,7 +533,7 @@ typedef struct ZextB : public Operation
 {
     ZextB() {}
     virtual ~ZextB() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         uint64_t op = boost::get<uint64_t>(operands[0]);
@@ -547,7 +547,7 @@ typedef struct ZextH : public Operation
 {
     ZextH() {}
     virtual ~ZextH() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         uint64_t op = boost::get<uint64_t>(operands[0]);
@@ -561,7 +561,7 @@ typedef struct ZextW : public Operation
 {
     ZextW() {}
     virtual ~ZextW() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         uint64_t op = boost::get<uint64_t>(operands[0]);
@@ -575,7 +575,7 @@ typedef struct ZextX : public Operation
 {
     ZextX() {}
     virtual ~ZextX() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         return boost::get<uint64_t>(operands[0]);
@@ -587,7 +587,7 @@ typedef struct Xnor : public Operation
 {
     Xnor() {}
     virtual ~Xnor() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) ^ ~boost::get<uint64_t>(operands[1]);
@@ -599,7 +599,7 @@ typedef struct UMul : public Operation
 {
     UMul() {}
     virtual ~UMul() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         bits op0      = boost::get<uint64_t>(operands[0]);
@@ -607,8 +607,8 @@ typedef struct UMul : public Operation
         uint64_t prod = uint64_t((op0 * op1) & (bits)0xFFFFFFFFFFFFFFFF);
         return prod;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "UMul"; }
 } UMul_;
 
@@ -616,7 +616,7 @@ typedef struct UMulH : public Operation
 {
     UMulH() {}
     virtual ~UMulH() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         bits op0      = boost::get<uint64_t>(operands[0]);
@@ -624,8 +624,8 @@ typedef struct UMulH : public Operation
         uint64_t prod = (uint64_t)((op0 * op1) >> 64);
         return prod;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "UMulH"; }
 } UMulH_;
 
@@ -633,7 +633,7 @@ typedef struct UMulL : public Operation
 {
     UMulL() {}
     virtual ~UMulL() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op0  = (uint32_t)boost::get<uint64_t>(operands[0]);
@@ -641,8 +641,8 @@ typedef struct UMulL : public Operation
         uint64_t prod = op0 * op1;
         return prod;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "UMulL"; }
 } UMulL_;
 
@@ -650,7 +650,7 @@ typedef struct SMul : public Operation
 {
     SMul() {}
     virtual ~SMul() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op0   = boost::get<uint64_t>(operands[0]) & (uint64_t)0xFFFFFFFFULL;
@@ -660,8 +660,8 @@ typedef struct SMul : public Operation
         uint64_t prod  = op0_s * op1_s;
         return prod;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "SMul"; }
 } SMul_;
 
@@ -669,7 +669,7 @@ typedef struct SMulH : public Operation
 {
     SMulH() {}
     virtual ~SMulH() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         int64_t op0   = boost::get<uint64_t>(operands[0]);
@@ -678,8 +678,8 @@ typedef struct SMulH : public Operation
         uint64_t prod = (uint64_t)((multi & ((bits)0xFFFFFFFFFFFFFFFF << 64)) >> 64);
         return prod;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "SMulH"; }
 } SMulH_;
 
@@ -687,7 +687,7 @@ typedef struct SMulL : public Operation
 {
     SMulL() {}
     virtual ~SMulL() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op0  = (int64_t)(int32_t)(boost::get<uint64_t>(operands[0]));
@@ -695,8 +695,8 @@ typedef struct SMulL : public Operation
         uint64_t prod = op0 * op1;
         return prod;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "SMulL"; }
 } SMulL_;
 
@@ -704,7 +704,7 @@ typedef struct UDiv : public Operation
 {
     UDiv() {}
     virtual ~UDiv() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op0 = boost::get<uint64_t>(operands[0]);
@@ -714,8 +714,8 @@ typedef struct UDiv : public Operation
 
         return op0 / op1;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "UDiv"; }
 } UDiv_;
 
@@ -723,7 +723,7 @@ typedef struct SDiv : public Operation
 {
     using Operation::Operation;
     virtual ~SDiv() {}
-    uint64_t calc(std::vector<Operand> const& operands)
+    uint64_t calc(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         int64_t op0;
@@ -740,8 +740,8 @@ typedef struct SDiv : public Operation
 
         return op0 / op1;
     }
-    virtual Operand operator()(std::vector<Operand> const& operands) { return calc(operands); }
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return calc(operands) >> 32; }
+    virtual Operand operator()(OperandSpan operands) { return calc(operands); }
+    virtual Operand evalExtra(OperandSpan operands) { return calc(operands) >> 32; }
     virtual char const* describe() const { return "SDiv"; }
 } SDiv_;
 
@@ -749,7 +749,7 @@ typedef struct MulX : public Operation
 {
     MulX() {}
     virtual ~MulX() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         return boost::get<uint64_t>(operands[0]) * boost::get<uint64_t>(operands[1]);
@@ -761,7 +761,7 @@ typedef struct UDivX : public Operation
 {
     UDivX() {}
     virtual ~UDivX() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         if (boost::get<uint64_t>(operands[1]) != 0) {
@@ -778,7 +778,7 @@ typedef struct SDivX : public Operation
 {
     SDivX() {}
     virtual ~SDivX() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 2);
         uint64_t op0_s = boost::get<uint64_t>(operands[0]);
@@ -797,7 +797,7 @@ typedef struct MOV_ : public Operation
 {
     MOV_() {}
     virtual ~MOV_() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         if (theOperands.size()) {
             DBG_Assert(theOperands.size() == 1);
@@ -815,7 +815,7 @@ typedef struct MOVN_ : public Operation
 {
     MOVN_() {}
     virtual ~MOVN_() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 1);
         return ~boost::get<uint64_t>(operands[0]);
@@ -827,7 +827,7 @@ typedef struct MOVK_ : public Operation
 {
     MOVK_() {}
     virtual ~MOVK_() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 3);
         uint64_t imm  = boost::get<uint64_t>(operands[0]);
@@ -846,7 +846,7 @@ typedef struct OVERWRITE_ : public Operation
 {
     OVERWRITE_() {}
     virtual ~OVERWRITE_() {}
-    virtual Operand operator()(std::vector<Operand> const& operands)
+    virtual Operand operator()(OperandSpan operands)
     {
         DBG_Assert(operands.size() == 3);
         uint64_t lhs  = boost::get<uint64_t>(operands[0]);
@@ -927,6 +927,7 @@ operation(eOpType aType)
         case kOVERWRITE_: ptr.reset(new OVERWRITE_()); break;
         default: DBG_Assert(false, (<< "Unimplemented operation type: " << aType));
     }
+    ptr->theKernel = executeKernel(aType, ptr->theKernelSetsFlags);
     return ptr;
 }
 
@@ -2,6 +2,7 @@
 #ifndef FLEXUS_DECODER_SEMANTICACTIONS_HPP_INCLUDED
 #define FLEXUS_DECODER_SEMANTICACTIONS_HPP_INCLUDED
 
+#include "ExecuteKernels.hpp"
 #include "SemanticInstruction.hpp"
 #include <cstdint>
 
@@ -61,11 +62,13 @@ struct Operation
       : theNZCVFlags{ false }
       , the128{ false }
       , theSize{ aSize }
+      , theKernel{ nullptr }
+      , theKernelSetsFlags{ false }
     {
     }
     virtual ~Operation() {}
-    virtual Operand operator()(std::vector<Operand> const& operands) = 0;
-    virtual Operand evalExtra(std::vector<Operand> const& operands) { return (uint64_t)0; }
+    virtual Operand operator()(OperandSpan operands) = 0;
+    virtual Operand evalExtra(OperandSpan operands) { return (uint64_t)0; }
     virtual char const* describe() const = 0;
 
     void setOperands(Operand aValue) { theOperands.push_back(aValue); }
@@ -80,6 +83,10 @@ struct Operation
     SemanticInstruction* theInstruction;
     bool the128;
     uint32_t theSize;
+
+    // Direct implementation over native operands, see ExecuteKernels.hpp
+    execute_kernel theKernel;
+    bool theKernelSetsFlags;
 };
 
 std::unique_ptr<Operation>
@@ -56,12 +56,21 @@ struct ExecuteBase : public PredicatedSemanticAction
     }
 
     Operand op(eOperandCode aCode) { return theInstruction->operand(aCode); }
+
+    // Copies the source operands into aBuffer, on the caller's stack
+    OperandSpan gather(std::array<Operand, 5>& aBuffer)
+    {
+        for (int32_t i = 0; i < numOperands(); ++i) {
+            aBuffer[i] = op(theOperands[i]);
+        }
+        return OperandSpan(aBuffer.data(), numOperands());
+    }
 };
 
 struct OperandPrintHelper
 {
-    std::vector<Operand>& theOperands;
-    OperandPrintHelper(std::vector<Operand>& operands)
+    OperandSpan theOperands;
+    OperandPrintHelper(OperandSpan operands)
       : theOperands(operands)
     {
     }
@@ -91,6 +100,31 @@ struct ExecuteAction : public ExecuteBase
         theInstruction->setExecuted(false);
     }
 
+    // Evaluates the operation through its execute kernel. Returns false, before
+    // any side effect, if there is no kernel or an operand is not a uint64_t.
+    bool executeKernel()
+    {
+        if (!theOperation->theKernel || !theOperation->theOperands.empty()) return false;
+
+        uint64_t values[5];
+        for (int32_t i = 0; i < numOperands(); ++i) {
+            uint64_t const* value = boost::get<uint64_t>(&theInstruction->operand(theOperands[i]));
+            if (!value) return false;
+            values[i] = *value;
+        }
+
+        KernelResult result = theOperation->theKernel(values, numOperands());
+        if (theOperation->theKernelSetsFlags) { theInstruction->setOperand(kResultCC, (uint64_t)result.theNZCV); }
+        theInstruction->setOperand(theResult, result.theValue);
+        DBG_(VVerb, (<< *this << " kernel result=" << std::hex << result.theValue << std::dec));
+
+        if (theBypass) {
+            mapped_reg name = theInstruction->operand<mapped_reg>(*theBypass);
+            core()->bypass(name, register_value(result.theValue));
+        }
+        return true;
+    }
+
     void doEvaluate()
     {
 
@@ -100,11 +134,12 @@ struct ExecuteAction : public ExecuteBase
 
             DBG_(VVerb, (<< "Executing " << *this));
 
-            if (theInstruction->hasPredecessorExecuted()) {
-                std::vector<Operand> operands;
-                for (int32_t i = 0; i < numOperands(); ++i) {
-                    operands.push_back(op(theOperands[i]));
-                }
+            if (theInstruction->hasPredecessorExecuted() && executeKernel()) {
+                satisfyDependants();
+                theInstruction->setExecuted(true);
+            } else if (theInstruction->hasPredecessorExecuted()) {
+                std::array<Operand, 5> buffer;
+                OperandSpan operands = gather(buffer);
 
                 theOperation->theInstruction = theInstruction;
                 Operand result               = theOperation->operator()(operands);
@@ -172,10 +207,8 @@ struct ExecuteAction_WithXTRA : public ExecuteBase
     {
         if (ready()) {
             if (theInstruction->hasPredecessorExecuted()) {
-                std::vector<Operand> operands;
-                for (int32_t i = 0; i < numOperands(); ++i) {
-                    operands.push_back(op(theOperands[i]));
-                }
+                std::array<Operand, 5> buffer;
+                OperandSpan operands = gather(buffer);
 
                 Operand result = theOperation->operator()(operands);
                 Operand xtra   = theOperation->evalExtra(operands);
@@ -227,10 +260,8 @@ struct FPExecuteAction : public ExecuteBase
     {
         if (ready()) {
             if (theInstruction->hasPredecessorExecuted()) {
-                std::vector<Operand> operands;
-                for (int32_t i = 0; i < numOperands(); ++i) {
-                    operands.push_back(op(theOperands[i]));
-                }
+                std::array<Operand, 5> buffer;
+                OperandSpan operands = gather(buffer);
 
                 //        theOperation.setContext( core()->getRoundingMode() )
                 Operand result = theOperation->operator()(operands);
@@ -54,7 +54,8 @@ struct ExtendAction : public PredicatedSemanticAction
 
             Operand aValue = theInstruction->operand(theRegisterCode);
 
-            aValue = theExtendOperation->operator()({ aValue });
+            Operand operands[] = { aValue };
+            aValue             = theExtendOperation->operator()(operands);
 
             bits val = boost::get<bits>(aValue);
 
@@ -55,7 +55,8 @@ struct ShiftRegisterAction : public PredicatedSemanticAction
         if (ready()) {
             Operand aValue = theInstruction->operand(theRegisterCode);
 
-            aValue = theShiftOperation->operator()({ aValue, theShiftAmount });
+            Operand operands[] = { aValue, theShiftAmount };
+            aValue             = theShiftOperation->operator()(operands);
 
             uint64_t val = boost::get<uint64_t>(aValue);
 
@@ -105,8 +105,14 @@ SemanticInstruction::makeInstructionDependance(InternalDependance const& aDepend
     DBG_Assert(reinterpret_cast<long>(aDependance.theTarget) != 0x1);
     nuArch::InstructionDependance ret_val;
     ret_val.instruction = boost::intrusive_ptr<nuArch::Instruction>(this);
-    ret_val.satisfy     = boost::bind(&DependanceTarget::invokeSatisfy, aDependance.theTarget, aDependance.theArg);
-    ret_val.squash      = boost::bind(&DependanceTarget::invokeSquash, aDependance.theTarget, aDependance.theArg);
+    ret_val.theTarget   = aDependance.theTarget;
+    ret_val.theArg      = aDependance.theArg;
+    ret_val.theSatisfy  = [](void* aTarget, int32_t anArg) {
+        static_cast<DependanceTarget*>(aTarget)->invokeSatisfy(anArg);
+    };
+    ret_val.theSquash = [](void* aTarget, int32_t anArg) {
+        static_cast<DependanceTarget*>(aTarget)->invokeSquash(anArg);
+    };
     return ret_val;
 }
 
@@ -12,6 +12,13 @@ COMPONENT_PARAMETERS(
   PARAMETER( Threads, uint32_t, "Number of threads under control of this FAG", "threads", 1 )
   PARAMETER( BTBSets, uint32_t, "Number of sets in the BTB", "btbsets", 512 )
   PARAMETER( BTBWays, uint32_t, "Number of ways in the BTB", "btbways", 4 )
+  PARAMETER( TageTables, int, "Number of TAGE tagged tables", "tage_tables", 7 )
+  PARAMETER( TageLogBimodal, int, "Log2 of the TAGE bimodal table entries", "tage_logb", 13 )
+  PARAMETER( TageLogTagged, int, "Log2 of the entries of each TAGE tagged table", "tage_logg", 9 )
+  PARAMETER( TageTagBits, int, "Tag bits of the longest-history TAGE table", "tage_tbits", 12 )
+  PARAMETER( TageCounterBits, int, "Bits per TAGE tagged prediction counter", "tage_cbits", 3 )
+  PARAMETER( TageMaxHistory, int, "Longest TAGE global history length (plus one)", "tage_maxhist", 131 )
+  PARAMETER( TageMinHistory, int, "Shortest TAGE global history length", "tage_minhist", 5 )
 );
 
 COMPONENT_INTERFACE(
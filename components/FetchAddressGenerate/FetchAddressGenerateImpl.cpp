@@ -14,6 +14,8 @@
 #include <components/MTManager/MTManager.hpp>
 #include <core/flexus.hpp>
 #include <core/qemu/mai_api.hpp>
+#include <core/sampling.hpp>
+#include <core/warming.hpp>
 
 namespace nFetchAddressGenerate {
 
@@ -23,6 +25,7 @@ using namespace Core;
 typedef Flexus::SharedTypes::VirtualMemoryAddress MemoryAddress;
 
 class FLEXUS_COMPONENT(FetchAddressGenerate)
+  , public Warming::Observer
 {
     FLEXUS_COMPONENT_IMPL(FetchAddressGenerate);
 
@@ -31,6 +34,13 @@ class FLEXUS_COMPONENT(FetchAddressGenerate)
     std::vector<bool> theRedirect;
     std::unique_ptr<BranchPredictor> theBranchPredictor;
     uint32_t theCurrentThread;
+    boost::intrusive_ptr<FetchCommand> theFetchCommand;
+
+    // The last instruction QEMU fetched while warming, resolved by the next
+    // fetch of the same fast-forward
+    MemoryAddress theWarmPC;
+    eBranchType theWarmType;
+    uint64_t theWarmEpoch;
 
   public:
     FLEXUS_COMPONENT_CONSTRUCTOR(FetchAddressGenerate)
@@ -50,8 +60,36 @@ class FLEXUS_COMPONENT(FetchAddressGenerate)
             theRedirectPC[i] = MemoryAddress(0);
             theRedirect[i]   = false;
         }
-        theCurrentThread   = cfg.Threads;
-        theBranchPredictor = std::make_unique<BranchPredictor>(statName(), flexusIndex(), cfg.BTBSets, cfg.BTBWays);
+        theCurrentThread = cfg.Threads;
+        theFetchCommand  = new FetchCommand();
+        theFetchCommand->theFetches.reserve(cfg.MaxFetchAddress);
+
+        TageGeometry tage;
+        tage.LOGB          = cfg.TageLogBimodal;
+        tage.NHIST         = cfg.TageTables;
+        tage.LOGG          = cfg.TageLogTagged;
+        tage.TBITS         = cfg.TageTagBits;
+        tage.CBITS         = cfg.TageCounterBits;
+        tage.MAXHIST       = cfg.TageMaxHistory;
+        tage.MINHIST       = cfg.TageMinHistory;
+        Flexus::Core::ComponentArena::Scope tables(coreArena());
+        theBranchPredictor = std::make_unique<BranchPredictor>(statName(), flexusIndex(), cfg.BTBSets, cfg.BTBWays, tage);
+
+        theWarmType  = kNonBranch;
+        theWarmEpoch = ~0ULL;
+        Warming::observe(flexusIndex(), this);
+    }
+
+    void warm(Warming::Reference const& aReference) override
+    {
+        if (aReference.theAccess != Warming::kFetch) return;
+
+        if (theWarmEpoch == Sampling::epoch()) {
+            theBranchPredictor->warm(theWarmPC, theWarmType, MemoryAddress(aReference.thePC));
+        }
+        theWarmPC     = MemoryAddress(aReference.thePC);
+        theWarmType   = (aReference.theBranchType < kLastBranchType ? eBranchType(aReference.theBranchType) : kNonBranch);
+        theWarmEpoch  = Sampling::epoch();
     }
 
     void finalize() {}
@@ -142,10 +180,28 @@ class FLEXUS_COMPONENT(FetchAddressGenerate)
         if (available_faq == 0) DBG_(VVerb, (<< "FGU: available FAQ is empty"));
 
         //    static int test;
-        boost::intrusive_ptr<FetchCommand> fetch(new FetchCommand());
+        boost::intrusive_ptr<FetchCommand> fetch(theFetchCommand);
+        fetch->theFetches.clear();
+
+        // BTB hits for the sequential run of addresses starting at block_pc,
+        // looked up in one sweep and refreshed whenever a branch redirects the PC
+        VirtualMemoryAddress block_pc(0);
+        uint64_t block_branches = 0;
+        int32_t block_left      = 0;
+
         while (max_addrs > 0 /*&& test == 0*/) {
             AGU_DBG("Getting addresses: " << max_addrs << " remaining");
 
+            if (block_left == 0 || block_pc != thePC[anIndex]) {
+                block_pc       = thePC[anIndex];
+                block_left     = std::min(max_addrs, 64);
+                block_branches = theBranchPredictor->branchesInBlock(block_pc, block_left);
+            }
+            bool is_branch = block_branches & 1;
+            block_branches >>= 1;
+            block_pc += 4;
+            --block_left;
+
             FetchAddr faddr(thePC[anIndex]);
             faddr.theBPState->pc = thePC[anIndex];
             faddr.theBPState->thePredCycle = theFlexus->cycleCount();
@@ -154,7 +210,7 @@ class FLEXUS_COMPONENT(FetchAddressGenerate)
             theBranchPredictor->checkpointHistory(*faddr.theBPState);
 
             // Advance the PC
-            if (theBranchPredictor->isBranch(faddr.theAddress)) {
+            if (is_branch) {
                 AGU_DBG("Predicting a Branch");
                 faddr.theBPState->thePredictedType = kUnconditional;
                 if (max_predicts == 0) {
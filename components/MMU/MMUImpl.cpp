@@ -118,8 +118,12 @@ TLB::saveState()
 std::pair<bool, PhysicalMemoryAddress>
 TLB::lookUp(TranslationPtr& tr)
 {
-    VirtualMemoryAddress anAddress = tr->theVaddr;
-    uint16_t anASID                = tr->theASID;
+    return lookUp(tr->theVaddr, tr->theASID);
+}
+
+std::pair<bool, PhysicalMemoryAddress>
+TLB::lookUp(VirtualMemoryAddress anAddress, uint16_t anASID)
+{
     VirtualMemoryAddress anAddressAligned(anAddress & PAGEMASK);
     // Find the set.
     size_t set_idx = (anAddressAligned >> 12) & (theSets - 1);
@@ -144,15 +148,23 @@ TLB::lookUp(TranslationPtr& tr)
 void
 TLB::insert(TranslationPtr& tr)
 {
-    bool aNG        = tr->theNG;
-    uint16_t anASID = tr->theASID;
-    VirtualMemoryAddress alignedVirtualAddr(tr->theVaddr & PAGEMASK);
-    PhysicalMemoryAddress alignedPhysicalAddr(tr->thePaddr & PAGEMASK);
     if (tr->isPagefault()) {
         if (tr->inTraceMode) return;
-        faultyEntry = TLBentry(alignedVirtualAddr, alignedPhysicalAddr, 0, anASID, aNG);
+        faultyEntry = TLBentry(VirtualMemoryAddress(tr->theVaddr & PAGEMASK),
+                               PhysicalMemoryAddress(tr->thePaddr & PAGEMASK),
+                               0,
+                               tr->theASID,
+                               tr->theNG);
         return;
     }
+    insert(tr->theVaddr, tr->thePaddr, tr->theASID, tr->theNG);
+}
+
+void
+TLB::insert(VirtualMemoryAddress aVaddr, PhysicalMemoryAddress aPaddr, uint16_t anASID, bool aNG)
+{
+    VirtualMemoryAddress alignedVirtualAddr(aVaddr & PAGEMASK);
+    PhysicalMemoryAddress alignedPhysicalAddr(aPaddr & PAGEMASK);
     size_t set_idx = (alignedVirtualAddr >> 12) & (theSets - 1);
     // Check if the virtual address is in TLB (with the same ASID or as a global entry)
     auto iter  = theTLB[set_idx].end();
@@ -335,11 +347,16 @@ MMUComponent::initialize()
     thePageWalker.reset(new PageWalk(flexusIndex(), this));
     mmu_is_init = false;
 
-    theInstrTLB.resize(cfg.iTLBAssoc, cfg.iTLBSet);
-    theDataTLB.resize(cfg.dTLBAssoc, cfg.dTLBSet);
-    theSecondTLB.resize(cfg.sTLBAssoc, cfg.sTLBSet);
+    {
+        Flexus::Core::ComponentArena::Scope tables(coreArena());
+        theInstrTLB.resize(cfg.iTLBAssoc, cfg.iTLBSet);
+        theDataTLB.resize(cfg.dTLBAssoc, cfg.dTLBSet);
+        theSecondTLB.resize(cfg.sTLBAssoc, cfg.sTLBSet);
+    }
 
     if (cfg.PerfectTLB) { PAGEMASK = ~((1ULL << 12) - 1); }
+
+    Warming::observe(flexusIndex(), this);
 }
 
 void
@@ -372,8 +389,9 @@ MMUComponent::busCycle()
         DBG_(VVerb, (<< "Item is " << (item->isInstr() ? "Instruction" : "Data") << " entry " << item->theVaddr));
 
         std::pair<bool, PhysicalMemoryAddress> entry = (item->isInstr() ? theInstrTLB : theDataTLB).lookUp(item);
-        if (cfg.PerfectTLB || !mmu_is_init) {
-            PhysicalMemoryAddress perfectPaddr(API::qemu_api.translate_va2pa(flexusIndex(), item->theVaddr, (item->getInstruction() ? item->getInstruction()->unprivAccess(): false)));
+        bool perfect                                 = cfg.PerfectTLB || !mmu_is_init;
+        if (perfect) {
+            PhysicalMemoryAddress perfectPaddr(theCPU.translate_va2pa(item->theVaddr, (item->getInstruction() ? item->getInstruction()->unprivAccess(): false)));
             entry.first  = true;
             entry.second = perfectPaddr;
             if (perfectPaddr == 0xFFFFFFFFFFFFFFFF) item->setPagefault();
@@ -390,7 +408,8 @@ MMUComponent::busCycle()
 
             // item exists so mark hit
             item->setHit();
-            PhysicalMemoryAddress perfectPaddr(API::qemu_api.translate_va2pa(flexusIndex(), item->theVaddr, (item->getInstruction() ? item->getInstruction()->unprivAccess(): false)));
+            // A perfect lookup already holds QEMU's translation
+            PhysicalMemoryAddress perfectPaddr(perfect ? entry.second : theCPU.translate_va2pa(item->theVaddr, (item->getInstruction() ? item->getInstruction()->unprivAccess(): false)));
             // item->thePaddr = (PhysicalMemoryAddress)(entry.second | (item->theVaddr & ~(PAGEMASK)));
             item->thePaddr = perfectPaddr;
 
@@ -416,7 +435,7 @@ MMUComponent::busCycle()
                     thePageWalkEntries.push(item);
                 } else {
                     PhysicalMemoryAddress perfectPaddr(
-                        API::qemu_api.translate_va2pa(flexusIndex(), item->theVaddr, (item->getInstruction() ? item->getInstruction()->unprivAccess(): false)));
+                        theCPU.translate_va2pa(item->theVaddr, (item->getInstruction() ? item->getInstruction()->unprivAccess(): false)));
                     item->setHit();
                     item->thePaddr = perfectPaddr;
                     if (item->isInstr())
@@ -601,6 +620,21 @@ MMUComponent::push(interface::TLBReqIn const&, index_t anIndex, TranslationPtr&
     (aTranslate->isInstr() ? theInstrTLB : theDataTLB).insert(aTranslate);
 }
 
+void
+MMUComponent::warm(Warming::Reference const& aReference)
+{
+    if (cfg.PerfectTLB) return;
+    if (!mmu_is_init) mmu_is_init = cfg_mmu(flexusIndex());
+    if (!mmu_is_init) return;
+
+    // QEMU already translated the reference: the TLB gets the entry a walk
+    // would have found, with the ASID and non-global bit of a timing lookup
+    TLB& tlb = (aReference.theAccess == Warming::kFetch ? theInstrTLB : theDataTLB);
+    VirtualMemoryAddress vaddr(aReference.theVirtual);
+    uint16_t asid = getASID();
+    if (!tlb.lookUp(vaddr, asid).first) tlb.insert(vaddr, PhysicalMemoryAddress(aReference.thePhysical), asid, true);
+}
+
 } // End Namespace nMMU
 
 FLEXUS_COMPONENT_INSTANTIATOR(MMU, nMMU);
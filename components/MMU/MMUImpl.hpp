@@ -14,6 +14,7 @@
 #include <components/MMU/MMU.hpp>
 #include <core/performance/profile.hpp>
 #include <core/qemu/configuration_api.hpp>
+#include <core/warming.hpp>
 
 #define FLEXUS_BEGIN_COMPONENT MMU
 #include FLEXUS_BEGIN_COMPONENT_IMPLEMENTATION()
@@ -61,7 +62,9 @@ struct TLB
     void loadState(json checkpoint);
     json saveState();
     std::pair<bool, PhysicalMemoryAddress> lookUp(TranslationPtr& tr);
+    std::pair<bool, PhysicalMemoryAddress> lookUp(VirtualMemoryAddress anAddress, uint16_t anASID);
     void insert(TranslationPtr& tr);
+    void insert(VirtualMemoryAddress aVaddr, PhysicalMemoryAddress aPaddr, uint16_t anASID, bool aNG);
     void resize(size_t set, size_t associativity);
     size_t capacity();
     void clear();
@@ -80,6 +83,7 @@ struct TLB
 };
 
 class FLEXUS_COMPONENT(MMU)
+  , public Flexus::Core::Warming::Observer
 {
   public:
     TLB theInstrTLB;
@@ -154,6 +158,9 @@ class FLEXUS_COMPONENT(MMU)
     bool available(interface::TLBReqIn const&, index_t anIndex);
     void push(interface::TLBReqIn const&, index_t anIndex, TranslationPtr& aTranslate);
 
+    // Fills the first-level TLBs from QEMU's references while it fast-forwards
+    void warm(Flexus::Core::Warming::Reference const& aReference) override;
+
     friend class PageWalk;
 };
 }
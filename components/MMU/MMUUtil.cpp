@@ -111,19 +111,24 @@ mmu_t::init_mmu_regs(std::size_t core_index)
      *      supporting well EL2 (hypervisor) mode well.
      */
 
-    //? sctlr_el0 does not exist
-    mmu_regs.SCTLR[EL1] = cpu.read_register(Qemu::API::SCTLR, EL1);
+    // All read in a single crossing into QEMU
+    Qemu::API::register_read_t regs[] = {
+        { Qemu::API::SCTLR, EL1, 0 }, //? sctlr_el0 does not exist
+        { Qemu::API::TCR, EL1, 0 },   //? tcr_el0 does not exist
+        //? Section G8.2.167 - TTBR0, Translation Table Base Register 0
+        //? Section G8.2.168 - TTBR1, Translation Table Base Register 1
+        { Qemu::API::TTBR0, EL1, 0 },
+        { Qemu::API::TTBR1, EL1, 0 },
+        //? Section D23.2.74 - AArch64 Memory Model Feature Register 0
+        { Qemu::API::ID_AA64MMFR0, EL1, 0 },
+    };
+    cpu.read_registers(regs, sizeof(regs) / sizeof(regs[0]));
 
-    //? tcr_el0 does not exist
-    mmu_regs.TCR[EL1] = cpu.read_register(Qemu::API::TCR, EL1);
-
-    //? Section G8.2.167 - TTBR0, Translation Table Base Register 0
-    //? Section G8.2.168 - TTBR1, Translation Table Base Register 1
-    mmu_regs.TTBR0[EL1] = cpu.read_register(Qemu::API::TTBR0, EL1);
-    mmu_regs.TTBR1[EL1] = cpu.read_register(Qemu::API::TTBR1, EL1);
-
-    //? Section D23.2.74 - AArch64 Memory Model Feature Register 0
-    mmu_regs.ID_AA64MMFR0_EL1 = cpu.read_register(Qemu::API::ID_AA64MMFR0, EL1);
+    mmu_regs.SCTLR[EL1]       = regs[0].value;
+    mmu_regs.TCR[EL1]         = regs[1].value;
+    mmu_regs.TTBR0[EL1]       = regs[2].value;
+    mmu_regs.TTBR1[EL1]       = regs[3].value;
+    mmu_regs.ID_AA64MMFR0_EL1 = regs[4].value;
 
     fm_print_mmu_regs(&mmu_regs);
 
@@ -51,10 +51,13 @@ PageWalk::preWalk(TranslationTransport& aTranslation)
     DBG_(VVerb, (<< "preWalking " << basicPointer->theVaddr));
 
     if (statefulPointer->currentLookupLevel == 0) {
-        PhysicalMemoryAddress magicPaddr(API::qemu_api.translate_va2pa(theNode, basicPointer->theVaddr, (basicPointer->getInstruction() ? basicPointer->getInstruction()->unprivAccess(): false)));
+        // Only asks QEMU when the message is printed
         DBG_(VVerb,
              (<< " QEMU Translated: " << std::hex << basicPointer->theVaddr << std::dec << ", to: " << std::hex
-              << magicPaddr << std::dec));
+              << PhysicalMemoryAddress(mmu->theCPU.translate_va2pa(
+                   basicPointer->theVaddr,
+                   (basicPointer->getInstruction() ? basicPointer->getInstruction()->unprivAccess() : false)))
+              << std::dec));
     }
     PhysicalMemoryAddress TTEDescriptor(statefulPointer->TTAddressResolver->resolve(basicPointer->theVaddr));
     DBG_(VVerb,
@@ -335,7 +338,7 @@ PageWalk::cycle()
                      (<< "stlb hit " << (VirtualMemoryAddress)(tr->theVaddr & (PAGEMASK)) << ":" << tr->theID
                       << std::hex << ":" << res.second));
                 tr->setHit();
-                PhysicalMemoryAddress perfectPaddr(API::qemu_api.translate_va2pa(mmu->flexusIndex(), tr->theVaddr, (tr->getInstruction() ? tr->getInstruction()->unprivAccess(): false)));
+                PhysicalMemoryAddress perfectPaddr(mmu->theCPU.translate_va2pa(tr->theVaddr, (tr->getInstruction() ? tr->getInstruction()->unprivAccess(): false)));
                 // tr->thePaddr = (PhysicalMemoryAddress)(res.second | (tr->theVaddr & ~(PAGEMASK)));
                 tr->thePaddr = perfectPaddr;
                 mmu->stlb_accesses++;
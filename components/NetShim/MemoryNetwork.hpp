@@ -8,7 +8,7 @@
 #include <components/CommonQEMU/Transports/MemoryTransport.hpp>
 
 COMPONENT_PARAMETERS(
-  FLEXUS_PARAMETER( NetworkTopologyFile, std::string, "Network topology file", "topology-file", "" )
+  FLEXUS_PARAMETER( NetworkTopologyFile, std::string, "Network topology file, BuildMesh or generate:<kind>:<dims>[:<nodes per router>][:<routing>]", "topology-file", "" )
   FLEXUS_PARAMETER( NumNodes, int, "Number of Nodes", "nodes", 2)
   FLEXUS_PARAMETER( VChannels, int, "Number of virtual channels", "virtual-channels", 3)
 );
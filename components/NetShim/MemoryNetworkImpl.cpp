@@ -84,6 +84,16 @@ class FLEXUS_COMPONENT(MemoryNetwork)
             if (nc->buildMesh()) {
                 throw Flexus::Core::FlexusException("Error building the network");
             }
+        } else if (TopologySpec::isGenerated(cfg.NetworkTopologyFile)) {
+            TopologySpec topo;
+            if (TopologySpec::parse(cfg.NetworkTopologyFile, topo) || nc->buildTopology(topo)) {
+                throw Flexus::Core::FlexusException("Error building the network");
+            }
+            // Otherwise some routes lead to missing ports or some nodes are
+            // unreachable
+            DBG_Assert(nc->getNumNodes() == cfg.NumNodes,
+                       (<< "Topology " << cfg.NetworkTopologyFile << " has " << nc->getNumNodes()
+                        << " nodes, but the network is configured with " << cfg.NumNodes));
         } else if (nc->buildNetwork(cfg.NetworkTopologyFile.c_str())) {
             throw Flexus::Core::FlexusException("Error building the network");
         }
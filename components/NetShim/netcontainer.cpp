@@ -4,6 +4,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <stdlib.h>
 #include <string.h>
 
 namespace nNetShim {
@@ -75,144 +76,262 @@ NetContainer::NetContainer(void)
 {
 }
 
-bool NetContainer::buildMesh() {
-  // fixed for now
-  channelLatency = 3;
-  channelLatencyData = 4;
-  channelLatencyControl = 1;
-  localChannelLatencyDivider = 1;
-  switchInputBuffers = 6;
-  switchOutputBuffers = 6;
-  switchInternalBuffersPerVC = 6;
+bool
+TopologySpec::isGenerated(const std::string& aSpec)
+{
+    return aSpec.compare(0, 9, "generate:") == 0;
+}
 
-  numSwitches = Flexus::Core::ComponentManager::getComponentManager().systemWidth();
+bool
+TopologySpec::parse(const std::string& aSpec, TopologySpec& topo)
+{
+    std::vector<std::string> fields;
+    std::string::size_type start = 0, end;
+    while ((end = aSpec.find(':', start)) != std::string::npos) {
+        fields.push_back(aSpec.substr(start, end - start));
+        start = end + 1;
+    }
+    fields.push_back(aSpec.substr(start));
 
-  numNodes = numSwitches * 3;
-  switchPorts = 7; // 3 ports from/to node and 4 ports for up/down/left/right
-  switchBandwidth = 4;
+    if (fields.size() < 3 || fields.size() > 5 || fields[0] != "generate") {
+        std::cerr << "NetShim: malformed topology specification \"" << aSpec
+                  << "\", expected generate:<kind>:<dims>[:<nodes per router>][:<routing>]" << endl;
+        return true;
+    }
 
-  if (allocateNetworkStructures())
-    return true;
+    if (fields[1] == "mesh") {
+        topo.kind = kMesh;
+    } else if (fields[1] == "torus") {
+        topo.kind = kTorus;
+    } else if (fields[1] == "ring") {
+        topo.kind = kRing;
+    } else if (fields[1] == "fbfly") {
+        topo.kind = kFlattenedButterfly;
+    } else {
+        std::cerr << "NetShim: unknown topology kind \"" << fields[1] << "\"" << endl;
+        return true;
+    }
 
-  // nodes to switches
-  for (int i = 0; i < numNodes; i++) {
-    auto s = i % numSwitches;
-    auto p = i / numSwitches;
+    topo.dims.clear();
+    start = 0;
+    do {
+        end       = fields[2].find('x', start);
+        int32_t k = atoi(fields[2].substr(start, end - start).c_str());
+        if (k <= 0) {
+            std::cerr << "NetShim: invalid topology dimensions \"" << fields[2] << "\"" << endl;
+            return true;
+        }
+        topo.dims.push_back(k);
+        start = end + 1;
+    } while (end != std::string::npos);
 
-    if (attachNodeChannels(this, i))
-      return true;
-    if (attachSwitchChannels(this, s, p, true))
-      return true;
-    if (switches[s]->setLocalDelayOnly(p))
-      return true;
+    if (topo.kind == kRing && topo.dims.size() != 1) {
+        std::cerr << "NetShim: a ring has a single dimension" << endl;
+        return true;
+    }
+
+    topo.nodesPerRouter = 3;
+    topo.routing        = (topo.kind == kMesh) ? kO1Turn : kDimensionOrder;
+
+    for (size_t i = 3; i < fields.size(); i++) {
+        if (fields[i] == "dor") {
+            topo.routing = kDimensionOrder;
+        } else if (fields[i] == "o1turn") {
+            topo.routing = kO1Turn;
+        } else if ((topo.nodesPerRouter = atoi(fields[i].c_str())) <= 0) {
+            std::cerr << "NetShim: invalid topology option \"" << fields[i] << "\"" << endl;
+            return true;
+        }
+    }
+
+    // Both network VCs are taken by the dateline on rings and tori
+    if ((topo.kind == kTorus || topo.kind == kRing) && topo.routing == kO1Turn) {
+        std::cerr << "NetShim: o1turn routing is only supported on meshes and flattened butterflies" << endl;
+        return true;
+    }
+
+    return false;
+}
+
+bool
+NetContainer::buildMesh()
+{
+    int32_t width = Flexus::Core::ComponentManager::getComponentManager().systemWidth();
+
+    // switches to switches
+    int col = -1;
+    int row = -1;
+
+    // ad hoc
+    for (int i = 1; i < 9; i++)
+        for (int j = 1; j < 3; j++)
+            if (i * i * j == width) {
+                col = i * j;
+                row = i;
+                break;
+            }
+
+    assert(col >= 0);
+
+    TopologySpec topo;
+    topo.kind           = TopologySpec::kMesh;
+    topo.dims           = { col, row };
+    topo.nodesPerRouter = 3;
+    topo.routing        = TopologySpec::kO1Turn;
+
+    return buildTopology(topo);
+}
+
+int32_t
+NetContainer::dimensionPort(const TopologySpec& topo, const int32_t dim, const int32_t from, const int32_t to) const
+{
+    int32_t base = topo.nodesPerRouter;
+
+    // Flattened butterfly: one port per peer in each dimension
+    if (topo.kind == TopologySpec::kFlattenedButterfly) {
+        for (int32_t d = 0; d < dim; d++)
+            base += topo.dims[d] - 1;
+        return base + ((to < from) ? to : to - 1);
+    }
+
+    // Mesh/torus: a (minus, plus) pair per dimension, highest dimension first,
+    // which gives the up/down/left/right layout of the original 2D mesh.
+    base += 2 * (topo.dims.size() - 1 - dim);
+
+    bool plus;
+    if (topo.kind == TopologySpec::kMesh || topo.dims[dim] <= 2) {
+        plus = to > from;
+    } else {
+        plus = to == (from + 1) % topo.dims[dim];
+    }
+    return base + (plus ? 1 : 0);
+}
+
+bool
+NetContainer::linkSwitches(const int32_t from, const int32_t fromPort, const int32_t to, const int32_t toPort)
+{
+    if (attachSwitchChannels(this, from, fromPort, false)) return true;
+    if (attachSwitchChannels(this, to, toPort, true)) return true;
 
     maxChannelIndex += 2;
-  }
+    return false;
+}
+
+bool
+NetContainer::addGeneratedRoute(const TopologySpec& topo,
+                                const int32_t sw,
+                                const int32_t node,
+                                const bool ascending,
+                                const int32_t vc)
+{
+    const int32_t target = node % numSwitches;
+    const int32_t nd     = topo.dims.size();
+
+    for (int32_t i = 0; i < nd; i++) {
+        int32_t d = ascending ? i : nd - 1 - i;
+
+        int32_t stride = 1;
+        for (int32_t j = 0; j < d; j++)
+            stride *= topo.dims[j];
+
+        const int32_t k = topo.dims[d];
+        const int32_t c = (sw / stride) % k;
+        const int32_t t = (target / stride) % k;
 
-#define U 3
-#define D 4
-#define L 5
-#define R 6
+        if (c == t) continue;
 
-  // switches to switches
-  int col = -1;
-  int row = -1;
+        int32_t next, hopVC = vc;
+        if (topo.kind == TopologySpec::kFlattenedButterfly) {
+            next = t;
+        } else if (topo.kind == TopologySpec::kMesh || k <= 2) {
+            next = (c < t) ? c + 1 : c - 1;
+        } else {
+            // Shortest way around, with a dateline: VC 0 up to and including
+            // the wraparound link, VC 1 afterwards.
+            bool plus = ((t - c + k) % k) <= k / 2;
+            next      = plus ? (c + 1) % k : (c + k - 1) % k;
+            hopVC     = (plus ? (c > t) : (c < t)) ? 0 : 1;
+        }
 
-  // ad hoc
-  for (int i = 1; i < 9; i++)
-    for (int j = 1; j < 3; j++)
-      if (i * i * j == numSwitches) {
-        col = i * j;
-        row = i;
-        break;
-      }
+        return switches[sw]->addRoutingEntry(node, dimensionPort(topo, d, c, next), hopVC);
+    }
 
-  assert(col >= 0);
+    // Arrived: eject through the local port of the node
+    return switches[sw]->addRoutingEntry(node, node / numSwitches, vc);
+}
 
-  int col_m1 = col - 1;
-  int row_m1 = row - 1;
+bool
+NetContainer::buildTopology(const TopologySpec& topo)
+{
+    // fixed for now
+    channelLatency             = 3;
+    channelLatencyData         = 4;
+    channelLatencyControl      = 1;
+    localChannelLatencyDivider = 1;
+    switchInputBuffers         = 6;
+    switchOutputBuffers        = 6;
+    switchInternalBuffersPerVC = 6;
+    switchBandwidth            = 4;
+
+    const int32_t nd = topo.dims.size();
+
+    numSwitches = 1;
+    switchPorts = topo.nodesPerRouter;
+    for (int32_t d = 0; d < nd; d++) {
+        numSwitches *= topo.dims[d];
+        switchPorts += (topo.kind == TopologySpec::kFlattenedButterfly) ? topo.dims[d] - 1 : 2;
+    }
+    numNodes = numSwitches * topo.nodesPerRouter;
 
-  for (int i = 0; i < row; i++)
-    for (int j = 0; j < col; j++) {
-      auto s = i * col + j;
+    if (validateParameters() || allocateNetworkStructures()) return true;
 
-      if (j < col_m1) {
-        auto r = s + 1;
+    // nodes to switches
+    for (int i = 0; i < numNodes; i++) {
+        auto s = i % numSwitches;
+        auto p = i / numSwitches;
 
-        if (attachSwitchChannels(this, s, R, false))
-          return true;
-        if (attachSwitchChannels(this, r, L, true))
-          return true;
+        if (attachNodeChannels(this, i)) return true;
+        if (attachSwitchChannels(this, s, p, true)) return true;
+        if (switches[s]->setLocalDelayOnly(p)) return true;
 
         maxChannelIndex += 2;
-      }
+    }
 
-      if (i < row_m1) {
-        auto d = s + col;
+    // switches to switches, each link is created once from its lower end
+    for (int32_t s = 0; s < numSwitches; s++) {
+        int32_t stride = 1;
+        for (int32_t d = 0; d < nd; stride *= topo.dims[d], d++) {
+            const int32_t k = topo.dims[d];
+            const int32_t c = (s / stride) % k;
+
+            if (topo.kind == TopologySpec::kFlattenedButterfly) {
+                for (int32_t p = c + 1; p < k; p++) {
+                    if (linkSwitches(s, dimensionPort(topo, d, c, p), s + (p - c) * stride, dimensionPort(topo, d, p, c)))
+                        return true;
+                }
+            } else if (c + 1 < k) {
+                if (linkSwitches(s, dimensionPort(topo, d, c, c + 1), s + stride, dimensionPort(topo, d, c + 1, c)))
+                    return true;
+            } else if (topo.kind != TopologySpec::kMesh && k > 2) {
+                // wraparound
+                if (linkSwitches(s, dimensionPort(topo, d, c, 0), s - c * stride, dimensionPort(topo, d, 0, c)))
+                    return true;
+            }
+        }
+    }
 
-        if (attachSwitchChannels(this, s, D, false))
-          return true;
-        if (attachSwitchChannels(this, d, U, true))
-          return true;
+    // routes: dimension order on VC 0, plus the reverse order on VC 1 for
+    // O1TURN (the switch falls back to it when VC 0 is busy).
+    for (int32_t s = 0; s < numSwitches; s++) {
+        for (int32_t n = 0; n < numNodes; n++) {
+            if (addGeneratedRoute(topo, s, n, true, 0)) return true;
+            if (topo.routing == TopologySpec::kO1Turn && addGeneratedRoute(topo, s, n, false, 1)) return true;
+        }
+    }
 
-        maxChannelIndex += 2;
-      }
-    }
-
-  // routes
-  for (int i = 0; i < numSwitches; i++) {
-    auto c = i % col;
-    auto r = i / col;
-
-    for (int j = 0; j < numNodes; j++) {
-      auto s  = j % numSwitches;
-      auto p  = j / numSwitches;
-
-      auto cc = s % col;
-      auto rr = s / col;
-
-      // x-y
-      if (c < cc) {
-        if (switches[i]->addRoutingEntry(j, R, 0))
-          return true;
-      } else if (c > cc) {
-        if (switches[i]->addRoutingEntry(j, L, 0))
-          return true;
-      } else if (r < rr) {
-        if (switches[i]->addRoutingEntry(j, D, 0))
-          return true;
-      } else if (r > rr) {
-        if (switches[i]->addRoutingEntry(j, U, 0))
-          return true;
-      } else {
-        if (switches[i]->addRoutingEntry(j, p, 0))
-          return true;
-      }
-
-      // y-x
-      if (r < rr) {
-        if (switches[i]->addRoutingEntry(j, D, 1))
-          return true;
-      } else if (r > rr) {
-        if (switches[i]->addRoutingEntry(j, U, 1))
-          return true;
-      } else if (c < cc) {
-        if (switches[i]->addRoutingEntry(j, R, 1))
-          return true;
-      } else if (c > cc) {
-        if (switches[i]->addRoutingEntry(j, L, 1))
-          return true;
-      } else {
-        if (switches[i]->addRoutingEntry(j, p, 1))
-          return true;
-      }
-    }
-  }
-
-  return false;
+    return validateNetwork();
 }
 
-
 bool
 NetContainer::buildNetwork(const char* filename)
 {
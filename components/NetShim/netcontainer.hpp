@@ -9,10 +9,41 @@
 #ifndef NS_STANDALONE
 #include <functional>
 #endif
+#include <string>
+#include <vector>
 
 namespace nNetShim {
 // using namespace nNetwork;
 
+// Description of a generated network, parsed from
+//   generate:<kind>:<d0>x<d1>x...[:<nodes per router>][:<routing>]
+// kind is mesh, torus, ring or fbfly (flattened butterfly), routing is dor
+// (dimension order) or o1turn. Dimension 0 is the fastest varying in the
+// switch index.
+struct TopologySpec
+{
+    enum Kind
+    {
+        kMesh,
+        kTorus,
+        kRing,
+        kFlattenedButterfly
+    };
+    enum Routing
+    {
+        kDimensionOrder,
+        kO1Turn
+    };
+
+    Kind kind;
+    std::vector<int32_t> dims;
+    int32_t nodesPerRouter;
+    Routing routing;
+
+    static bool isGenerated(const std::string& aSpec);
+    static bool parse(const std::string& aSpec, TopologySpec& aTopology);
+};
+
 class NetContainer
 {
   public:
@@ -20,6 +51,7 @@ class NetContainer
 
   public:
     bool buildMesh();
+    bool buildTopology(const TopologySpec& topo);
     bool buildNetwork(const char* filename);
 
     bool drive(void);
@@ -124,6 +156,15 @@ class NetContainer
 
     bool allocateNetworkStructures(void);
 
+    // Helpers for generated topologies
+    int32_t dimensionPort(const TopologySpec& topo, const int32_t dim, const int32_t from, const int32_t to) const;
+    bool linkSwitches(const int32_t from, const int32_t fromPort, const int32_t to, const int32_t toPort);
+    bool addGeneratedRoute(const TopologySpec& topo,
+                           const int32_t sw,
+                           const int32_t node,
+                           const bool ascending,
+                           const int32_t vc);
+
   protected:
     ChannelP* channels;
 
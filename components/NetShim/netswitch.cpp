@@ -51,12 +51,16 @@ NetSwitch::NetSwitch(const int32_t name_,     // Name/id of the switch
     internalBuffer = new NetSwitchInternalBuffer(vcBufferDepth, this);
 
     // Initialize the routing table to bogus values.  We can't route yet.
+    // The rows of both tables live in a single contiguous block each.
     routingTable = new intP[numNodes];
     vcTable      = new intP[numNodes];
 
+    intP routingRows = new int[numNodes * numPorts * MAX_NET_VC];
+    intP vcRows      = new int[numNodes * numPorts * MAX_NET_VC];
+
     for (i = 0; i < numNodes; i++) {
-        routingTable[i] = new int[numPorts * MAX_NET_VC];
-        vcTable[i]      = new int[numPorts * MAX_NET_VC];
+        routingTable[i] = routingRows + i * numPorts * MAX_NET_VC;
+        vcTable[i]      = vcRows + i * numPorts * MAX_NET_VC;
         for (j = 0; j < numPorts * MAX_NET_VC; j++) {
             vcTable[i][j] = routingTable[i][j] = -1;
         }
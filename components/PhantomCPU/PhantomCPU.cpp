@@ -15,6 +15,8 @@
 #include <core/qemu/mai_api.hpp>
 #include <core/stats.hpp>
 
+#include <algorithm>
+
 namespace Stat = Flexus::Stat;
 
 #define DBG_DefineCategories PhantomCPU
@@ -31,14 +33,23 @@ private:
     Flexus::Qemu::Processor theCPU;
     uint64_t theCPUIndex;
 
+    // Drives elapsed since the last advance, and the number of drives the
+    // next advance waits for.
+    uint32_t thePendingCycles;
+    uint32_t theBatchInterval;
+
     Stat::StatCounter theCommitCount;
+    Stat::StatCounter theBatchCount;
 
 public:
     FLEXUS_COMPONENT_CONSTRUCTOR(PhantomCPU)
       : base(FLEXUS_PASS_CONSTRUCTOR_ARGS),
         theCPU(),
         theCPUIndex(0),
-        theCommitCount(std::string("Phantom-") + std::to_string(flexusIndex()) + std::string("-CommitCount"))
+        thePendingCycles(0),
+        theBatchInterval(1),
+        theCommitCount(std::string("Phantom-") + std::to_string(flexusIndex()) + std::string("-CommitCount")),
+        theBatchCount(std::string("Phantom-") + std::to_string(flexusIndex()) + std::string("-BatchCount"))
     {
     }
 
@@ -49,6 +60,9 @@ public:
 
         theCPU = Flexus::Qemu::Processor::getProcessor(cpu_index);
         theCPUIndex = cpu_index;
+
+        DBG_Assert(cfg.BatchCycles > 0, (<< "PhantomCPU batch_cycles must be at least 1"));
+        theBatchInterval = cfg.BatchCycles;
     }
 
     void finalize() {}
@@ -58,11 +72,34 @@ public:
 
 private:
     void doCycle() {
-        // 1. advance the CPU by the estimated IPC.
-        for(std::size_t i = 0; i < cfg.EstimatedIPC; i++) {
-            uint64_t return_value = theCPU.advance();
-            if(return_value != 0x10003){
-                ++theCommitCount;
+        // 1. wait until enough drives have accumulated for a batch. While
+        // backing off from a halted CPU, the run state QEMU publishes is
+        // polled every configured batch, so that a wake-up ends the back-off
+        // right away instead of at the end of the long interval.
+        if (++thePendingCycles < theBatchInterval) {
+            bool backing_off = theBatchInterval > cfg.BatchCycles;
+            if (!backing_off || thePendingCycles < cfg.BatchCycles || !Flexus::Qemu::theRunStates ||
+                theCPU.known_halted())
+                return;
+        }
+
+        // 2. advance the CPU by the estimated IPC over every drive since the
+        // last advance, in a single crossing. A CPU that is still halted
+        // returns at once; one that woke during the interval runs the
+        // instructions of the whole interval, so none are dropped.
+        uint64_t steps = uint64_t(cfg.EstimatedIPC) * thePendingCycles;
+        Flexus::Qemu::API::cpu_exec_batch_t result = theCPU.advance_batch(steps);
+        theCommitCount += result.executed;
+        ++theBatchCount;
+        thePendingCycles = 0;
+
+        // 3. adapt the interval: back off exponentially while the CPU stays
+        // halted, and go back to the configured batch as soon as it runs.
+        if (cfg.MaxBatchCycles > cfg.BatchCycles) {
+            if (result.executed == 0 && result.exit_reason == Flexus::Qemu::API::QEMU_EXCP_HALTED) {
+                theBatchInterval = std::min(theBatchInterval * 2, uint32_t(cfg.MaxBatchCycles));
+            } else {
+                theBatchInterval = cfg.BatchCycles;
             }
         }
     }
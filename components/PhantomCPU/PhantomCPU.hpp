@@ -16,6 +16,8 @@
 COMPONENT_PARAMETERS(
   PARAMETER( IndexOffSet, uint32_t, "Index Offset", "index_offset", 0)
   PARAMETER( EstimatedIPC, uint32_t, "Estimated IPC", "estimated_ipc", 5)
+  PARAMETER( BatchCycles, uint32_t, "Drives accumulated into one QEMU advance", "batch_cycles", 1)
+  PARAMETER( MaxBatchCycles, uint32_t, "Upper bound of the batch interval while halted (0 = no adaptation)", "max_batch_cycles", 0)
 );
 
 COMPONENT_INTERFACE(
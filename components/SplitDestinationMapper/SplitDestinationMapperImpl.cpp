@@ -5,6 +5,7 @@
 #include <core/qemu/mai_api.hpp>
 #include <core/stats.hpp>
 #include <core/types.hpp>
+#include <core/warming.hpp>
 
 using nCommonUtil::log_base2;
 
@@ -168,6 +169,11 @@ class FLEXUS_COMPONENT(SplitDestinationMapper)
         DBG_Assert(theDirLoc == eDistributed);
 
         the2PhaseWB = cfg.TwoPhaseWB;
+
+        // Warmed references reach the directory bank their requests would
+        Warming::setHome([this](uint64_t anAddress) {
+            return index_t(getDirectoryLocation(PhysicalMemoryAddress(anAddress)));
+        });
     }
 
     bool available(interface::ICacheRequestIn const&, index_t anIndex)
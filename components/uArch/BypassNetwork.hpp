@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <boost/lambda/bind.hpp>
 #include <boost/lambda/lambda.hpp>
-#include <list>
 #include <vector>
 namespace ll = boost::lambda;
 namespace nuArch {
@@ -21,7 +20,8 @@ class BypassNetwork
     uint32_t theCCRegs;
     typedef std::function<bool(register_value)> bypass_fn;
     typedef std::pair<boost::intrusive_ptr<Instruction>, bypass_fn> bypass_handle;
-    typedef std::list<bypass_handle> bypass_handle_list;
+    // Cleared rather than freed, so steady-state connects do not allocate
+    typedef std::vector<bypass_handle> bypass_handle_list;
     typedef std::vector<bypass_handle_list> bypass_map;
     typedef std::vector<int32_t> collect_counter;
     bypass_map theXDeps;
@@ -43,14 +43,10 @@ class BypassNetwork
     void doCollect(bypass_handle_list& aList)
     {
         FLEXUS_PROFILE();
-        bypass_handle_list::iterator iter, temp, end;
-        iter = aList.begin();
-        end  = aList.end();
-        while (iter != end) {
-            temp = iter;
-            ++iter;
-            if (temp->first->isComplete()) { aList.erase(temp); }
-        }
+        aList.erase(std::remove_if(aList.begin(),
+                                   aList.end(),
+                                   [](bypass_handle const& aHandle) { return aHandle.first->isComplete(); }),
+                    aList.end());
     }
 
     bypass_handle_list& lookup(mapped_reg anIndex)
@@ -111,12 +107,18 @@ class BypassNetwork
     void reset()
     {
         FLEXUS_PROFILE();
-        theXDeps.clear();
-        theVDeps.clear();
-        theCCDeps.clear();
         theXDeps.resize(theXRegs);
         theVDeps.resize(theVRegs);
         theCCDeps.resize(theCCRegs);
+        for (auto& aList : theXDeps) {
+            aList.clear();
+        }
+        for (auto& aList : theVDeps) {
+            aList.clear();
+        }
+        for (auto& aList : theCCDeps) {
+            aList.clear();
+        }
         theXCounts.clear();
         theVCounts.clear();
         theCCCounts.clear();
@@ -129,7 +131,7 @@ class BypassNetwork
     {
         FLEXUS_PROFILE();
         collect(anIndex);
-        lookup(anIndex).push_back(std::make_pair(inst, fn));
+        lookup(anIndex).emplace_back(std::move(inst), std::move(fn));
     }
     void unmap(mapped_reg anIndex)
     {
@@ -140,18 +142,17 @@ class BypassNetwork
     void write(mapped_reg anIndex, register_value aValue, uArch& aCore)
     {
         FLEXUS_PROFILE();
-        bypass_handle_list& list          = lookup(anIndex);
-        bypass_handle_list::iterator iter = list.begin();
-        bypass_handle_list::iterator end  = list.end();
-        while (iter != end) {
-            if (iter->second(aValue)) {
-                auto temp = iter;
-                ++iter;
-                list.erase(temp);
-            } else {
-                ++iter;
-            }
+        bypass_handle_list& list = lookup(anIndex);
+
+        // Each handle is moved out while its function runs, so that a callback
+        // connecting to this register cannot relocate it. Handles that return
+        // false stay, in order.
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            bypass_handle handle = std::move(list[i]);
+            if (!handle.second(aValue)) list[kept++] = std::move(handle);
         }
+        list.erase(list.begin() + kept, list.end());
     }
 };
 
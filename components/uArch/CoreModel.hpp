@@ -26,6 +26,40 @@ struct State
     uint32_t theFPCR;
     uint32_t thePSTATE;
 };
+// A request to throw away the core's state and reload it from QEMU,
+// returned by CoreModel::cycle. Syscalls and unimplemented instructions
+// resync often, so the request is a return value rather than an exception.
+// A default constructed request asks for nothing.
+struct ResynchronizeWithQemu
+{
+    bool requested;
+
+    bool expected;
+
+    bool affiliated_with_instruction;
+
+    boost::intrusive_ptr<Instruction> theInstruction;
+
+    ResynchronizeWithQemu()
+      : requested(false)
+      , expected(false)
+      , affiliated_with_instruction(false)
+    {
+    }
+
+    ResynchronizeWithQemu(bool was_expected,
+                          bool affiliated_with_instruction,
+                          boost::intrusive_ptr<Instruction> instruction = nullptr)
+      : requested(true)
+      , expected(was_expected)
+      , affiliated_with_instruction(affiliated_with_instruction)
+      , theInstruction(instruction)
+    {
+    }
+
+    explicit operator bool() const { return requested; }
+};
+
 struct CoreModel : public uArch
 {
     static CoreModel* construct(uArchOptions_t options
@@ -61,9 +95,9 @@ struct CoreModel : public uArch
     virtual bool isQuiesced() const                          = 0;
     virtual void dispatch(boost::intrusive_ptr<Instruction>) = 0;
 
-    virtual void skipCycle()                             = 0;
-    virtual void cycle(eExceptionType aPendingInterrupt) = 0;
-    virtual void issueMMU(TranslationPtr aTranslation)   = 0;
+    virtual void skipCycle()                                              = 0;
+    virtual ResynchronizeWithQemu cycle(eExceptionType aPendingInterrupt) = 0;
+    virtual void issueMMU(TranslationPtr aTranslation)                    = 0;
 
     virtual bool checkValidatation()                          = 0;
     virtual void pushMemOp(boost::intrusive_ptr<MemOp>)       = 0;
@@ -89,20 +123,6 @@ struct CoreModel : public uArch
     //  virtual void translate(boost::intrusive_ptr<Translation>& aTr) = 0;
 };
 
-struct ResynchronizeWithQemuException
-{
-    bool expected;
-
-    bool affilicated_with_instruction;
-
-    boost::intrusive_ptr<Instruction> theInstruction;
-
-    ResynchronizeWithQemuException(bool was_expected = false, bool affilicated_with_instruction = false, boost::intrusive_ptr<Instruction> instruction = nullptr)
-      : expected(was_expected), affilicated_with_instruction(affilicated_with_instruction), theInstruction(instruction)
-    {
-    }
-};
-
 } // namespace nuArch
 
 #endif // FLEXUS_uARCH_COREMODEL_HPP_INCLUDED
\ No newline at end of file
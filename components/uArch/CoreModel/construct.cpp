@@ -164,6 +164,7 @@ CoreImpl::CoreImpl(uArchOptions_t options,
   , theResync_Unknown(theName + "-Resync:Unknown")
   , theResync_CPUHaltedState(theName + "-Resync:CPUHalted")
   , theFalseITLBMiss(theName + "-FalseITLBMiss")
+  , theHaltedCyclesSkipped(theName + "-Halted:AdvancesSkipped")
   , theEpochs(theName + "-MLPEpoch")
   , theEpochs_Instructions(theName + "-MLPEpoch:Instructions")
   , theEpochs_Instructions_Avg(theName + "-MLPEpoch:Instructions:Avg")
@@ -349,6 +349,9 @@ class CoreImpl : public CoreModel
       theResync_FailedValidation, theResync_FailedHandleTrap, theResync_SideEffectLoad, theResync_SideEffectStore,
       theResync_Unknown, theResync_CPUHaltedState, theFalseITLBMiss;
 
+    // Halted cycles that skipped the call into QEMU
+    Stat::StatCounter theHaltedCyclesSkipped;
+
     MemOpCounter* theMemOpCounters[2][2][8];
     Stat::StatCounter* theEpochEnd[2][8];
     Stat::StatCounter theEpochs;
@@ -504,7 +507,7 @@ class CoreImpl : public CoreModel
     //==========================================================================
   public:
     void skipCycle();
-    void cycle(eExceptionType aPendingInterrupt);
+    ResynchronizeWithQemu cycle(eExceptionType aPendingInterrupt);
     void dumpState(Flexus::SharedTypes::CPU_State&);
     bool checkValidatation();
 
@@ -515,8 +518,8 @@ class CoreImpl : public CoreModel
     void endCycle();
     void satisfy(InstructionDependance const& aDep);
     void squash(InstructionDependance const& aDep);
-    void satisfy(std::list<InstructionDependance>& dependances);
-    void squash(std::list<InstructionDependance>& dependances);
+    void satisfy(InstructionDependanceList& dependances);
+    void squash(InstructionDependanceList& dependances);
 
     void clearExclusiveLocal();
     void clearExclusiveGlobal();
@@ -558,8 +561,8 @@ class CoreImpl : public CoreModel
 
   private:
     void retire();
-    void commit();
-    void commit(boost::intrusive_ptr<Instruction> anInstruction);
+    ResynchronizeWithQemu commit();
+    ResynchronizeWithQemu commit(boost::intrusive_ptr<Instruction> anInstruction);
     bool acceptInterrupt();
 
     // Retirement accounting
@@ -586,7 +589,7 @@ class CoreImpl : public CoreModel
     void trainingBranch(boost::intrusive_ptr<BPredState> feedback);
 
     void takeTrap(boost::intrusive_ptr<Instruction> anInsn, eExceptionType aTrapType);
-    void handleTrap();
+    ResynchronizeWithQemu handleTrap();
 
   private:
     void doSquash();
@@ -69,13 +69,13 @@ CoreImpl::checkValidatation()
     return same;
 }
 
-void
+ResynchronizeWithQemu
 CoreImpl::cycle(eExceptionType aPendingInterrupt)
 {
     // qemu warmup
     if (theFlexus->cycleCount() == 1) {
         advance_fn(true);
-        throw ResynchronizeWithQemuException(true, false, nullptr);
+        return ResynchronizeWithQemu(true, false, nullptr);
     }
     theCycleCountStat++;
     theCycleCount++;
@@ -116,7 +116,7 @@ CoreImpl::cycle(eExceptionType aPendingInterrupt)
                   << "Garbage-collect detects too many live instructions.  "
                      "Forcing resynchronize."));
             ++theResync_GarbageCollect;
-            throw ResynchronizeWithQemuException(false, false, nullptr);
+            return ResynchronizeWithQemu(false, false, nullptr);
         }
     }
 
@@ -179,14 +179,20 @@ CoreImpl::cycle(eExceptionType aPendingInterrupt)
     arbitrate();
 
     if (cpuHalted) {
+        // Nothing to ask QEMU while it publishes that the core has no work
+        if (Flexus::Qemu::Processor::getProcessor(theNode).known_halted()) {
+            ++theHaltedCyclesSkipped;
+            return ResynchronizeWithQemu();
+        }
+
         int qemu_rcode = advance_fn(false); // don't count instructions in halt state
         if (qemu_rcode != QEMU_EXCP_HALTED) {
             DBG_(Dev, (<< "Core " << theNode << " leaving halt state, after QEMU sent execution code " << qemu_rcode));
             cpuHalted = false;
-            throw ResynchronizeWithQemuException(true, false, nullptr);
+            return ResynchronizeWithQemu(true, false, nullptr);
         }
 
-        return;
+        return ResynchronizeWithQemu();
     }
 
     // Retire instruction from the ROB to the SRB
@@ -208,9 +214,11 @@ CoreImpl::cycle(eExceptionType aPendingInterrupt)
     }
 
     // Commit instructions the SRB and compare to simics
-    commit();
+    ResynchronizeWithQemu resync = commit();
+    if (resync) { return resync; }
 
-    handleTrap();
+    resync = handleTrap();
+    if (resync) { return resync; }
     //  handlePopTL();
 
     if (theRedirectRequested) {
@@ -235,6 +243,7 @@ CoreImpl::cycle(eExceptionType aPendingInterrupt)
     }
 
     CORE_DBG("--------------FINISH CORE------------------------");
+    return ResynchronizeWithQemu();
 }
 
 void
@@ -278,23 +287,18 @@ CoreImpl::squash(InstructionDependance const& aDep)
     aDep.squash();
 }
 void
-CoreImpl::satisfy(std::list<InstructionDependance>& dependances)
+CoreImpl::satisfy(InstructionDependanceList& dependances)
 {
-    std::list<InstructionDependance>::iterator iter = dependances.begin();
-    std::list<InstructionDependance>::iterator end  = dependances.end();
-    while (iter != end) {
-        iter->satisfy();
-        ++iter;
+    // Indexed, the callbacks may append to the list
+    for (std::size_t i = 0; i < dependances.size(); ++i) {
+        dependances[i].satisfy();
     }
 }
 void
-CoreImpl::squash(std::list<InstructionDependance>& dependances)
+CoreImpl::squash(InstructionDependanceList& dependances)
 {
-    std::list<InstructionDependance>::iterator iter = dependances.begin();
-    std::list<InstructionDependance>::iterator end  = dependances.end();
-    while (iter != end) {
-        iter->squash();
-        ++iter;
+    for (std::size_t i = 0; i < dependances.size(); ++i) {
+        dependances[i].squash();
     }
 }
 
@@ -1333,7 +1337,7 @@ CoreImpl::doAbortSpeculation()
     if (remaining_ssb > 0) { theTSOBReplayStalls = remaining_ssb / theNumMemoryPorts; }
 }
 
-void
+ResynchronizeWithQemu
 CoreImpl::commit()
 {
     FLEXUS_PROFILE();
@@ -1352,17 +1356,20 @@ CoreImpl::commit()
 
         theLastTrainingFeedback = nullptr;
 
-        commit(theSRB.front());
+        // The instruction stays in the SRB; the resync resets the core
+        ResynchronizeWithQemu resync = commit(theSRB.front());
+        if (resync) { return resync; }
         DBG_(VVerb, (<< theName << " committed in Qemu"));
 
         theSRB.pop_front();
     }
+    return ResynchronizeWithQemu();
 }
 
 int s_validation = 0;
 int f_validation = 0;
 
-void
+ResynchronizeWithQemu
 CoreImpl::commit(boost::intrusive_ptr<Instruction> anInstruction)
 {
     FLEXUS_PROFILE();
@@ -1438,7 +1445,7 @@ CoreImpl::commit(boost::intrusive_ptr<Instruction> anInstruction)
         // synchronizing instruction.
         theEmptyROBCause = kSync;
         if (!resync_accounted) { accountResyncReason(anInstruction); }
-        throw ResynchronizeWithQemuException(true, true, anInstruction);
+        return ResynchronizeWithQemu(true, true, anInstruction);
     }
 
     if (anInstruction->advancesSimics()) {
@@ -1457,12 +1464,13 @@ CoreImpl::commit(boost::intrusive_ptr<Instruction> anInstruction)
         theEmptyROBCause = kResync;
         ++theResync_FailedValidation;
 
-        throw ResynchronizeWithQemuException(true, true, anInstruction);
+        return ResynchronizeWithQemu(true, true, anInstruction);
     }
     /* Dump PC to file if logging is enabled */
     if (collectTrace) { trace_stream << anInstruction->pc() << std::endl; }
     DBG_(VVerb, (<< "uARCH Validated "));
     DBG_(VVerb, (<< std::internal << *anInstruction << std::left));
+    return ResynchronizeWithQemu();
 }
 
 bool
@@ -1633,15 +1641,15 @@ CoreImpl::acceptInterrupt()
     return false;
 }
 
-void
+ResynchronizeWithQemu
 CoreImpl::handleTrap()
 {
-    if (thePendingTrap == kException_None) { return; }
+    if (thePendingTrap == kException_None) { return ResynchronizeWithQemu(); }
     DBG_(Dev, (<< theName << " Handling trap: " << thePendingTrap << " raised by: " << *theTrapInstruction));
     DBG_(Crit, (<< theName << " ROB non-empty in handle trap.  Resynchronize instead."));
     theEmptyROBCause = kRaisedException;
     ++theResync_FailedHandleTrap;
-    throw ResynchronizeWithQemuException(false, true, theTrapInstruction);
+    return ResynchronizeWithQemu(false, true, theTrapInstruction);
 }
 
 void
@@ -16,9 +16,7 @@ operator<<(std::ostream& anOstream, PhysicalMap& aMap)
         if ((i & 7) == 7) anOstream << "\n\t";
     }
     anOstream << "\n\tFree List\n\t";
-    // for(const auto& aFree: theFreeList)
-    //  anOstream << 'p' << aFree << ' ';
-    std::for_each(aMap.theFreeList.begin(), aMap.theFreeList.end(), ll::var(anOstream) << 'p' << ll::_1 << ' ');
+    aMap.forEachFree([&anOstream](pRegister aFree) { anOstream << 'p' << aFree << ' '; });
     anOstream << std::endl;
     return anOstream;
 }
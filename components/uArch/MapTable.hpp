@@ -8,7 +8,7 @@
 #include <boost/lambda/lambda.hpp>
 #include <core/debug/debug.hpp>
 #include <core/performance/profile.hpp>
-#include <list>
+#include <deque>
 #include <vector>
 
 namespace ll = boost::lambda;
@@ -23,8 +23,14 @@ struct PhysicalMap
     int32_t theNameCount;
     int32_t theRegisterCount;
     std::vector<pRegister> theMappings;
-    std::list<pRegister> theFreeList;
-    std::vector<std::list<pRegister>> theAssignedRegisters;
+
+    // Free physical registers, handed out in the order they were freed. The
+    // FIFO is a ring over a fixed array, and theFree marks the registers in it.
+    std::vector<pRegister> theFreeList;
+    uint32_t theFreeHead;
+    uint32_t theFreeCount;
+    std::vector<uint64_t> theFree;
+    std::vector<std::deque<pRegister>> theAssignedRegisters;
     std::vector<int> theReverseMappings;
 
     PhysicalMap(int32_t aNameCount, int32_t aRegisterCount)
@@ -34,6 +40,8 @@ struct PhysicalMap
         theMappings.resize(aNameCount);
         theAssignedRegisters.resize(aNameCount);
         theReverseMappings.resize(aRegisterCount);
+        theFreeList.resize(aRegisterCount);
+        theFree.resize((aRegisterCount + 63) / 64);
         reset();
     }
 
@@ -50,10 +58,40 @@ struct PhysicalMap
         }
 
         // Fill in initial free list
-        theFreeList.clear();
-        std::copy(boost::counting_iterator<int>(theNameCount),
-                  boost::counting_iterator<int>(theRegisterCount),
-                  std::back_inserter(theFreeList));
+        theFreeHead  = 0;
+        theFreeCount = 0;
+        std::fill(theFree.begin(), theFree.end(), 0);
+        for (int32_t i = theNameCount; i < theRegisterCount; ++i) {
+            pushFree(i);
+        }
+    }
+
+    bool isFree(pRegister aRegister) const { return (theFree[aRegister / 64] >> (aRegister % 64)) & 1; }
+
+    void pushFree(pRegister aRegister)
+    {
+        DBG_Assert(!isFree(aRegister), (<< "p" << aRegister << " freed twice"));
+        DBG_Assert(theFreeCount < theFreeList.size());
+        theFreeList[(theFreeHead + theFreeCount++) % theFreeList.size()] = aRegister;
+        theFree[aRegister / 64] |= uint64_t(1) << (aRegister % 64);
+    }
+
+    pRegister popFree()
+    {
+        DBG_Assert(theFreeCount > 0, (<< "Out of physical registers"));
+        pRegister reg = theFreeList[theFreeHead];
+        theFreeHead   = (theFreeHead + 1) % theFreeList.size();
+        --theFreeCount;
+        theFree[reg / 64] &= ~(uint64_t(1) << (reg % 64));
+        return reg;
+    }
+
+    template<class Fn>
+    void forEachFree(Fn aFn) const
+    {
+        for (uint32_t i = 0; i < theFreeCount; ++i) {
+            aFn(theFreeList[(theFreeHead + i) % theFreeList.size()]);
+        }
     }
 
     pRegister map(regName aRegisterName)
@@ -78,8 +116,7 @@ struct PhysicalMap
         FLEXUS_PROFILE();
         DBG_Assert(aRegisterName < theMappings.size());
         pRegister previous_reg = theMappings[aRegisterName];
-        pRegister new_reg      = theFreeList.front();
-        theFreeList.pop_front();
+        pRegister new_reg      = popFree();
         theMappings[aRegisterName] = new_reg;
         DISPATCH_DBG("Mapping archReg[" << aRegisterName << "] -> pReg[" << new_reg << "] - previous pReg["
                                         << previous_reg << "]");
@@ -92,9 +129,9 @@ struct PhysicalMap
     void free(pRegister aRegisterName)
     {
         FLEXUS_PROFILE();
-        theFreeList.push_back(aRegisterName);
+        pushFree(aRegisterName);
         int32_t arch_name                                = theReverseMappings[aRegisterName];
-        std::vector<std::list<pRegister>>::iterator iter = theAssignedRegisters.begin() + arch_name;
+        std::vector<std::deque<pRegister>>::iterator iter = theAssignedRegisters.begin() + arch_name;
         DBG_Assert(arch_name >= 0 && arch_name < static_cast<int>(theAssignedRegisters.size()));
         DBG_Assert(theMappings[arch_name] != aRegisterName);
         DBG_Assert(iter->size());
@@ -128,9 +165,7 @@ struct PhysicalMap
         //  ++registers[aMapping];
         std::for_each(theMappings.begin(), theMappings.end(), ++ll::var(registers)[ll::_1]);
 
-        // for(const auto& aFree: theFreeList)
-        //  ++registers[aFree];
-        std::for_each(theFreeList.begin(), theFreeList.end(), ++ll::var(registers)[ll::_1]);
+        forEachFree([&registers](pRegister aFree) { ++registers[aFree]; });
 
         if (std::find_if(registers.begin(),
                          registers.end()
@@ -152,9 +187,7 @@ struct PhysicalMap
             if ((i & 7) == 7) anOstream << "\n\t";
         }
         anOstream << "\n\tFree List\n\t";
-        // for(const auto& aFree: theFreeList)
-        //  anOstream << 'p' << aFree << ' ';
-        std::for_each(theFreeList.begin(), theFreeList.end(), ll::var(anOstream) << 'p' << ll::_1 << ' ');
+        forEachFree([&anOstream](pRegister aFree) { anOstream << 'p' << aFree << ' '; });
         anOstream << std::endl;
     }
 
@@ -167,9 +200,7 @@ struct PhysicalMap
     }
     void dumpFreeList(std::ostream& anOstream)
     {
-        // for(const auto& aFree: theFreeList)
-        //  anOstream << 'p' << aFree << ' ';
-        std::for_each(theFreeList.begin(), theFreeList.end(), ll::var(anOstream) << 'p' << ll::_1 << ' ');
+        forEachFree([&anOstream](pRegister aFree) { anOstream << 'p' << aFree << ' '; });
         anOstream << std::endl;
     }
     void dumpReverseMappings(std::ostream& anOstream)
@@ -188,7 +219,7 @@ struct PhysicalMap
     {
         for (uint32_t i = 0; i < theAssignedRegisters.size(); ++i) {
             anOstream << "r" << i << ": ";
-            std::list<pRegister>::iterator iter, end;
+            std::deque<pRegister>::iterator iter, end;
             iter = theAssignedRegisters[i].begin();
             end  = theAssignedRegisters[i].end();
             while (iter != end) {
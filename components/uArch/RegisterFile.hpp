@@ -8,7 +8,6 @@
 #include <boost/lambda/bind.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <core/performance/profile.hpp>
-#include <list>
 #include <vector>
 
 namespace nuArch {
@@ -16,7 +15,7 @@ namespace nuArch {
 class RegisterFile
 {
   protected:
-    std::vector<std::vector<std::list<InstructionDependance>>> theDependances;
+    std::vector<std::vector<InstructionDependanceList>> theDependances;
     std::vector<std::vector<eResourceStatus>> theStatus;
     std::vector<std::vector<register_value>> theRegs;
     std::vector<std::vector<int32_t>> theCollectCounts;
@@ -55,21 +54,22 @@ class RegisterFile
         }
     }
 
+    // Drops the waiters that have completed, keeping the others in order
+    static void removeCompleted(InstructionDependanceList& aList)
+    {
+        aList.erase(std::remove_if(aList.begin(),
+                                   aList.end(),
+                                   [](InstructionDependance const& aDep) { return aDep.instruction->isComplete(); }),
+                    aList.end());
+    }
+
     void collectAll()
     {
         FLEXUS_PROFILE();
         for (uint32_t i = 0; i < theDependances.size(); ++i) {
             for (uint32_t j = 0; j < theDependances[i].size(); ++j) {
                 theCollectCounts[i][j] = 10;
-
-                std::list<InstructionDependance>::iterator iter, temp, end;
-                iter = theDependances[i][j].begin();
-                end  = theDependances[i][j].end();
-                while (iter != end) {
-                    temp = iter;
-                    ++iter;
-                    if (temp->instruction->isComplete()) { theDependances[i][j].erase(temp); }
-                }
+                removeCompleted(theDependances[i][j]);
             }
         }
     }
@@ -79,15 +79,7 @@ class RegisterFile
         FLEXUS_PROFILE();
         if (--theCollectCounts[aReg.theType][aReg.theIndex] <= 0) {
             theCollectCounts[aReg.theType][aReg.theIndex] = 10;
-
-            std::list<InstructionDependance>::iterator iter, temp, end;
-            iter = theDependances[aReg.theType][aReg.theIndex].begin();
-            end  = theDependances[aReg.theType][aReg.theIndex].end();
-            while (iter != end) {
-                temp = iter;
-                ++iter;
-                if (temp->instruction->isComplete()) { theDependances[aReg.theType][aReg.theIndex].erase(temp); }
-            }
+            removeCompleted(theDependances[aReg.theType][aReg.theIndex]);
         }
     }
     void map(mapped_reg aReg)
@@ -148,18 +140,16 @@ class RegisterFile
         poke(aReg, aValue, isW);
         theStatus[aReg.theType][aReg.theIndex] = kReady;
 
-        std::list<InstructionDependance>::iterator iter = theDependances[aReg.theType][aReg.theIndex].begin();
-        std::list<InstructionDependance>::iterator end  = theDependances[aReg.theType][aReg.theIndex].end();
-        std::list<InstructionDependance>::iterator tmp;
-        while (iter != end) {
-            tmp = iter;
-            ++iter;
-            if (tmp->instruction->isComplete()) {
-                theDependances[aReg.theType][aReg.theIndex].erase(tmp);
-            } else {
-                tmp->satisfy();
-            }
+        // Wake the waiters and compact the list in a single pass. Indexed, as
+        // the callbacks may append to the list.
+        InstructionDependanceList& waiters = theDependances[aReg.theType][aReg.theIndex];
+        std::size_t kept                   = 0;
+        for (std::size_t i = 0; i < waiters.size(); ++i) {
+            if (waiters[i].instruction->isComplete()) continue;
+            if (kept != i) waiters[kept] = std::move(waiters[i]);
+            waiters[kept++].satisfy();
         }
+        waiters.erase(waiters.begin() + kept, waiters.end());
     }
 };
 
@@ -11,14 +11,17 @@
 #include "core/qemu/api.h"
 #include "core/qemu/configuration_api.hpp"
 #include "core/qemu/mai_api.hpp"
+#include "core/sampling.hpp"
 #include "core/stats.hpp"
 #include "core/target.hpp"
+#include "core/telemetry.hpp"
 #include "core/types.hpp"
 #include "systemRegister.hpp"
 
 #include <boost/lambda/bind.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/polymorphic_pointer_cast.hpp>
+#include <chrono>
 
 namespace API = Flexus::Qemu::API;
 
@@ -54,18 +57,23 @@ class microArchImpl : public microArch
     Stat::StatCounter theResyncInstructions;
     Stat::StatCounter theOtherResyncs;
     Stat::StatCounter theExceptions;
+    Stat::StatLog2Histogram theResyncLatency;
     int32_t theExceptionRaised;
     bool theBreakOnResynchronize;
     bool theDriveClients;
     Flexus::Qemu::Processor theClientCPUs[MAX_CLIENT_SIZE];
     int32_t theNumClients;
     int32_t theNode;
+    uint64_t theSamplingEpoch;
     std::function<void(eSquashCause)> squash;
     std::function<void(boost::intrusive_ptr<BPredRedictRequest>)> redirect;
     std::function<void(boost::intrusive_ptr<BPredState>)> trainBP;
     std::function<void(bool)> signalStoreForwardingHit;
     std::function<void(int32_t)> mmuResync;
 
+    // Handlers of the system registers reloaded on every resync
+    std::vector<std::unique_ptr<SysRegInfo>> theSysRegs;
+
   public:
     microArchImpl(uArchOptions_t options,
                   std::function<void(eSquashCause)> _squash,
@@ -87,11 +95,13 @@ class microArchImpl : public microArch
       , theResyncInstructions(options.name + "-ResyncsCaught:Instruction")
       , theOtherResyncs(options.name + "-ResyncsCaught:Other")
       , theExceptions(options.name + "-ResyncsCaught:Exception")
+      , theResyncLatency(options.name + "-ResyncLatency:ns")
       , theExceptionRaised(kException_None)
       , theBreakOnResynchronize(options.breakOnResynchronize)
       , theDriveClients(false)
       , theNumClients(0)
       , theNode(options.node)
+      , theSamplingEpoch(0)
       , squash(_squash)
       , redirect(_redirect)
       , trainBP(_trainBP)
@@ -105,6 +115,9 @@ class microArchImpl : public microArch
 
         theAvailableROB = theCore->availableROB();
 
+        for (auto& reg : nuArch::supported_sysRegs) {
+            theSysRegs.push_back(getPriv(reg.second));
+        }
         resetArchitecturalState(true);
 
         // DBG_(Crit, (<< theName << " connected to "
@@ -246,16 +259,22 @@ class microArchImpl : public microArch
     {
         CORE_DBG("--------------START MICROARCH------------------------");
 
-        try {
+        // QEMU ran ahead during a sampling fast-forward: restart from its state
+        if (theSamplingEpoch != Sampling::epoch()) {
+            theSamplingEpoch = Sampling::epoch();
+            resynchronize(true);
+        }
+
+        // Record free ROB space for next cycle
+        theAvailableROB = theCore->availableROB();
 
-            // Record free ROB space for next cycle
-            theAvailableROB = theCore->availableROB();
+        // TODO -
+        eExceptionType interrupt     = theCPU.has_irq() ? kException_IRQ : kException_None; // HEHE
+        ResynchronizeWithQemu resync = theCore->cycle(interrupt);
 
-            // TODO -
-            eExceptionType interrupt = theCPU.has_irq() ? kException_IRQ : kException_None; // HEHE
-            theCore->cycle(interrupt);
+        if (resync) {
+            auto start = steady_clock::now();
 
-        } catch (ResynchronizeWithQemuException& e) {
             ++theResynchronizations;
             if (theExceptionRaised != (int)(kException_None)) {
                 // DBG_( Verb, ( << "CPU[" << std::setfill('0') << std::setw(2) <<
@@ -266,7 +285,7 @@ class microArchImpl : public microArch
                      (<< "CPU[" << std::setfill('0') << std::setw(2) << theCPU.id()
                       << "] Exception Raised: " << theExceptionRaised << ". Resynchronizing with Simics."));
                 ++theExceptions;
-            } else if (e.expected) {
+            } else if (resync.expected) {
                 DBG_(Verb,
                      (<< "CPU[" << std::setfill('0') << std::setw(2) << theCPU.id()
                       << "] Resynchronizing Instruction. Resynchronizing with Qemu."));
@@ -279,7 +298,7 @@ class microArchImpl : public microArch
                 ++theOtherResyncs;
             }
 
-            resynchronize(e.expected, e.affilicated_with_instruction ? e.theInstruction : nullptr);
+            resynchronize(resync.expected, resync.affiliated_with_instruction ? resync.theInstruction : nullptr);
 
             if (theBreakOnResynchronize) {
                 DBG_(Dev,
@@ -290,6 +309,8 @@ class microArchImpl : public microArch
                 // theCPU.breakSimulation(); TODO
             }
             theExceptionRaised = kException_None;
+
+            theResyncLatency << duration_cast<nanoseconds>(steady_clock::now() - start).count();
         }
 
         CORE_DBG("--------------FINISH MICROARCH------------------------");
@@ -347,6 +368,10 @@ class microArchImpl : public microArch
         FLEXUS_PROFILE();
         theExceptionRaised = theCPU.advance(count_tick);
         theFlexus->reset_core_watchdog(theCPU.id());
+        if (count_tick && theExceptionRaised != API::QEMU_EXCP_HALTED) {
+            Telemetry::committed(theCPU.id());
+            Sampling::committed();
+        }
         return theExceptionRaised;
     }
 
@@ -370,8 +395,8 @@ class microArchImpl : public microArch
 
     void fillSysRegisters()
     {
-        for (auto& reg : nuArch::supported_sysRegs) {
-            getPriv(reg.second)->sync(theCore.get(), theNode);
+        for (auto& reg : theSysRegs) {
+            reg->sync(theCore.get(), theNode);
         }
     }
 
@@ -379,18 +404,26 @@ class microArchImpl : public microArch
     // in the VM (i.e. client)
     void fillXRegisters()
     {
+        Flexus::Qemu::API::register_read_t regs[32];
+        for (std::size_t i = 0; i < 32; ++i) {
+            regs[i] = { Flexus::Qemu::API::GENERAL, i, 0 };
+        }
+        theCPU.read_registers(regs, 32);
         for (int32_t i = 0; i < 32; ++i) {
-            uint64_t val = theCPU.read_register(Flexus::Qemu::API::GENERAL, (std::size_t)i);
-            theCore->initializeRegister(theCore->map(xRegArch(i)), val);
+            theCore->initializeRegister(theCore->map(xRegArch(i)), regs[i].value);
         }
     }
     // fills/re-sets floating point registers to the state they are
     // in the VM (i.e. client)
     void fillVRegisters()
     {
+        Flexus::Qemu::API::register_read_t regs[32];
+        for (std::size_t i = 0; i < 32; ++i) {
+            regs[i] = { Flexus::Qemu::API::FLOATING_POINT, i, 0 };
+        }
+        theCPU.read_registers(regs, 32);
         for (int32_t i = 0; i < 32; ++i) {
-            uint64_t val = theCPU.read_register(Flexus::Qemu::API::FLOATING_POINT, (std::size_t)i);
-            theCore->initializeRegister(theCore->map(vRegArch(i)), val);
+            theCore->initializeRegister(theCore->map(vRegArch(i)), regs[i].value);
         }
     }
 
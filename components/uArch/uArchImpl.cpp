@@ -191,6 +191,7 @@ class FLEXUS_COMPONENT(uArch)
         options.fpSqrtOpLatency           = cfg.FpSqrtOpLatency;
         options.fpSqrtOpPipelineResetTime = cfg.FpSqrtOpPipelineResetTime;
 
+        Flexus::Core::ComponentArena::Scope tables(coreArena());
         theMicroArch = microArch::construct(options,
                                             ll::bind(&uArchComponent::squash, this, ll::_1),
                                             ll::bind(&uArchComponent::redirect, this, ll::_1),
@@ -19,6 +19,7 @@
 #include <boost/variant.hpp>
 #include <functional>
 #include <list>
+#include <vector>
 
 using namespace Flexus::SharedTypes;
 
@@ -632,11 +633,22 @@ struct Instruction : public Flexus::SharedTypes::AbstractInstruction
 
 struct InstructionDependance
 {
+    typedef void (*callback_fn)(void* aTarget, int32_t anArg);
+
     boost::intrusive_ptr<Instruction> instruction; // For lifetime control
-    std::function<void()> squash;
-    std::function<void()> satisfy;
+    callback_fn theSatisfy = nullptr;
+    callback_fn theSquash  = nullptr;
+    void* theTarget        = nullptr;
+    int32_t theArg         = 0;
+
+    void satisfy() const { theSatisfy(theTarget, theArg); }
+    void squash() const { theSquash(theTarget, theArg); }
 };
 
+// Consumers waiting on a resource. Lists are cleared rather than freed, so
+// once warmed up, requests and wakeups do not allocate.
+typedef std::vector<InstructionDependance> InstructionDependanceList;
+
 struct Interaction : public boost::counted_base
 {
     virtual void operator()(boost::intrusive_ptr<Instruction> anInstruction, nuArch::uArch& aCore)
@@ -773,8 +785,8 @@ struct uArch
     virtual void copyRegValue(mapped_reg aSource, mapped_reg aDest) { DBG_Assert(false); }
     virtual void satisfy(InstructionDependance const& aDep) { DBG_Assert(false); }
     virtual void squash(InstructionDependance const& aDep) { DBG_Assert(false); }
-    virtual void satisfy(std::list<InstructionDependance>& dependances) { DBG_Assert(false); }
-    virtual void squash(std::list<InstructionDependance>& dependances) { DBG_Assert(false); }
+    virtual void satisfy(InstructionDependanceList& dependances) { DBG_Assert(false); }
+    virtual void squash(InstructionDependanceList& dependances) { DBG_Assert(false); }
     virtual void applyToNext(boost::intrusive_ptr<Instruction> anInsn, boost::intrusive_ptr<Interaction> anInteraction)
     {
         DBG_Assert(false);
@@ -1,10 +1,10 @@
 #ifndef FLEXUS_UFETCH_SIMCACHE
 #define FLEXUS_UFETCH_SIMCACHE
-#include "components/CommonQEMU/seq_map.hpp"
 #include "core/checkpoint/json.hpp"
 #include "core/debug/debug.hpp"
 
 #include <fstream>
+#include <vector>
 using json = nlohmann::json;
 
 #define LOG2(x)                                                                                                        \
@@ -13,13 +13,25 @@ using json = nlohmann::json;
         _x ? (63 - __builtin_clzl(_x)) : 0;                                                                            \
     })
 
-typedef flexus_boost_set_assoc<uint64_t, int> SimCacheArray;
-typedef SimCacheArray::iterator SimCacheIter;
-
+// The L1i, consulted for every fetch block.
+//
+// Each set is a row of theCacheAssoc block addresses, kept contiguous so
+// that the tag compare of a whole set is one vectorizable loop, and a
+// matching row of LRU ages: the valid ways of a set hold the ages
+// 0 (MRU) .. valid - 1 (LRU), invalid ways kInvalidAge, so the oldest way
+// is always the one to fill. A one-entry cache of the last block looked up
+// or inserted sits in front; that block is always the MRU of its set, so
+// hitting it again needs neither the compare nor an age update.
 struct SimCache
 {
-
-    SimCacheArray theCache;
+    static constexpr uint64_t kInvalid   = ~0ULL;
+    static constexpr uint8_t kInvalidAge = 0xFF;
+    static constexpr int32_t kMaxAssoc   = 64;
+
+    std::vector<uint64_t> theTags;
+    std::vector<uint8_t> theAges;
+    uint64_t theSetMask;
+    uint64_t theLastBlock;
     int32_t theCacheSize;
     int32_t theCacheAssoc;
     int32_t theCacheBlockShift;
@@ -32,10 +44,19 @@ struct SimCache
         theCacheAssoc      = aCacheAssoc;
         theBlockSize       = aBlockSize;
         theCacheBlockShift = LOG2(theBlockSize);
-        theCache.init(theCacheSize / theBlockSize, theCacheAssoc, 0);
-        theName = aName;
+        theName            = aName;
+
+        uint64_t sets = theCacheSize / theBlockSize / theCacheAssoc;
+        DBG_Assert(theCacheAssoc > 0 && theCacheAssoc <= kMaxAssoc, (<< theName << ": unsupported associativity"));
+        DBG_Assert(sets > 0 && (sets & (sets - 1)) == 0, (<< theName << ": number of sets must be a power of two"));
+        theSetMask = sets - 1;
+        theTags.assign(sets * theCacheAssoc, kInvalid);
+        theAges.assign(sets * theCacheAssoc, kInvalidAge);
+        theLastBlock = kInvalid;
     }
 
+    uint64_t sets() const { return theSetMask + 1; }
+
     void loadState(std::string const& filename)
     {
         std::string ckpt_filename(filename);
@@ -50,12 +71,12 @@ struct SimCache
         json checkpoint;
 
         ifs >> checkpoint;
-        uint32_t tag_shift = LOG2(theCache.sets());
+        uint32_t tag_shift = LOG2(sets());
 
         DBG_Assert((uint64_t)theCacheAssoc == checkpoint["associativity"]);
-        DBG_Assert((uint64_t)theCache.sets() == checkpoint["tags"].size());
+        DBG_Assert(sets() == checkpoint["tags"].size());
 
-        for (std::size_t i{ 0 }; i < theCache.sets(); i++) {
+        for (std::size_t i{ 0 }; i < sets(); i++) {
             if (checkpoint["tags"].at(i).size() == 0) {
                 continue;
             }
@@ -70,43 +91,108 @@ struct SimCache
         ifs.close();
     }
 
+    // Returns the address of the evicted block, or 0
     uint64_t insert(uint64_t addr)
     {
-        uint64_t ret_val  = 0;
-        addr              = addr >> theCacheBlockShift;
-        SimCacheIter iter = theCache.find(addr);
-        if (iter != theCache.end()) {
-            theCache.move_back(iter);
-            return ret_val; // already present
+        uint64_t block = addr >> theCacheBlockShift;
+        if (block == theLastBlock) return 0; // already present
+
+        uint64_t* tags = setTags(block);
+        uint8_t* ages  = setAges(block);
+        int32_t way    = find(tags, block);
+        if (way >= 0) {
+            touch(ages, way);
+            theLastBlock = block;
+            return 0; // already present
         }
-        if ((int)theCache.size() >= theCacheAssoc) {
-            ret_val = theCache.front_key() << theCacheBlockShift;
-            theCache.pop_front();
+
+        uint64_t ret_val = 0;
+        way              = 0;
+        for (int32_t i = 1; i < theCacheAssoc; ++i) {
+            if (ages[i] > ages[way]) way = i;
         }
-        theCache.insert(std::make_pair(addr, 0));
+        if (ages[way] != kInvalidAge) ret_val = tags[way] << theCacheBlockShift;
+        tags[way] = block;
+        ages[way] = theCacheAssoc;
+        touch(ages, way);
+        theLastBlock = block;
         return ret_val;
     }
 
     bool lookup(uint64_t addr)
     {
-        addr              = addr >> theCacheBlockShift;
-        SimCacheIter iter = theCache.find(addr);
-        if (iter != theCache.end()) {
-            theCache.move_back(iter);
-            return true; // present
+        uint64_t block = addr >> theCacheBlockShift;
+        if (block == theLastBlock) return true; // present
+
+        // The common associativities get loops of a known length
+        switch (theCacheAssoc) {
+            case 2: return lookupIn<2>(block);
+            case 4: return lookupIn<4>(block);
+            case 8: return lookupIn<8>(block);
+            case 16: return lookupIn<16>(block);
+            default: return lookupIn<0>(block);
         }
-        return false; // not present
     }
 
     bool inval(uint64_t addr)
     {
-        addr              = addr >> theCacheBlockShift;
-        SimCacheIter iter = theCache.find(addr);
-        if (iter != theCache.end()) {
-            theCache.erase(iter);
-            return true; // invalidated
+        uint64_t block = addr >> theCacheBlockShift;
+        uint64_t* tags = setTags(block);
+        uint8_t* ages  = setAges(block);
+        int32_t way    = find(tags, block);
+        if (way < 0) return false; // not present
+
+        // The younger ways keep their ages, the older ones close the gap
+        const int32_t assoc = theCacheAssoc;
+        const uint8_t age   = ages[way];
+        for (int32_t i = 0; i < assoc; ++i) {
+            ages[i] -= (ages[i] > age && ages[i] != kInvalidAge);
+        }
+        tags[way] = kInvalid;
+        ages[way] = kInvalidAge;
+        if (block == theLastBlock) theLastBlock = kInvalid;
+        return true; // invalidated
+    }
+
+  private:
+    template<int32_t Assoc>
+    bool lookupIn(uint64_t aBlock)
+    {
+        int32_t way = find<Assoc>(setTags(aBlock), aBlock);
+        if (way < 0) return false; // not present
+        touch<Assoc>(setAges(aBlock), way);
+        theLastBlock = aBlock;
+        return true; // present
+    }
+
+    uint64_t* setTags(uint64_t aBlock) { return &theTags[(aBlock & theSetMask) * theCacheAssoc]; }
+    uint8_t* setAges(uint64_t aBlock) { return &theAges[(aBlock & theSetMask) * theCacheAssoc]; }
+
+    // The way holding aTag, or -1. Compares the whole set without branching
+    // so that it vectorizes. Assoc is the associativity, or 0 for
+    // theCacheAssoc.
+    template<int32_t Assoc = 0>
+    int32_t find(uint64_t const* aTags, uint64_t aTag) const
+    {
+        const int32_t assoc = Assoc ? Assoc : theCacheAssoc;
+        uint64_t match      = 0;
+        for (int32_t i = 0; i < assoc; ++i) {
+            match |= uint64_t(aTags[i] == aTag) << i;
+        }
+        return match ? __builtin_ctzll(match) : -1;
+    }
+
+    // Makes aWay the MRU of its set; the ways younger than it age by one.
+    // The ages are bytes, which may alias anything, hence the local copies.
+    template<int32_t Assoc = 0>
+    void touch(uint8_t* anAges, int32_t aWay)
+    {
+        const int32_t assoc = Assoc ? Assoc : theCacheAssoc;
+        const uint8_t age   = anAges[aWay];
+        for (int32_t i = 0; i < assoc; ++i) {
+            anAges[i] += (anAges[i] < age);
         }
-        return false; // not present
+        anAges[aWay] = 0;
     }
 };
 
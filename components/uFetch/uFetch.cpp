@@ -6,6 +6,7 @@
 #include "components/MTManager/MTManager.hpp"
 #include "components/uArch/uArchInterfaces.hpp"
 #include "core/stats.hpp"
+#include "core/warming.hpp"
 
 #define FLEXUS_BEGIN_COMPONENT uFetch
 #include FLEXUS_BEGIN_COMPONENT_IMPLEMENTATION()
@@ -18,16 +19,48 @@ using namespace Flexus::Qemu;
 
 namespace nuFetch {
 
+using Flexus::Core::Warming;
+
+// The I-cache as QEMU's fetches warm it: a block is only ever shared, and
+// its eviction is only reported with clean evicts
+struct WarmedICache : public Warming::PrivateCache
+{
+    SimCache& theCache;
+    bool theCleanEvict;
+
+    WarmedICache(SimCache& aCache, bool aCleanEvict)
+      : theCache(aCache)
+      , theCleanEvict(aCleanEvict)
+    {
+    }
+
+    bool warmHit(uint64_t anAddress, Warming::eAccess) override { return theCache.lookup(anAddress); }
+    std::pair<Warming::eGrant, uint64_t> warmFill(uint64_t anAddress, Warming::eGrant) override
+    {
+        uint64_t victim = theCache.insert(anAddress);
+        return std::make_pair(victim && theCleanEvict ? Warming::kShared : Warming::kNone, victim);
+    }
+    Warming::eGrant warmInvalidate(uint64_t anAddress) override
+    {
+        return theCache.inval(anAddress) ? Warming::kShared : Warming::kNone;
+    }
+    Warming::eGrant warmDowngrade(uint64_t) override { return Warming::kShared; }
+};
+
 class FLEXUS_COMPONENT(uFetch)
 {
     FLEXUS_COMPONENT_IMPL(uFetch);
 
   private:
     // ==================== FetchAddressGenerate list =================
-    std::vector<std::list<FetchAddr>> theFAQ;
-    pFetchBundle waitingForOpcodeQueue;
-    BijectionMapType_t tr_op_bijection;
-    ExpectedTranslation_t translationsExpected;
+    std::vector<boost::circular_buffer<FetchAddr>> theFAQ;
+    // Fetched opcodes waiting for their translation, in fetch order, and the
+    // sequence number of the first one. theWaitingTranslations runs alongside
+    // and holds the outstanding translation of each, null once it returned.
+    boost::circular_buffer<FetchedOpcode> theWaitingOpcodes;
+    boost::circular_buffer<TranslationPtr> theWaitingTranslations;
+    uint64_t theWaitingHead;
+    pFetchBundle theBundle;
 
     // ================== STATS ==================
     Flexus::Stat::StatCounter theFetchAccesses;
@@ -63,6 +96,7 @@ class FLEXUS_COMPONENT(uFetch)
 
     // The I-cache
     SimCache theI;
+    std::unique_ptr<WarmedICache> theWarmedI;
 
     // ================== QUEUE ========================
     std::list<MemoryTransport> theMissQueue;
@@ -76,6 +110,7 @@ class FLEXUS_COMPONENT(uFetch)
   public:
     FLEXUS_COMPONENT_CONSTRUCTOR(uFetch)
       : base(FLEXUS_PASS_CONSTRUCTOR_ARGS)
+      , theWaitingHead(0)
       , theFetchAccesses(statName() + "-FetchAccess")
       , theFetches(statName() + "-Fetches")
       , thePrefetches(statName() + "-Prefetches")
@@ -98,10 +133,14 @@ class FLEXUS_COMPONENT(uFetch)
     void push(interface::iTranslationIn const&, TranslationPtr& retdTranslations)
     {
 
-        ExpectedTranslation_t::iterator tr_iter = translationsExpected.find(retdTranslations);
-        if (tr_iter != translationsExpected.end()) {
+        // Translations of squashed fetches, and those already answered, are
+        // not waited for any more
+        uint64_t waiting = retdTranslations->theSequence - theWaitingHead;
+        if (retdTranslations->theSequence >= theWaitingHead && waiting < theWaitingTranslations.size() &&
+            theWaitingTranslations[waiting] &&
+            TranslationPtrEqualityCheck()(theWaitingTranslations[waiting], retdTranslations)) {
             update_translation_response(retdTranslations);
-            translationsExpected.erase(tr_iter);
+            theWaitingTranslations[waiting] = nullptr;
         }
         DBG_(VVerb, (<< "Got response from iTranslationIn for PC " << retdTranslations->theVaddr));
     }
@@ -110,8 +149,10 @@ class FLEXUS_COMPONENT(uFetch)
     FLEXUS_PORT_ARRAY_ALWAYS_AVAILABLE(FetchAddressIn);
     void push(interface::FetchAddressIn const&, index_t anIndex, boost::intrusive_ptr<FetchCommand>& aCommand)
     {
-
-        std::copy(aCommand->theFetches.begin(), aCommand->theFetches.end(), std::back_inserter(theFAQ[anIndex]));
+        for (auto const& fetch : aCommand->theFetches) {
+            DBG_Assert(!theFAQ[anIndex].full(), (<< "FAQ overflow: the FAG ignored AvailableFAQ"));
+            theFAQ[anIndex].push_back(fetch);
+        }
     }
 
     // AvailableFAQOut
@@ -129,9 +170,9 @@ class FLEXUS_COMPONENT(uFetch)
         theFetchReplyTransactionTracker[anIndex] = nullptr;
         theIcachePrefetch[anIndex]               = boost::none;
         theLastPrefetchVTagSet[anIndex]          = 0;
-        waitingForOpcodeQueue->clear();
-        tr_op_bijection.clear();
-        translationsExpected.clear();
+        theWaitingHead += theWaitingOpcodes.size();
+        theWaitingOpcodes.clear();
+        theWaitingTranslations.clear();
     }
 
     // FetchMissIn
@@ -186,27 +227,24 @@ class FLEXUS_COMPONENT(uFetch)
                                    << std::dec));
         }
         uint32_t opcode = 0xffffffff;
-        // MARK: Look up in the opc bijection and get the correct index
-        BijectionMapType_t::iterator bijection_iter = tr_op_bijection.find(tr);
-        DBG_AssertSev(Crit,
-                      bijection_iter != tr_op_bijection.end(),
-                      Comp(*this)(<< "ERROR: Opcode index was NOT found for translationPtr with ID" << tr->theID
-                                  << " and address" << tr->theVaddr));
 
         // respect qemu result as flexus does not have pmp
         // TODO: but this should only happen for access faults
         if (!tr->isPagefault() && (magicTranslation == nuArch::kUnresolved)) tr->setPagefault();
 
-        if (!tr->isPagefault()) opcode = cpu(tr->theIndex).fetch_inst(tr->theVaddr);
+        if (!tr->isPagefault()) opcode = cpu(tr->theIndex).fetch_inst(magicTranslation);
 
-        waitingForOpcodeQueue->updateOpcode(tr->theVaddr, bijection_iter->second, opcode);
-        // Remove this mapping, opcode is updated
-        tr_op_bijection.erase(bijection_iter);
+        FetchedOpcode& waiting = theWaitingOpcodes[tr->theSequence - theWaitingHead];
+        DBG_AssertSev(Crit,
+                      waiting.thePC == tr->theVaddr,
+                      (<< "ERROR: waiting opcode did not match!! Opcode PC " << waiting.thePC
+                       << ", translation returned vaddr " << tr->theVaddr));
+        waiting.theOpcode = opcode;
     }
 
     void send_translation_request(index_t anIndex,
                                   VirtualMemoryAddress const& anAddress,
-                                  opcodeQIterator newOpcIterator)
+                                  uint64_t aSequence)
     {
 
         TranslationPtr xlat{ new Translation() };
@@ -214,21 +252,12 @@ class FLEXUS_COMPONENT(uFetch)
         xlat->theType      = Translation::eFetch;
         xlat->theException = 0; // just for now
         xlat->theIndex     = anIndex;
+        xlat->theSequence  = aSequence;
         xlat->setInstr();
 
-        // Insert an entry into the translation<->opcode map and outstanding translations expected
-        std::pair<BijectionMapType_t::iterator, bool> bijection_insertion =
-          tr_op_bijection.insert(std::make_pair(xlat, newOpcIterator));
-
-        DBG_(VVerb,
-             Comp(*this)(<< "Inserting xlat objection with vaddr " << xlat->theVaddr << " pointing to PC "
-                         << newOpcIterator->thePC << " into waitingForOpcodesQueue bijection "));
-        DBG_AssertSev(Iface,
-                      bijection_insertion.second == true,
-                      (<< "Inserting xlat object with vaddr " << xlat->theVaddr
-                       << " failed!! Clashing object has vaddr: " << bijection_insertion.first->first->theVaddr));
-
-        translationsExpected.emplace(xlat);
+        // The waiting opcode of this sequence number was just pushed
+        DBG_Assert(aSequence == theWaitingHead + theWaitingTranslations.size());
+        ringPush(theWaitingTranslations, xlat);
 
         DBG_(VVerb, Comp(*this)(<< "Adding translation request entry for " << xlat->theVaddr));
 
@@ -402,26 +431,21 @@ class FLEXUS_COMPONENT(uFetch)
     {
         FetchAddr fetch_addr = theFAQ[idx].front();
         VirtualMemoryAddress block_addr(fetch_addr.theAddress & theBlockMask);
-        std::set<VirtualMemoryAddress> available_lines;
 
-        if (available_lines.count(block_addr) == 0) {
-            // Line needs to be fetched from I-cache
-            if (available_lines.size() >= cfg.MaxFetchLines) {
-                // Reached limit of I-cache reads per cycle
-                return false;
-            }
-
-            // Notify the PowerTracker of Icache access
-            bool garbage = true;
-            FLEXUS_CHANNEL(InstructionFetchSeen) << garbage;
+        // Every address reads its line from the I-cache
+        if (cfg.MaxFetchLines == 0) {
+            // Reached limit of I-cache reads per cycle
+            return false;
+        }
 
-            if (cfg.PerfectICache) {
-                DBG_(Verb, (<< "FETCH UNIT: Instruction Cache disabled!"));
-            } else {
-                if (!l1i_lookup(idx, block_addr)) return false;
-            }
+        // Notify the PowerTracker of Icache access
+        bool garbage = true;
+        FLEXUS_CHANNEL(InstructionFetchSeen) << garbage;
 
-            available_lines.insert(block_addr);
+        if (cfg.PerfectICache) {
+            DBG_(Verb, (<< "FETCH UNIT: Instruction Cache disabled!"));
+        } else {
+            if (!l1i_lookup(idx, block_addr)) return false;
         }
 
         /* MARK: Pseudo-algorithm for rewritten translate->opcode->output code
@@ -433,16 +457,16 @@ class FLEXUS_COMPONENT(uFetch)
          */
         theFAQ[idx].pop_front();
 
-        waitingForOpcodeQueue->theOpcodes.emplace_back(
-          new FetchedOpcode(fetch_addr.theAddress,
-                            0xefffffff, // op_code not resolved yet - waiting for translation
-                            fetch_addr.theBPState,
-                            theFetchReplyTransactionTracker[idx]));
-
-        waitingForOpcodeQueue->theFillLevels.emplace_back(new tFillLevel(eL1I));
+        uint64_t sequence = theWaitingHead + theWaitingOpcodes.size();
+        ringPush(theWaitingOpcodes,
+                 FetchedOpcode(fetch_addr.theAddress,
+                               0xefffffff, // op_code not resolved yet - waiting for translation
+                               eL1I,
+                               fetch_addr.theBPState,
+                               theFetchReplyTransactionTracker[idx]));
 
         DBG_(VVerb, Comp(*this)(<< "added entry in waiting for opcode queue" << fetch_addr.theAddress));
-        send_translation_request(idx, fetch_addr.theAddress, *std::prev(waitingForOpcodeQueue->theOpcodes.end()));
+        send_translation_request(idx, fetch_addr.theAddress, sequence);
 
         return (theFAQ[idx].size() > 0);
     }
@@ -450,28 +474,25 @@ class FLEXUS_COMPONENT(uFetch)
     void process_available(uint32_t available_fiq)
     {
 
-        if (waitingForOpcodeQueue->theOpcodes.size() == 0) return;
-        if ((*waitingForOpcodeQueue->theOpcodes.begin())->theOpcode == 0xefffffff) return;
+        if (theWaitingOpcodes.empty()) return;
+        if (theWaitingOpcodes.front().theOpcode == 0xefffffff) return;
 
-        pFetchBundle bundle(new FetchBundle);
-        bundle->coreID = theBundleCoreID;
+        theBundle->clear();
 
         // Only pop fetched instructions up to the limit of decoder FIQ
-        while ((waitingForOpcodeQueue->theOpcodes.size() > 0) && (bundle->theOpcodes.size() < available_fiq)) {
-            auto i         = waitingForOpcodeQueue->theOpcodes.begin();
-            auto iter      = *i;
-            auto fill_iter = waitingForOpcodeQueue->theFillLevels.begin();
-
-            if (iter->theOpcode == 0xefffffff) break;
-
-            bundle->theOpcodes.emplace_back(*i);
-            bundle->theFillLevels.emplace_back(*fill_iter);
-            DBG_(VVerb, Comp(*this)(<< "popping entry out of the waitingForOpcodeQueue " << iter->thePC));
-            waitingForOpcodeQueue->theOpcodes.erase(i);
-            waitingForOpcodeQueue->theFillLevels.erase(fill_iter);
+        while (!theWaitingOpcodes.empty() && (theBundle->theOpcodes.size() < available_fiq)) {
+            FetchedOpcode const& waiting = theWaitingOpcodes.front();
+
+            if (waiting.theOpcode == 0xefffffff) break;
+
+            theBundle->theOpcodes.push_back(waiting);
+            DBG_(VVerb, Comp(*this)(<< "popping entry out of the waiting opcodes " << waiting.thePC));
+            theWaitingOpcodes.pop_front();
+            theWaitingTranslations.pop_front();
+            ++theWaitingHead;
         }
 
-        if (bundle->theOpcodes.size() > 0) { FLEXUS_CHANNEL_ARRAY(FetchBundleOut, 0) << bundle; }
+        if (theBundle->theOpcodes.size() > 0) { FLEXUS_CHANNEL_ARRAY(FetchBundleOut, 0) << theBundle; }
     }
 
     void doFetch(index_t idx)
@@ -564,14 +585,23 @@ class FLEXUS_COMPONENT(uFetch)
     }
     void initialize() override
     {
-
-        theI.init(cfg.Size, cfg.Associativity, cfg.ICacheLineSize, statName());
+        {
+            Flexus::Core::ComponentArena::Scope tables(coreArena());
+            theI.init(cfg.Size, cfg.Associativity, cfg.ICacheLineSize, statName());
+        }
+        if (!cfg.PerfectICache) {
+            theWarmedI.reset(new WarmedICache(theI, cfg.CleanEvict));
+            Warming::attachPrivate(Warming::sharer(flexusIndex(), true), theWarmedI.get());
+        }
         theIndexShift                 = LOG2(cfg.ICacheLineSize);
         theBlockMask                  = ~(cfg.ICacheLineSize - 1);
         theBundleCoreID               = flexusIndex();
-        waitingForOpcodeQueue         = new FetchBundle();
-        waitingForOpcodeQueue->coreID = theBundleCoreID;
-        theFAQ.resize(cfg.Threads);
+        theBundle                     = new FetchBundle();
+        theBundle->coreID             = theBundleCoreID;
+        theBundle->theOpcodes.reserve(cfg.FAQSize);
+        theWaitingOpcodes.set_capacity(cfg.FAQSize + cfg.MaxFetchInstructions);
+        theWaitingTranslations.set_capacity(cfg.FAQSize + cfg.MaxFetchInstructions);
+        theFAQ.assign(cfg.Threads, boost::circular_buffer<FetchAddr>(cfg.FAQSize));
         theIcacheMiss.resize(cfg.Threads);
         theIcacheVMiss.resize(cfg.Threads);
         theFetchReplyTransactionTracker.resize(cfg.Threads);
@@ -580,6 +610,19 @@ class FLEXUS_COMPONENT(uFetch)
         theLastPrefetchVTagSet.resize(cfg.Threads);
     }
     void finalize() override {}
+
+    // Quiesced once no miss, prefetch or evict is still on its way
+    bool isQuiesced() const override
+    {
+        if (!theMissQueue.empty() || !theSnoopQueue.empty() || !theReplyQueue.empty() || !theEvictSet.empty()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < theIcacheMiss.size(); ++i) {
+            if (theIcacheMiss[i] || theIcachePrefetch[i]) return false;
+        }
+        return true;
+    }
+
     void drive(interface::uFetchDrive const&) override
     {
 
@@ -1,12 +1,14 @@
 #ifndef FLEXUS_uFETCH_TYPES_HPP_INCLUDED
 #define FLEXUS_uFETCH_TYPES_HPP_INCLUDED
 
+#include "components/CommonQEMU/Slices/FillLevel.hpp"
 #include "components/CommonQEMU/Translation.hpp"
 #include "core/types.hpp"
 
+#include <algorithm>
+#include <boost/circular_buffer.hpp>
 #include <cstdint>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 using boost::counted_base;
 using Flexus::SharedTypes::TransactionTracker;
@@ -19,21 +21,7 @@ namespace Flexus::SharedTypes {
 typedef uint32_t Opcode;
 
 struct FetchBundle;   // Forward declaration
-struct FetchedOpcode; // Forward declaration
 typedef boost::intrusive_ptr<FetchBundle> pFetchBundle;
-typedef std::shared_ptr<FetchedOpcode> opcodeQIterator;
-typedef std::unordered_map<TranslationPtr,
-                           opcodeQIterator,            // K/V
-                           TranslationPtrHasher,       // Custom hash object
-                           TranslationPtrEqualityCheck // Custom equality comparison
-                           >
-  BijectionMapType_t;
-
-typedef std::unordered_set<TranslationPtr,             // Key
-                           TranslationPtrHasher,       // Custom hash
-                           TranslationPtrEqualityCheck // Custom equality
-                           >
-  ExpectedTranslation_t;
 
 // =========== ENUM ===================
 enum eBranchType
@@ -57,6 +45,9 @@ enum eDirection
     kStronglyNotTaken
 };
 
+// Upper bound on the number of TAGE tagged tables
+static const int kTageMaxTables = 15;
+
 // =========== STRUCT ===================
 struct BPredState : boost::counted_base
 {
@@ -74,13 +65,13 @@ struct BPredState : boost::counted_base
     eDirection theActualDirection;
 
     bool theTageHistoryValid;
-    int phist;
-    std::bitset<131> ghist; // Fixme: replace 131 with a correct macro
-    unsigned ch_i[15];
-    unsigned ch_t[2][15];
+    uint16_t phist;
+    uint64_t ghist_head; // position in the TAGE history ring
+    uint16_t ch_i[kTageMaxTables];
+    uint16_t ch_t[2][kTageMaxTables];
 
     bool theTagePredictionValid;
-    int GI[15]; // 15 is random, upper bound on #tables?
+    uint16_t GI[kTageMaxTables];
     int BI;
     int bank;
     int altbank;
@@ -151,58 +142,60 @@ struct FetchAddr
     }
 };
 
+// Reused by the FAG every cycle; the FAQ copies the fetches out
 struct FetchCommand : boost::counted_base
 {
-    std::list<FetchAddr> theFetches;
+    std::vector<FetchAddr> theFetches;
 };
 
 struct FetchedOpcode
 {
     VirtualMemoryAddress thePC;
     Opcode theOpcode;
+    tFillLevel theFillLevel; // Level in memory hierarchy from where the instruction was fetched
     boost::intrusive_ptr<BPredState> theBPState;
     boost::intrusive_ptr<TransactionTracker> theTransaction;
 
     FetchedOpcode(Opcode anOpcode)
       : theOpcode(anOpcode)
+      , theFillLevel(eL1I)
     {
     }
 
     FetchedOpcode(VirtualMemoryAddress anAddr,
                   Opcode anOpcode,
+                  tFillLevel aFillLevel,
                   boost::intrusive_ptr<BPredState> aBPState,
                   boost::intrusive_ptr<TransactionTracker> aTransaction)
       : thePC(anAddr)
       , theOpcode(anOpcode)
+      , theFillLevel(aFillLevel)
       , theBPState(aBPState)
       , theTransaction(aTransaction)
     {
     }
 };
 
+// Reused by uFetch every cycle; the decoder copies the opcodes out
 struct FetchBundle : public boost::counted_base
 {
-    std::list<std::shared_ptr<FetchedOpcode>> theOpcodes;
-    std::list<std::shared_ptr<tFillLevel>>
-      theFillLevels; // Level in memory hierarchy from where the instruction was fetched
+    std::vector<FetchedOpcode> theOpcodes;
     int32_t coreID;
 
-    void updateOpcode(VirtualMemoryAddress anAddress, std::shared_ptr<FetchedOpcode> it, Opcode anOpcode)
-    {
-        DBG_AssertSev(Crit,
-                      it->thePC == anAddress,
-                      (<< "ERROR: FetchedOpcode iterator did not match!! Iterator PC " << it->thePC
-                       << ", translation returned vaddr " << anAddress));
-        it->theOpcode = anOpcode;
-    }
-
-    void clear()
-    {
-        theOpcodes.clear();
-        theFillLevels.clear();
-    }
+    void clear() { theOpcodes.clear(); }
 };
 
+// Appends to a frontend queue preallocated for the steady state. A queue
+// that overflows (multi-uop instructions in the FIQ, fetch running ahead of
+// a full FIQ) doubles once rather than dropping its oldest entry.
+template<class T>
+void
+ringPush(boost::circular_buffer<T>& aQueue, T const& aValue)
+{
+    if (aQueue.full()) aQueue.set_capacity(std::max<std::size_t>(2 * aQueue.capacity(), 8));
+    aQueue.push_back(aValue);
+}
+
 } // FLEXUS::SHAREDTYPES
 
 #endif
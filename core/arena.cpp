@@ -0,0 +1,176 @@
+#include <core/arena.hpp>
+#include <core/debug/debug.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace Flexus {
+namespace Core {
+
+namespace {
+
+// Linux MPOL_BIND, numaif.h is not always available
+const int kMPolBind = 2;
+
+struct Arena
+{
+    char* theBase;
+    char* theCursor;
+    char* theEnd;
+};
+
+// All arenas are slices of a single reservation so that owns() is a single
+// range check on the free path.
+char* theReservationBase = nullptr;
+char* theReservationEnd  = nullptr;
+std::vector<Arena>* theArenas = nullptr;
+
+thread_local index_t theCurrentArena = ComponentArena::kNoArena;
+
+void*
+reserve(std::size_t aSize, bool aHugePages)
+{
+    void* mem = MAP_FAILED;
+    if (aHugePages) {
+        mem = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem == MAP_FAILED) {
+            DBG_(Dev, (<< "No hugetlbfs pages available for core arenas, falling back to transparent huge pages"));
+        }
+    }
+    if (mem == MAP_FAILED) {
+        mem = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mem == MAP_FAILED) return nullptr;
+        if (aHugePages) madvise(mem, aSize, MADV_HUGEPAGE);
+    }
+    return mem;
+}
+
+} // namespace
+
+void
+ComponentArena::configure(index_t aCoreCount)
+{
+    char const* spec = getenv("FLEXUS_CORE_ARENA");
+    if (spec == nullptr || aCoreCount == 0 || theArenas != nullptr) return;
+
+#ifndef FLEXUS_CORE_ARENA
+    DBG_(Crit, (<< "FLEXUS_CORE_ARENA is set but this build lacks CORE_ARENA support, ignoring it"));
+    return;
+#endif
+
+    std::string args(spec);
+    std::size_t mib     = std::strtoull(args.c_str(), nullptr, 10);
+    bool huge_pages     = args.find("hugepages") != std::string::npos;
+    std::size_t numa_at = args.find("numa=");
+    uint64_t nodes      = (numa_at == std::string::npos) ? 0 : std::strtoull(args.c_str() + numa_at + 5, nullptr, 10);
+
+    if (mib == 0) {
+        DBG_(Crit, (<< "FLEXUS_CORE_ARENA: invalid arena size '" << args << "', core arenas disabled"));
+        return;
+    }
+
+    // keep every slice 2MB aligned so huge pages never straddle two cores
+    const std::size_t huge_page = 2 << 20;
+    std::size_t slice           = ((mib << 20) + huge_page - 1) & ~(huge_page - 1);
+    char* base                  = static_cast<char*>(reserve(slice * aCoreCount, huge_pages));
+    if (base == nullptr) {
+        DBG_(Crit, (<< "FLEXUS_CORE_ARENA: unable to reserve " << mib << "MiB per core, core arenas disabled"));
+        return;
+    }
+
+    theArenas = new std::vector<Arena>(aCoreCount);
+    for (index_t i = 0; i < aCoreCount; ++i) {
+        Arena& arena    = (*theArenas)[i];
+        arena.theBase   = base + i * slice;
+        arena.theCursor = arena.theBase;
+        arena.theEnd    = arena.theBase + slice;
+
+        if (nodes > 0) {
+            uint64_t node = (uint64_t(i) * nodes) / aCoreCount;
+            uint64_t mask = uint64_t(1) << node;
+            if (syscall(SYS_mbind, arena.theBase, slice, kMPolBind, &mask, 64, 0) != 0) {
+                DBG_(Dev, (<< "FLEXUS_CORE_ARENA: mbind of core " << i << " to node " << node << " failed"));
+            }
+        }
+    }
+    theReservationBase = base;
+    theReservationEnd  = base + slice * aCoreCount;
+
+    DBG_(Dev,
+         (<< "Core arenas: " << aCoreCount << " x " << (slice >> 20) << "MiB" << (huge_pages ? ", huge pages" : "")
+          << (nodes ? ", spread over " + std::to_string(nodes) + " NUMA nodes" : "")));
+}
+
+bool
+ComponentArena::enabled()
+{
+    return theArenas != nullptr;
+}
+
+void*
+ComponentArena::allocate(std::size_t aSize)
+{
+    if (theCurrentArena == kNoArena) return nullptr;
+
+    Arena& arena = (*theArenas)[theCurrentArena];
+    char* ptr    = arena.theCursor;
+    std::size_t aligned = (aSize + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    if (aligned > std::size_t(arena.theEnd - ptr)) return nullptr;
+
+    arena.theCursor = ptr + aligned;
+    return ptr;
+}
+
+bool
+ComponentArena::owns(void const* aPointer)
+{
+    return aPointer >= theReservationBase && aPointer < theReservationEnd;
+}
+
+ComponentArena::Scope::Scope(index_t anIndex)
+  : thePrevious(theCurrentArena)
+{
+    theCurrentArena = (theArenas != nullptr && anIndex < theArenas->size()) ? anIndex : kNoArena;
+}
+
+ComponentArena::Scope::~Scope()
+{
+    theCurrentArena = thePrevious;
+}
+
+} // namespace Core
+} // namespace Flexus
+
+#ifdef FLEXUS_CORE_ARENA
+// Route the plain (unaligned) heap entry points through the current core
+// arena. The array, nothrow and sized variants of libstdc++ forward to these.
+void*
+operator new(std::size_t aSize)
+{
+    if (void* ptr = Flexus::Core::ComponentArena::allocate(aSize)) return ptr;
+    if (aSize == 0) aSize = 1;
+    while (true) {
+        if (void* ptr = std::malloc(aSize)) return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void
+operator delete(void* aPointer) noexcept
+{
+    if (!Flexus::Core::ComponentArena::owns(aPointer)) std::free(aPointer);
+}
+
+void
+operator delete(void* aPointer, std::size_t) noexcept
+{
+    if (!Flexus::Core::ComponentArena::owns(aPointer)) std::free(aPointer);
+}
+#endif
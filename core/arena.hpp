@@ -0,0 +1,73 @@
+#ifndef FLEXUS_CORE_ARENA_HPP_INCLUDED
+#define FLEXUS_CORE_ARENA_HPP_INCLUDED
+
+#include <core/types.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Per-core memory arenas.
+ *
+ * When enabled, every component instance that belongs to core i (the arrays
+ * instantiated with SCALE_WITH_SYSTEM_WIDTH and one instance per core) is
+ * constructed while arena i is current, and opens a Scope on it (see
+ * FlexusComponentBase::coreArena()) around the tables its initialize()
+ * builds. All heap allocations made on that thread while the arena is
+ * current are carved out of one contiguous, optionally huge-page backed and
+ * NUMA bound, slice of memory. Driving core i then touches a compact working
+ * set instead of objects scattered across the heap.
+ *
+ * Only allocations that live for the whole run belong in an arena: the rest
+ * of initialize() and loadState() run outside of it, since their
+ * temporaries would never be reclaimed.
+ *
+ * The mode is selected at startup with the FLEXUS_CORE_ARENA environment
+ * variable:
+ *
+ *    FLEXUS_CORE_ARENA=<MiB per core>[,hugepages][,numa=<nodes>]
+ *
+ * Cores are split in contiguous blocks over <nodes> NUMA nodes. Allocation
+ * routing needs the CORE_ARENA build option; otherwise the variable is ignored.
+ * Arena memory is never handed back: frees inside an arena are no-ops, and an
+ * exhausted arena silently falls back to the regular heap.
+ */
+class ComponentArena
+{
+  public:
+    static constexpr index_t kNoArena = ~index_t(0);
+
+    // Reads FLEXUS_CORE_ARENA and reserves one arena per core.
+    static void configure(index_t aCoreCount);
+    static bool enabled();
+
+    // Allocation from the current arena, or nullptr if there is none or it
+    // is full.
+    static void* allocate(std::size_t aSize);
+    static bool owns(void const* aPointer);
+
+    // Makes arena anIndex current on this thread for the lifetime of the scope.
+    class Scope
+    {
+        index_t thePrevious;
+
+      public:
+        explicit Scope(index_t anIndex);
+        ~Scope();
+        Scope(Scope const&)            = delete;
+        Scope& operator=(Scope const&) = delete;
+    };
+
+    // Maps an element of a component array to the core arena it lives in.
+    static index_t affinity(index_t anIndex, index_t aWidth, index_t aSystemWidth)
+    {
+        return (aWidth == aSystemWidth) ? anIndex : kNoArena;
+    }
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CORE_ARENA_HPP_INCLUDED
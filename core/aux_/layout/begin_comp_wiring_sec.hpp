@@ -17,6 +17,8 @@
 
 #endif // FLEXUS__CORE_TEST
 
+#include <core/aux_/wiring/recording.hpp>
+
 #ifdef FLEXUS__CORE_TEST
 #define nFLEXUS FLEXUS__CORE_TEST
 #else
@@ -36,7 +38,11 @@ namespace Wiring {
       &resolve_channel<ToInstance,                                                                                     \
                        ToInstance::iface::ToPort,                                                                      \
                        ToInstance::iface::ToPort::port_type,                                                           \
-                       ToInstance::iface::ToPort::is_array>::invoke_manip; /**/
+                       ToInstance::iface::ToPort::is_array>::invoke_manip;                                             \
+    tap_wire<ToInstance, ToInstance::iface::ToPort>(                                                                   \
+      BOOST_PP_CAT(FromInstance, _instance).theJumpTable.BOOST_PP_CAT(wire_manip_, FromPort),                          \
+      #ToInstance "." #ToPort,                                                                                         \
+      #FromInstance "." #FromPort " -> " #ToInstance "." #ToPort); /**/
 
 void
 connectWiring()
@@ -28,3 +28,4 @@ using namespace Flexus::SharedTypes;
 #define PORT_ARRAY(x, y, z, w)      FLEXUS_IFACE_PORT_ARRAY(x, y, z, w)
 #define DYNAMIC_PORT_ARRAY(x, y, z) FLEXUS_IFACE_DYNAMIC_PORT_ARRAY(x, y, z)
 #define DRIVE(x)                    FLEXUS_IFACE_DRIVE(x)
+#define INDEPENDENT_DRIVE(x)        FLEXUS_IFACE_INDEPENDENT_DRIVE(x)
@@ -11,6 +11,7 @@
 #undef COMPONENT_INTERFACE
 #undef PORT
 #undef DRIVE
+#undef INDEPENDENT_DRIVE
 
 #undef FLEXUS_BEGIN_COMPONENT
 #undef FLEXUS_END_COMPONENT
@@ -10,6 +10,7 @@
 #include <boost/serialization/vector.hpp>
 #include <cmath>
 #include <core/boost_extensions/intrusive_ptr.hpp>
+#include <core/debug/debug.hpp>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -17,6 +18,7 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 namespace Flexus {
@@ -65,8 +67,16 @@ struct StatValueBase : public boost::counted_base
     {
         throw 1; /* by default, stat's don't support sum accumulation */
     }
-    virtual void reduceSum(StatValueBase const& anRHS) {};
-    virtual void reduceSum(StatValueBase const* anRHS) {};
+    // Merging the live values needs every stat type to sum; one that cannot
+    // would silently drop its values
+    virtual void reduceSum(StatValueBase const& anRHS)
+    {
+        DBG_Assert(false, (<< "Reductions not supported (" << typeid(*this).name() << ")"));
+    }
+    virtual void reduceSum(StatValueBase const* anRHS)
+    {
+        DBG_Assert(false, (<< "Reductions not supported (" << typeid(*this).name() << ")"));
+    }
     virtual boost::intrusive_ptr<StatValueBase> avgAccumulator()
     {
         throw 1; /* by default, stat's don't support average accumulation */
@@ -256,6 +266,7 @@ class StatValueArrayHandle : public StatValueHandle_Base
     friend std::ostream& operator<<(std::ostream& anOstream, StatValueArrayHandle const& aValueHandle);
     void print(std::ostream& anOstream, std::string const& options = std::string(""));
     void newValue(accumulation_type anAccumulationType);
+    void mergeCurrent(StatValueBase const& aSegment);
     int64_t asLongLong();
     int64_t asLongLong(std::string const& options);
 };
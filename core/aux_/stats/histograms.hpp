@@ -10,7 +10,9 @@
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 #include <cmath>
+#include <core/boost_extensions/compact_serialization.hpp>
 #include <core/boost_extensions/intrusive_ptr.hpp>
 #include <functional>
 #include <iomanip>
@@ -69,7 +71,7 @@ class StatValue_Log2Histogram
     void serialize(Archive& ar, uint32_t version)
     {
         ar& boost::serialization::base_object<StatValueBase>(*this);
-        ar & theBuckets;
+        boost::serialization::compact::values(ar, theBuckets, version);
     }
     StatValue_Log2Histogram() {}
 
@@ -164,7 +166,7 @@ class StatValue_WeightedLog2Histogram
     void serialize(Archive& ar, uint32_t version)
     {
         ar& boost::serialization::base_object<StatValueBase>(*this);
-        ar & theBuckets;
+        boost::serialization::compact::values(ar, theBuckets, version);
     }
     StatValue_WeightedLog2Histogram() {}
 
@@ -260,8 +262,8 @@ class StatValue_StdDevLog2Histogram
     void serialize(Archive& ar, uint32_t version)
     {
         ar& boost::serialization::base_object<StatValueBase>(*this);
-        ar & theBuckets;
-        ar & theBucketCounts;
+        boost::serialization::compact::values(ar, theBuckets, version);
+        boost::serialization::compact::values(ar, theBucketCounts, version);
     }
     StatValue_StdDevLog2Histogram() {}
 
@@ -290,6 +292,7 @@ class StatValue_StdDevLog2Histogram
 
   public:
     StatValue_StdDevLog2Histogram(value_type /*ignored*/) {}
+    void reduceSum(const StatValueBase& aBase) { collapse(&aBase); }
     void collapse(const StatValueBase* aBase)
     {
         const StatValue_StdDevLog2Histogram* ptr = dynamic_cast<const StatValue_StdDevLog2Histogram*>(aBase);
@@ -306,6 +309,7 @@ class StatValue_StdDevLog2Histogram
             theBucketCounts.resize(aHistogram.theBucketCounts.size(), 0);
         }
         for (int32_t i = 0; i < static_cast<int>(aHistogram.theBuckets.size()); ++i) {
+            if (aHistogram.theBucketCounts[i] == 0) continue;
             theBuckets[i] =
               calculate(theBuckets[i], theBucketCounts[i], aHistogram.theBuckets[i], aHistogram.theBucketCounts[i]);
             theBucketCounts[i] += aHistogram.theBucketCounts[i];
@@ -852,4 +856,9 @@ class StatValueArray_InstanceCounter : public StatValueArrayBase
 } // namespace Stat
 } // namespace Flexus
 
+// Version 1 stores the buckets with compact::save_values
+BOOST_CLASS_VERSION(Flexus::Stat::aux_::StatValue_Log2Histogram, 1)
+BOOST_CLASS_VERSION(Flexus::Stat::aux_::StatValue_WeightedLog2Histogram, 1)
+BOOST_CLASS_VERSION(Flexus::Stat::aux_::StatValue_StdDevLog2Histogram, 1)
+
 #endif // FLEXUS_CORE_AUX__STATS_HISTOGRAMS__HPP__INCLUDED
\ No newline at end of file
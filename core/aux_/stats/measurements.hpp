@@ -132,6 +132,42 @@ class SimpleMeasurement : public Measurement
     void reduceNodes();
 };
 
+// One live value per stat, shared by every periodic measurement over it.
+//
+// Periodic measurements do not link updaters of their own into a stat.
+// The first one to include a stat opens a live value for it and each
+// measurement subscribes to that value. At a cut, the value gathered since
+// the previous cut (a segment) is handed to every subscriber, which merges
+// it into its open period with reduceSum(), and a fresh live value takes
+// its place. A stat update therefore costs the same however many periodic
+// measurements are open. Segments restart from the stat's initial value,
+// so stats under periodic measurement are expected to start at zero.
+class LiveStats
+{
+    struct Subscription
+    {
+        Measurement* theMeasurement;
+        std::function<void(StatValueBase const&)> theMerge;
+    };
+
+    struct LiveStat
+    {
+        StatValueHandle theValue;
+        std::vector<Subscription> theSubscriptions;
+    };
+
+    std::map<Stat*, LiveStat> theLiveStats;
+
+  public:
+    void subscribe(Stat* aStat, Measurement* aMeasurement, std::function<void(StatValueBase const&)> aMerge);
+    // Drops live values that no measurement needs any more
+    void unsubscribe(Measurement* aMeasurement);
+    void cut();
+};
+
+LiveStats&
+liveStats();
+
 class PeriodicMeasurement : public Measurement
 {
     typedef std::map<std::string, StatValueArrayHandle> stat_handle_map;
@@ -159,7 +195,7 @@ class PeriodicMeasurement : public Measurement
                         std::string const& aStatExpression,
                         int64_t aPeriod,
                         accumulation_type anAccumulationType);
-    virtual ~PeriodicMeasurement() {}
+    virtual ~PeriodicMeasurement();
 
     void addToMeasurement(Stat* aStat);
     void close();
@@ -172,6 +208,7 @@ class LoggedPeriodicMeasurement : public Measurement
 {
     typedef std::map<std::string, StatValueHandle> stat_handle_map;
     stat_handle_map theStats;
+    std::vector<Stat*> theSources; // to start empty periods under Reset
     int64_t thePeriod;
     int64_t theCurrentPeriod;
     bool theCancelled;
@@ -201,13 +238,16 @@ class LoggedPeriodicMeasurement : public Measurement
                               int64_t aPeriod,
                               accumulation_type anAccumulationType,
                               std::ostream& anOstream);
-    virtual ~LoggedPeriodicMeasurement() {}
+    virtual ~LoggedPeriodicMeasurement();
 
     void addToMeasurement(Stat* aStat);
     void close();
     void print(std::ostream& anOstream, std::string const& options = std::string(""));
     void format(std::ostream& anOstream, std::string const& aStat, std::string const& options = std::string(""));
     void fire();
+
+  private:
+    void printRow(std::ostream& anOstream);
 };
 
 } // namespace aux_
@@ -0,0 +1,66 @@
+#ifndef FLEXUS_AUX__WIRING_RECORDING_HPP_INCLUDED
+#define FLEXUS_AUX__WIRING_RECORDING_HPP_INCLUDED
+
+#include <core/aux_/wiring/channels.hpp>
+#include <core/port_recorder.hpp>
+#include <type_traits>
+
+namespace Flexus {
+namespace Wiring {
+
+// Channel that records the traffic of a tapped wire before (push) or after
+// (pull) passing it on to the destination port.
+template<class ToInstance, class ToPort, class Type, bool isArray>
+struct record_channel
+{
+    typedef resolve_channel<ToInstance, ToPort, Type, isArray> channel;
+    typedef typename ToPort::payload payload;
+    static int32_t theChannel;
+
+    static void record(Flexus::Core::index_t anIndex, payload& aPayload)
+    {
+        Flexus::Core::PortRecorder& recorder = Flexus::Core::PortRecorder::recorder();
+        std::string& buffer                  = recorder.scratch();
+        Flexus::Core::PortWriter out(buffer);
+        Flexus::Core::port_codec<payload>::write(out, aPayload);
+        recorder.record(theChannel, anIndex, buffer);
+    }
+
+    static void invoke_manip(Flexus::Core::index_t anIndex, payload& aPayload)
+    {
+        if (std::is_same<Type, pull>::value) {
+            channel::invoke_manip(anIndex, aPayload);
+            record(anIndex, aPayload);
+        } else {
+            record(anIndex, aPayload);
+            channel::invoke_manip(anIndex, aPayload);
+        }
+    }
+};
+
+template<class ToInstance, class ToPort, class Type, bool isArray>
+int32_t record_channel<ToInstance, ToPort, Type, isArray>::theChannel = -1;
+
+// Routes aManip through record_channel if the destination port was selected
+// for recording and its payload can be encoded
+template<class ToInstance, class ToPort, class ManipFn>
+void
+tap_wire(ManipFn& aManip, char const* aDestination, char const* aWire)
+{
+    typedef typename ToPort::payload payload;
+    typedef record_channel<ToInstance, ToPort, typename ToPort::port_type, ToPort::is_array> recorded;
+
+    if constexpr (Flexus::Core::port_codec<payload>::recordable) {
+        int32_t channel =
+          Flexus::Core::PortRecorder::recorder().tap(aDestination, aWire, Flexus::Core::port_codec<payload>::name());
+        if (channel >= 0) {
+            recorded::theChannel = channel;
+            aManip               = &recorded::invoke_manip;
+        }
+    }
+}
+
+} // namespace Wiring
+} // namespace Flexus
+
+#endif // FLEXUS_AUX__WIRING_RECORDING_HPP_INCLUDED
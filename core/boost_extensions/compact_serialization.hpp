@@ -0,0 +1,166 @@
+#ifndef FLEXUS_CORE_BOOST_EXTENSIONS_COMPACT_SERIALIZATION_INCLUDED
+#define FLEXUS_CORE_BOOST_EXTENSIONS_COMPACT_SERIALIZATION_INCLUDED
+
+#include <algorithm>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace serialization {
+
+/*
+ * Compact encodings for the bulky members of checkpoints and stats archives.
+ *
+ * Values are packed into a byte string with LEB128 varints, and the archive
+ * stores that string in one go. Signed values are zig-zag encoded first, so
+ * that small negative numbers stay small, and runs of zeros (empty histogram
+ * buckets) take two bytes whatever their length.
+ *
+ * The callers bump their class version when they switch to these encodings,
+ * and keep reading the previous encoding at the old version.
+ */
+namespace compact {
+
+inline void
+putVarint(std::string& aBuffer, uint64_t aValue)
+{
+    while (aValue >= 0x80) {
+        aBuffer.push_back(char(aValue | 0x80));
+        aValue >>= 7;
+    }
+    aBuffer.push_back(char(aValue));
+}
+
+inline uint64_t
+getVarint(std::string const& aBuffer, std::size_t& aPos)
+{
+    uint64_t value = 0;
+    for (int32_t shift = 0; aPos < aBuffer.size() && shift < 64; shift += 7) {
+        uint8_t byte = aBuffer[aPos++];
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) break;
+    }
+    return value;
+}
+
+inline uint64_t
+zigzag(int64_t aValue)
+{
+    return (uint64_t(aValue) << 1) ^ uint64_t(aValue >> 63);
+}
+
+inline int64_t
+unzigzag(uint64_t aValue)
+{
+    return int64_t(aValue >> 1) ^ -int64_t(aValue & 1);
+}
+
+// The size, then every value zig-zag encoded, except that a zero is
+// followed by the number of zeros after it
+template<class Archive>
+void
+save_values(Archive& ar, std::vector<int64_t> const& aValues)
+{
+    std::string packed;
+    putVarint(packed, aValues.size());
+    for (std::size_t i = 0; i < aValues.size(); ++i) {
+        putVarint(packed, zigzag(aValues[i]));
+        if (aValues[i] == 0) {
+            std::size_t run = 0;
+            while (i + 1 < aValues.size() && aValues[i + 1] == 0) {
+                ++run;
+                ++i;
+            }
+            putVarint(packed, run);
+        }
+    }
+    ar << packed;
+}
+
+template<class Archive>
+void
+load_values(Archive& ar, std::vector<int64_t>& aValues)
+{
+    std::string packed;
+    ar >> packed;
+    std::size_t pos = 0;
+    aValues.assign(getVarint(packed, pos), 0);
+    for (std::size_t i = 0; i < aValues.size() && pos < packed.size(); ++i) {
+        aValues[i] = unzigzag(getVarint(packed, pos));
+        if (aValues[i] == 0) i += getVarint(packed, pos);
+    }
+}
+
+// For a serialize() member of a class whose version aCompactVersion switched
+// aValues from a plain vector to save_values()
+template<class Archive>
+void
+values(Archive& ar, std::vector<int64_t>& aValues, uint32_t aVersion, uint32_t aCompactVersion = 1)
+{
+    if (aVersion < aCompactVersion) {
+        ar & aValues;
+    } else if constexpr (Archive::is_saving::value) {
+        save_values(ar, aValues);
+    } else {
+        load_values(ar, aValues);
+    }
+}
+
+// A bit set of aCount 64-bit words, as whichever of its raw words or the
+// gaps between its set bits is shorter. Sharer sets usually have one or two
+// bits set out of hundreds.
+template<class Archive>
+void
+save_bits(Archive& ar, uint64_t const* aWords, std::size_t aCount)
+{
+    std::string sparse(1, 's');
+    uint64_t last = 0;
+    for (std::size_t w = 0; w < aCount && sparse.size() <= aCount * 8; ++w) {
+        for (uint64_t bits = aWords[w]; bits != 0; bits &= bits - 1) {
+            uint64_t bit = w * 64 + __builtin_ctzll(bits);
+            putVarint(sparse, bit - last);
+            last = bit + 1;
+        }
+    }
+    if (sparse.size() <= aCount * 8) {
+        ar << sparse;
+        return;
+    }
+    std::string dense(1, 'd');
+    for (std::size_t w = 0; w < aCount; ++w) {
+        for (int32_t b = 0; b < 64; b += 8) {
+            dense.push_back(char(aWords[w] >> b));
+        }
+    }
+    ar << dense;
+}
+
+template<class Archive>
+void
+load_bits(Archive& ar, uint64_t* aWords, std::size_t aCount)
+{
+    std::string packed;
+    ar >> packed;
+    std::fill(aWords, aWords + aCount, 0);
+    if (packed.empty()) return;
+    std::size_t pos = 1;
+    if (packed[0] == 's') {
+        for (uint64_t bit = 0; pos < packed.size(); ++bit) {
+            bit += getVarint(packed, pos);
+            if (bit < aCount * 64) aWords[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    } else {
+        for (std::size_t i = 0; pos < packed.size() && i < aCount * 8; ++i, ++pos) {
+            aWords[i / 8] |= uint64_t(uint8_t(packed[pos])) << (i % 8 * 8);
+        }
+    }
+}
+
+} // namespace compact
+} // namespace serialization
+} // namespace boost
+
+#endif // FLEXUS_CORE_BOOST_EXTENSIONS_COMPACT_SERIALIZATION_INCLUDED
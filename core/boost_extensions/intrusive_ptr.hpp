@@ -11,6 +11,11 @@ struct counted_base
 {
     mutable int32_t theRefCount;
 
+    // Set once, before the uncore pool starts its workers: from then on
+    // counts are updated atomically, since a transport may be referenced
+    // from several threads
+    static inline bool theThreadShared = false;
+
     counted_base()
       : theRefCount(0)
     {
@@ -22,14 +27,22 @@ template<class T>
 void
 intrusive_ptr_add_ref(T* p)
 {
-    static_cast<boost::counted_base const*>(p)->theRefCount++;
+    int32_t& count = static_cast<boost::counted_base const*>(p)->theRefCount;
+    if (boost::counted_base::theThreadShared) {
+        __atomic_add_fetch(&count, 1, __ATOMIC_RELAXED);
+    } else {
+        ++count;
+    }
 }
 
 template<class T>
 void
 intrusive_ptr_release(T* p)
 {
-    if (--static_cast<boost::counted_base const*>(p)->theRefCount == 0) { delete p; }
+    int32_t& count = static_cast<boost::counted_base const*>(p)->theRefCount;
+    if (boost::counted_base::theThreadShared ? __atomic_sub_fetch(&count, 1, __ATOMIC_ACQ_REL) == 0 : --count == 0) {
+        delete p;
+    }
 }
 
 } // namespace boost
@@ -0,0 +1,217 @@
+#include <core/clock_domains.hpp>
+#include <core/debug/debug.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace Flexus {
+namespace Core {
+
+namespace {
+
+std::vector<std::string>
+split(std::string const& aString, char aDelimiter)
+{
+    std::vector<std::string> tokens;
+    std::stringstream ss(aString);
+    std::string item;
+    while (std::getline(ss, item, aDelimiter)) {
+        if (!item.empty()) tokens.push_back(item);
+    }
+    return tokens;
+}
+
+} // namespace
+
+ClockDomains::ClockDomains()
+  : theCoreCount(0)
+  , theUncoreRegistered(false)
+  , theNow(0)
+{
+}
+
+void
+ClockDomains::configure(index_t aCoreCount, std::string const& aSpec)
+{
+    theCoreCount = aCoreCount;
+    theDomains.clear();
+    theUncoreNames.clear();
+    theUncoreRegistered = false;
+    theNow              = 0;
+
+    std::vector<std::string> sections = split(aSpec, ',');
+    std::vector<std::string> freqs;
+    if (!sections.empty() && sections[0].find('=') == std::string::npos) {
+        freqs = split(sections[0], ':');
+        sections.erase(sections.begin());
+    }
+    thePendingAssignments = sections;
+
+    if (freqs.empty()) freqs.push_back("1");
+    if (freqs.size() == 1) freqs.resize(aCoreCount + 1, freqs[0]);
+
+    // Semikraken passes one entry per QEMU core (phantoms included); the
+    // last entry is always the uncore.
+    DBG_Assert(freqs.size() >= aCoreCount + 1,
+               (<< "Expected " << aCoreCount + 1 << " drive frequencies, got " << freqs.size()));
+
+    for (index_t i = 0; i <= aCoreCount; ++i) {
+        bool uncore = (i == aCoreCount);
+        double ghz  = std::strtod((uncore ? freqs.back() : freqs[i]).c_str(), nullptr);
+        DBG_Assert(ghz > 0, (<< "Invalid drive frequency: " << (uncore ? freqs.back() : freqs[i])));
+
+        Domain d;
+        d.theName          = uncore ? "uncore" : "core" + std::to_string(i);
+        d.theGHz           = ghz;
+        d.theFollowsUncore = false;
+        d.theAnchor        = 0;
+        d.theEdge          = 0;
+        d.theNext          = 0;
+        theDomains.push_back(d);
+    }
+
+    rebuildHeap();
+}
+
+void
+ClockDomains::registerUncoreDrives(std::vector<std::string> const& aNames)
+{
+    Domain const uncore = theDomains.back();
+    theUncoreNames      = aNames;
+
+    for (auto const& name : aNames) {
+        Domain d           = uncore;
+        d.theName          = name;
+        d.theFollowsUncore = true;
+        theDomains.insert(theDomains.end() - 1, d);
+    }
+    theUncoreRegistered = true;
+
+    for (auto const& assignment : thePendingAssignments) {
+        DBG_Assert(set(assignment), (<< "Invalid clock domain assignment: " << assignment));
+    }
+    thePendingAssignments.clear();
+
+    rebuildHeap();
+
+    std::ostringstream table;
+    report(table);
+    DBG_(Dev, (<< table.str()));
+}
+
+uint64_t
+ClockDomains::edgeTime(Domain const& aDomain, uint64_t anEdge) const
+{
+    // computed from the anchor rather than accumulated, so fractional
+    // periods never drift
+    return aDomain.theAnchor + std::llround(double(anEdge) * 1000.0 / aDomain.theGHz);
+}
+
+index_t
+ClockDomains::find(std::string const& aDomain) const
+{
+    for (index_t i = 0; i < theDomains.size(); ++i) {
+        if (theDomains[i].theName == aDomain) return i;
+    }
+    return theDomains.size();
+}
+
+void
+ClockDomains::reanchor(index_t aSlot, double aGHz, int64_t aPhase)
+{
+    Domain& d   = theDomains[aSlot];
+    d.theGHz    = aGHz;
+    d.theAnchor = (aPhase < 0) ? std::max(d.theNext, theNow) : theNow + aPhase;
+    d.theEdge   = 0;
+    d.theNext   = d.theAnchor;
+}
+
+bool
+ClockDomains::set(std::string const& aDomain, double aGHz, int64_t aPhase)
+{
+    if (!(aGHz > 0)) return false;
+
+    index_t slot = find(aDomain);
+    if (slot == theDomains.size()) {
+        if (theUncoreRegistered) return false;
+        // may name an uncore drive, resolved once the drives are known
+        std::ostringstream deferred;
+        deferred << aDomain << '=' << aGHz;
+        if (aPhase >= 0) deferred << '@' << aPhase;
+        thePendingAssignments.push_back(deferred.str());
+        return true;
+    }
+
+    reanchor(slot, aGHz, aPhase);
+    if (slot == reference()) {
+        for (index_t i = theCoreCount; i < reference(); ++i) {
+            if (theDomains[i].theFollowsUncore) reanchor(i, aGHz, aPhase);
+        }
+    } else {
+        theDomains[slot].theFollowsUncore = false;
+    }
+
+    rebuildHeap();
+    DBG_(Dev, (<< "Clock domain " << aDomain << " set to " << aGHz << "GHz, next edge at " << theDomains[slot].theNext << "ps"));
+    return true;
+}
+
+bool
+ClockDomains::set(std::string const& anAssignment)
+{
+    std::string::size_type eq = anAssignment.find('=');
+    if (eq == std::string::npos) return false;
+
+    std::string value        = anAssignment.substr(eq + 1);
+    std::string::size_type at = value.find('@');
+    int64_t phase            = (at == std::string::npos) ? -1 : std::strtoll(value.c_str() + at + 1, nullptr, 10);
+
+    return set(anAssignment.substr(0, eq), std::strtod(value.c_str(), nullptr), phase);
+}
+
+bool
+ClockDomains::laterThan(index_t a, index_t b) const
+{
+    if (theDomains[a].theNext != theDomains[b].theNext) return theDomains[a].theNext > theDomains[b].theNext;
+    return a > b;
+}
+
+void
+ClockDomains::rebuildHeap()
+{
+    theHeap.resize(theDomains.size());
+    for (index_t i = 0; i < theDomains.size(); ++i)
+        theHeap[i] = i;
+    std::make_heap(theHeap.begin(), theHeap.end(), [this](index_t a, index_t b) { return laterThan(a, b); });
+}
+
+index_t
+ClockDomains::nextEdge()
+{
+    auto later = [this](index_t a, index_t b) { return laterThan(a, b); };
+
+    std::pop_heap(theHeap.begin(), theHeap.end(), later);
+    index_t slot = theHeap.back();
+    Domain& d    = theDomains[slot];
+
+    theNow    = d.theNext;
+    d.theNext = edgeTime(d, ++d.theEdge);
+
+    std::push_heap(theHeap.begin(), theHeap.end(), later);
+    return slot;
+}
+
+void
+ClockDomains::report(std::ostream& anOstream) const
+{
+    anOstream << "Clock domains:" << std::endl;
+    for (auto const& d : theDomains) {
+        anOstream << "  " << d.theName << ": " << d.theGHz << "GHz" << (d.theFollowsUncore ? " (uncore)" : "")
+                  << ", next edge at " << d.theNext << "ps" << std::endl;
+    }
+}
+
+} // namespace Core
+} // namespace Flexus
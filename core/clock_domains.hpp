@@ -0,0 +1,94 @@
+#ifndef FLEXUS_CLOCK_DOMAINS_HPP_INCLUDED
+#define FLEXUS_CLOCK_DOMAINS_HPP_INCLUDED
+
+#include <core/types.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Clock domains of the simulated system.
+ *
+ * Every core, and every uncore drive (NoC, memory controllers, L2, ...), is a
+ * clock domain with its own frequency and phase. The drive loop pops the
+ * earliest pending clock edge from a min-heap of next-edge times, expressed in
+ * picoseconds, and drives whatever that edge belongs to. Edges at the same time
+ * are ordered cores first, then uncore drives in drive order, which reproduces
+ * the historical drive sequence for integer ratios.
+ *
+ * The "uncore" domain is the reference clock: Flexus cycles count its edges,
+ * and uncore drives follow it unless they were given a frequency of their own.
+ *
+ * Configuration string (the frequency argument of flexus_init):
+ *
+ *    <f0>:<f1>:...:<fN-1>:<funcore>[,<domain>=<f>[@<phase ps>]]*
+ *
+ * with frequencies in GHz. A single value applies to every core and the
+ * uncore. Domains are named core<i>, uncore, or by uncore drive name (for
+ * instance NetworkDrive, LoopbackDrive). The same <domain>=<f>[@<phase>]
+ * syntax is accepted at runtime through the QMP setfreq command.
+ */
+class ClockDomains
+{
+  public:
+    ClockDomains();
+
+    void configure(index_t aCoreCount, std::string const& aSpec);
+
+    // Called once by the drive loop with the names of the uncore drives
+    void registerUncoreDrives(std::vector<std::string> const& aNames);
+    bool uncoreDrivesRegistered() const { return theUncoreRegistered; }
+
+    // Changes frequency (GHz) and phase (ps) of a domain. A negative phase
+    // keeps the domain aligned to its next pending edge. Returns false if
+    // the assignment is malformed or names an unknown domain.
+    bool set(std::string const& aDomain, double aGHz, int64_t aPhase = -1);
+    bool set(std::string const& anAssignment);
+
+    // Pops the earliest edge and returns the slot it belongs to: a core index
+    // below cores(), an uncore drive index in [cores(), reference()), or
+    // reference() for a Flexus cycle boundary.
+    index_t nextEdge();
+
+    index_t cores() const { return theCoreCount; }
+    index_t reference() const { return theCoreCount + theUncoreNames.size(); }
+    uint64_t now() const { return theNow; }
+
+    void report(std::ostream& anOstream) const;
+
+  private:
+    struct Domain
+    {
+        std::string theName;
+        double theGHz;
+        bool theFollowsUncore;
+        uint64_t theAnchor; // time of edge 0, in ps
+        uint64_t theEdge;   // edges elapsed since the anchor
+        uint64_t theNext;   // next edge time, in ps
+    };
+
+    uint64_t edgeTime(Domain const& aDomain, uint64_t anEdge) const;
+    void reanchor(index_t aSlot, double aGHz, int64_t aPhase);
+    void rebuildHeap();
+    bool laterThan(index_t a, index_t b) const;
+    index_t find(std::string const& aDomain) const;
+
+    index_t theCoreCount;
+    std::vector<std::string> theUncoreNames;
+    bool theUncoreRegistered;
+    std::vector<std::string> thePendingAssignments;
+
+    // cores, then uncore drives, then the reference "uncore" domain
+    std::vector<Domain> theDomains;
+    std::vector<index_t> theHeap;
+    uint64_t theNow;
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CLOCK_DOMAINS_HPP_INCLUDED
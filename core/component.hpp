@@ -7,6 +7,8 @@
 #include <functional>
 namespace ll = boost::lambda;
 
+#include <core/arena.hpp>
+#include <core/clock_domains.hpp>
 #include <core/boost_extensions/padded_string_cast.hpp>
 #include <core/component_interface.hpp>
 #include <core/configuration_macros.hpp>
@@ -32,11 +34,12 @@ struct ComponentManager
     virtual bool isQuiesced() const                                                             = 0;
     virtual void doSave(std::string const& aDirectory) const                                    = 0;
     virtual void doLoad(std::string const& aDirectory)                                          = 0;
-    virtual void registerComponent(ComponentInterface* aComponent)                              = 0;
+    virtual void registerComponent(ComponentInterface* aComponent, index_t anArena)             = 0;
+    virtual index_t arenaOf(ComponentInterface const* aComponent) const                         = 0;
     virtual void registerHandle(std::function<void(Flexus::Core::index_t)> anInstantiator)      = 0;
     virtual void instantiateComponents(Flexus::Core::index_t aSystemWidth, const char * freq)   = 0;
     virtual Flexus::Core::index_t systemWidth() const                                           = 0;
-    virtual Flexus::Core::freq_opts getFreq() const                                             = 0;
+    virtual Flexus::Core::ClockDomains& clockDomains()                                          = 0;
     static ComponentManager& getComponentManager();
 };
 
@@ -167,6 +170,11 @@ class FlexusComponentBase
 
     std::string statName() const { return name(); }
 
+    // The arena of the core this component belongs to. initialize() runs
+    // outside of it; a ComponentArena::Scope on it wraps only the tables
+    // built there that live for the whole run.
+    index_t coreArena() const { return ComponentManager::getComponentManager().arenaOf(this); }
+
     virtual bool isQuiesced() const
     {
         DBG_(Crit, (<< "Warning: isQuiesced() is not implemented in component " << name()));
@@ -269,8 +277,12 @@ struct ComponentInstance
 
         theComponent = new iface*[theWidth];
         for (Flexus::Core::index_t i = 0; i < theWidth; ++i) {
-            theComponent[i] = ComponentInterface::instantiate(theConfiguration, theJumpTable, i, theWidth);
-            ComponentManager::getComponentManager().registerComponent(theComponent[i]);
+            index_t arena = theScaleWithSystem ? ComponentArena::affinity(i, theWidth, aSystemWidth) : ComponentArena::kNoArena;
+            {
+                ComponentArena::Scope scope(arena);
+                theComponent[i] = ComponentInterface::instantiate(theConfiguration, theJumpTable, i, theWidth);
+            }
+            ComponentManager::getComponentManager().registerComponent(theComponent[i], arena);
         }
     }
 
@@ -1,7 +1,10 @@
 #include "core/simulator_name.hpp"
 #include <algorithm>
+#include <core/arena.hpp>
 #include <core/component.hpp>
 #include <core/debug/debug.hpp>
+#include <core/performance/perf_counters.hpp>
+#include <core/uncore_pool.hpp>
 #include <functional>
 #include <iostream>
 #include <vector>
@@ -23,48 +26,15 @@ class ComponentManagerImpl : public ComponentManager
     typedef std::vector<std::function<void(Flexus::Core::index_t)>> instatiation_vector;
     std::vector<std::function<void(Flexus::Core::index_t aSystemWidth)>> theInstantiationFunctions;
     std::vector<ComponentInterface*> theComponents;
+    std::vector<index_t> theComponentArenas;
     Flexus::Core::index_t theSystemWidth;
-    Flexus::Core::freq_opts theDriveFreq;
-
-  private:
-    // Helper functions to calculate drive frequencies
-    index_t gcd(index_t a, index_t b) {
-        while (b != 0) {
-            int t = b;
-            b     = a % b;
-            a     = t;
-        }
-        return a;
-    }
-
-    std::tuple<index_t, index_t> helper(float number) {
-        index_t num = (index_t)(number * 10);   // Assumption: number only has single digit after decimal point
-        index_t den = 10;
-        index_t g   = gcd(num, den);
-        return std::make_tuple(num / g, den / g);
-    }
-
-    std::vector<std::string> splitString(const char * str, char delimiter) {
-        std::vector<std::string> tokens;
-        if(str == nullptr) return tokens;
-        const char* start = str;
-        const char* curr = str;
-        while(*curr != '\0') {
-            if(*curr == delimiter) {
-                tokens.emplace_back(start, curr);
-                start = curr + 1;
-            }
-            ++curr;
-        }
-        if(start != curr) tokens.emplace_back(start, curr);
-        return tokens;
-    }
+    Flexus::Core::ClockDomains theClockDomains;
 
   public:
     virtual ~ComponentManagerImpl() {}
 
     Flexus::Core::index_t systemWidth() const { return theSystemWidth; }
-    Flexus::Core::freq_opts getFreq() const { return theDriveFreq; }
+    Flexus::Core::ClockDomains& clockDomains() { return theClockDomains; }
 
     void registerHandle(std::function<void(Flexus::Core::index_t)> anInstantiator)
     {
@@ -83,6 +53,9 @@ class ComponentManagerImpl : public ComponentManager
         }
 
         DBG_(Dev, (<< "Instantiating system with a width factor of: " << theSystemWidth));
+        ComponentArena::configure(theSystemWidth);
+        UncorePool::configure();
+        nProfile::PerfCounters::configure();
         Flexus::Wiring::connectWiring();
         instatiation_vector::iterator iter = theInstantiationFunctions.begin();
         instatiation_vector::iterator end  = theInstantiationFunctions.end();
@@ -91,56 +64,22 @@ class ComponentManagerImpl : public ComponentManager
             ++iter;
         }
 
-        // Drive frequency calculations
-        std::vector<std::string> freq_split = (freq != nullptr && strlen(freq)) ? splitString(freq, ':') : std::vector<std::string>(aSystemWidth+1, std::string("1"));
-        if (freq_split.size() == 1) {
-            // replicate the frequency for all the components
-            freq_split.resize(aSystemWidth + 1, freq_split[0]);
-
-            for (std::size_t i = 1; i <= aSystemWidth; ++i) {
-                freq_split[i] = freq_split[0];
-            }
-        }
-
-        assert(freq_split.size() == aSystemWidth + 1);
-        index_t numerator[aSystemWidth+1], denominator[aSystemWidth+1], driveFreq[aSystemWidth+1];
-
-        // Reduce fractions to their simplest form
-        for(index_t i = 0; i <= aSystemWidth; ++i) {
-            float f_freq = std::stof(freq_split[i]);
-            std::tie(numerator[i], denominator[i]) = helper(f_freq);
-        }
-
-        // Find the LCM of all denominators
-        index_t lcmDen = denominator[0];
-        for(index_t i = 1; i <= aSystemWidth; ++i) {
-            lcmDen = (lcmDen * denominator[i]) / gcd(lcmDen, denominator[i]);
-        }
-
-        // Calculate the drive frequencies
-        for(index_t i = 0; i <= aSystemWidth; ++i) {
-            driveFreq[i] = (lcmDen / denominator[i]) * numerator[i];
-        }
-
-        // Calculate the GCD of all drive frequencies
-        index_t gcdFreq = driveFreq[0];
-        for(index_t i = 1; i <= aSystemWidth; ++i) {
-            gcdFreq = gcd(gcdFreq, driveFreq[i]);
-        }
-
-        // Normalize the drive frequencies
-        for(index_t i = 0; i <= aSystemWidth; ++i) {
-            driveFreq[i] /= gcdFreq;
-        }
+        // Clock domains of the cores and the uncore
+        theClockDomains.configure(theSystemWidth, freq != nullptr ? freq : "");
+    }
 
-        // Store the drive frequencies
-        theDriveFreq.freq = new index_t[aSystemWidth + 1];
-        std::copy(driveFreq, driveFreq + aSystemWidth + 1, theDriveFreq.freq);
-        std::sort(driveFreq, driveFreq + aSystemWidth + 1);
-        theDriveFreq.maxFreq = driveFreq[aSystemWidth];
+    void registerComponent(ComponentInterface* aComponent, index_t anArena)
+    {
+        theComponents.push_back(aComponent);
+        theComponentArenas.push_back(anArena);
     }
 
-    void registerComponent(ComponentInterface* aComponent) { theComponents.push_back(aComponent); }
+    index_t arenaOf(ComponentInterface const* aComponent) const
+    {
+        auto iter = std::find(theComponents.begin(), theComponents.end(), aComponent);
+        if (iter == theComponents.end()) return ComponentArena::kNoArena;
+        return theComponentArenas[iter - theComponents.begin()];
+    }
 
     void initComponents()
     {
@@ -198,6 +137,8 @@ class ComponentManagerImpl : public ComponentManager
         iter = theComponents.begin();
         end  = theComponents.end();
         while (iter != end) {
+            // Outside the core arenas: loading only makes temporaries
+            // (streams, parsed trees), which an arena would never reclaim
             DBG_(Dev, (<< "Loading state: " << (*iter)->name()));
             (*iter)->loadState(aDirectory);
             ++iter;
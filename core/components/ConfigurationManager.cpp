@@ -32,6 +32,10 @@ class ConfigurationManagerDetails : public ConfigurationManager
     std::map<const string, ParameterBase*> theParameters;
     bool theAbortOnUnitialized;
 
+    // Values given through set(), to report a parameter set twice to
+    // different values
+    std::map<const string, string> theSetValues;
+
   public:
     ConfigurationManagerDetails()
       : theAbortOnUnitialized(false)
@@ -129,6 +133,12 @@ class ConfigurationManagerDetails : public ConfigurationManager
         if (iter == theParameters.end()) {
             std::cout << "WARNING: There is no parameter named \"" << aName << "\"" << std::endl;
         } else {
+            auto previous = theSetValues.find(aName);
+            if (previous != theSetValues.end() && previous->second != aValue) {
+                std::cout << "WARNING: Conflicting values for parameter \"" << aName << "\": \"" << previous->second
+                          << "\" is overridden by \"" << aValue << "\"" << std::endl;
+            }
+            theSetValues[aName] = aValue;
             iter->second->setValue(aValue);
         }
     }
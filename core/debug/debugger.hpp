@@ -5,7 +5,9 @@
 #include <core/debug/field.hpp>
 #include <core/debug/severity.hpp>
 #include <core/debug/target.hpp>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
@@ -36,7 +38,9 @@ class Debugger
     std::map<std::string, bool*> theCategories;
     std::map<std::string, std::vector<bool*>> theComponents;
 
-    int64_t theCount;
+    // Entries may come from the uncore pool's workers (see core/uncore_pool.hpp)
+    std::atomic<int64_t> theCount;
+    std::recursive_mutex theProcessLock;
     uint64_t* theCycleCount;
     uint64_t* cycle_delay_log;
 
@@ -2,88 +2,184 @@
 #define FLEXUS_DRIVE_HPP_INCLUDED
 
 #include <boost/mpl/deref.hpp>
+#include <core/clock_domains.hpp>
 #include <core/drive_reference.hpp>
 #include <core/performance/profile.hpp>
+#include <core/telemetry.hpp>
+#include <core/uncore_pool.hpp>
+#include <string>
+#include <vector>
 
 namespace Flexus {
 namespace Core {
 
 namespace aux_ {
 
+// aDrive is the telemetry slot of the drive, its position in the core list
 template<int32_t N, class DriveHandleIter>
 struct do_cycle_core
 {
-    static void doCycle(index_t idx)
+    static void drive(index_t idx)
     {
+        FLEXUS_PROFILE_EVENTS_N(mpl::deref<DriveHandleIter>::type::drive::name());
         DBG_(VVerb, (<< "[Core] Drive component ID: " << N << " core idx: " << idx));
         mpl::deref<DriveHandleIter>::type::getReference(idx).drive(
-            typename mpl::deref<DriveHandleIter>::type::drive());
+          typename mpl::deref<DriveHandleIter>::type::drive());
+    }
 
-        do_cycle_core<N - 1, typename mpl::next<DriveHandleIter>::type>::doCycle(idx);
+    static void doCycle(index_t idx, index_t aDrive = 0)
+    {
+        if (Telemetry::timing()) {
+            int64_t start = Telemetry::now();
+            drive(idx);
+            Telemetry::timed(aDrive, start);
+        } else {
+            drive(idx);
+        }
+
+        do_cycle_core<N - 1, typename mpl::next<DriveHandleIter>::type>::doCycle(idx, aDrive + 1);
     }
 };
 
 template<class DriveHandleIter>
 struct do_cycle_core<0, DriveHandleIter>
 {
-    static void doCycle(index_t idx) {}
+    static void doCycle(index_t idx, index_t aDrive = 0) {}
 };
 
 template<int32_t N, class DriveHandleIter>
+struct list_core_drives
+{
+    static void list(std::vector<std::string>& aNames)
+    {
+        aNames.push_back(mpl::deref<DriveHandleIter>::type::drive::name());
+        list_core_drives<N - 1, typename mpl::next<DriveHandleIter>::type>::list(aNames);
+    }
+};
+
+template<class DriveHandleIter>
+struct list_core_drives<0, DriveHandleIter>
+{
+    static void list(std::vector<std::string>&) {}
+};
+
+template<class DriveHandle, bool Independent = DriveHandle::drive::independent>
 struct do_cycle_uncore
 {
     static void doCycle()
     {
-        {
-            FLEXUS_PROFILE_N(mpl::deref<DriveHandleIter>::type::drive::name());
-            for (index_t i = 0; i < mpl::deref<DriveHandleIter>::type::width(); i++) {
-                DBG_(VVerb, (<< "[Uncore] Drive Component ID: " << N << " uncore idx: " << i));
-                mpl::deref<DriveHandleIter>::type::getReference(i).drive(
-                  typename mpl::deref<DriveHandleIter>::type::drive());
+        FLEXUS_PROFILE_EVENTS_N(DriveHandle::drive::name());
+        for (index_t i = 0; i < DriveHandle::width(); i++) {
+            DBG_(VVerb, (<< "[Uncore] Drive Component: " << DriveHandle::drive::name() << " uncore idx: " << i));
+            DriveHandle::getReference(i).drive(typename DriveHandle::drive());
+        }
+    }
+};
+
+// Independent elements are driven all at once, on the uncore pool when there
+// is one, and then commit what they send in index order. Nothing an element
+// commits is seen by another one's drive() in the same cycle, so this is the
+// serial drive-then-commit order as far as the rest of the system can tell.
+template<class DriveHandle>
+struct do_cycle_uncore<DriveHandle, true>
+{
+    // One per element, built on the simulation thread on the first cycle
+    static std::vector<UncorePool::SerialSequence>& sequences()
+    {
+        static std::vector<UncorePool::SerialSequence> theSequences(DriveHandle::width());
+        return theSequences;
+    }
+
+    static void drive(index_t i)
+    {
+        DBG_(VVerb, (<< "[Uncore] Drive Component: " << DriveHandle::drive::name() << " uncore idx: " << i));
+        UncorePool::SerialScope serials(sequences()[i]);
+        DriveHandle::getReference(i).drive(typename DriveHandle::drive());
+    }
+
+    static void doCycle()
+    {
+        FLEXUS_PROFILE_EVENTS_N(DriveHandle::drive::name());
+        sequences();
+        if (UncorePool::enabled() && DriveHandle::width() > 1) {
+            UncorePool::run(DriveHandle::width(), &drive);
+        } else {
+            for (index_t i = 0; i < DriveHandle::width(); i++) {
+                drive(i);
             }
         }
-        do_cycle_uncore<N - 1, typename mpl::next<DriveHandleIter>::type>::doCycle();
+        for (index_t i = 0; i < DriveHandle::width(); i++) {
+            DriveHandle::getReference(i).commit(typename DriveHandle::drive());
+        }
+    }
+};
+
+// Collects one entry point per uncore drive, in drive order, so that each can
+// be clocked by its own domain.
+template<int32_t N, class DriveHandleIter>
+struct list_uncore_drives
+{
+    static void list(std::vector<void (*)()>& aDrives, std::vector<std::string>& aNames)
+    {
+        typedef typename mpl::deref<DriveHandleIter>::type handle;
+        aDrives.push_back(&do_cycle_uncore<handle>::doCycle);
+        aNames.push_back(handle::drive::name());
+        list_uncore_drives<N - 1, typename mpl::next<DriveHandleIter>::type>::list(aDrives, aNames);
     }
 };
 
 template<class DriveHandleIter>
-struct do_cycle_uncore<0, DriveHandleIter>
+struct list_uncore_drives<0, DriveHandleIter>
 {
-    static void doCycle() {}
+    static void list(std::vector<void (*)()>&, std::vector<std::string>&) {}
 };
 
 template<class DriveHandles>
 struct do_cycle
 {
+    // Drives clock edges in time order until the next edge of the reference
+    // (uncore) clock, which ends one Flexus cycle.
     static uint32_t doCycle()
     {
         typedef typename mpl::deref<typename mpl::begin<DriveHandles>::type>::type coreDriveHandles;
         typedef typename mpl::deref<typename mpl::next<typename mpl::begin<DriveHandles>::type>::type>::type uncoreDriveHandles;
-        uint32_t advanceCycles = 0;
-
-        index_t* freq = ComponentManager::getComponentManager().getFreq().freq;
-        index_t maxFreq = ComponentManager::getComponentManager().getFreq().maxFreq;
-        index_t sysWidth = ComponentManager::getComponentManager().systemWidth();
 
-        DBG_(Dev, (<< "maxFreq: " << maxFreq << " sysWidth: " << sysWidth));
-        for (index_t id = 0; id <= sysWidth; ++id) {
-            DBG_(Dev, (<< "freq[" << id << "]: " << freq[id]));
+        static std::vector<void (*)()> theUncoreDrives;
+        const index_t core_drives = mpl::size<coreDriveHandles>::value;
+
+        ClockDomains& clocks = ComponentManager::getComponentManager().clockDomains();
+        if (!clocks.uncoreDrivesRegistered()) {
+            std::vector<std::string> names;
+            theUncoreDrives.clear();
+            list_uncore_drives<mpl::size<uncoreDriveHandles>::value, typename mpl::begin<uncoreDriveHandles>::type>::list(
+              theUncoreDrives, names);
+            clocks.registerUncoreDrives(names);
+
+            // Telemetry slots: the core drives, then the uncore drives
+            std::vector<std::string> slots;
+            list_core_drives<core_drives, typename mpl::begin<coreDriveHandles>::type>::list(slots);
+            slots.insert(slots.end(), names.begin(), names.end());
+            Telemetry::registerDrives(slots);
         }
 
-        for(index_t iter = 0; iter < maxFreq; ++iter) {
-            for(index_t id = 0; id <= sysWidth; ++id) {
-                if(iter < freq[id]) {
-                    if(id == sysWidth) {
-                        // Advance flexus cycles once per uncore drive
-                        advanceCycles++;
-                        do_cycle_uncore<mpl::size<uncoreDriveHandles>::value, typename mpl::begin<uncoreDriveHandles>::type>::doCycle();
-                    } else {
-                        do_cycle_core<mpl::size<coreDriveHandles>::value, typename mpl::begin<coreDriveHandles>::type>::doCycle(id);
-                    }
+        const index_t cores     = clocks.cores();
+        const index_t reference = clocks.reference();
+        while (true) {
+            index_t slot = clocks.nextEdge();
+            if (slot < cores) {
+                do_cycle_core<core_drives, typename mpl::begin<coreDriveHandles>::type>::doCycle(slot);
+            } else if (slot < reference) {
+                if (Telemetry::timing()) {
+                    int64_t start = Telemetry::now();
+                    theUncoreDrives[slot - cores]();
+                    Telemetry::timed(core_drives + slot - cores, start);
+                } else {
+                    theUncoreDrives[slot - cores]();
                 }
+            } else {
+                return 1;
             }
         }
-        return advanceCycles;
     }
 };
 } // namespace aux_
@@ -124,7 +220,7 @@ class Drive : public DriveBase
         // Through the magic of template expansion and static dispatch, this calls
         // every Drive's do_cycle() method in the order specified in
         // OrderedDriveHandleList.
-        FLEXUS_PROFILE_N("Drive::doCycle");
+        FLEXUS_PROFILE_EVENTS_N("Drive::doCycle");
         return aux_::do_cycle<OrderedDriveHandleList>::doCycle();
     }
 };
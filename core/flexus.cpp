@@ -8,9 +8,12 @@
 #include "core/exception.hpp"
 #include "core/performance/profile.hpp"
 #include "core/qemu/configuration_api.hpp"
+#include "core/qemu/mai_api.hpp"
 #include "core/qemu/qmp_api.hpp"
+#include "core/sampling.hpp"
 #include "core/stats.hpp"
 #include "core/target.hpp"
+#include "core/telemetry.hpp"
 
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
@@ -60,6 +63,8 @@ class FlexusImpl : public FlexusInterface
     void setCycle(uint64_t cycle);
     void advanceCycles(int64_t aCycleCount);
     uint32_t invokeDrives();
+    void fastForward();
+    void sampled();
 
     // Simulator state inquiry
     bool quiescing() const { return theQuiesceRequested; }
@@ -74,6 +79,7 @@ class FlexusImpl : public FlexusInterface
     void setStopCycle(uint64_t aValue);
     void setStatInterval(uint64_t aValue);
     void set_log_delay(uint64_t aValue);
+    void setFrequency(std::string const& aSpec);
     void parseConfiguration(std::string const& aFilename);
     void writeMeasurement(std::string const& aMeasurement, std::string const& aFilename);
     void doLoad(std::string const& aDirName);
@@ -111,10 +117,13 @@ FlexusImpl::initializeComponents()
 {
     DBG_(VVerb, (<< "Inititializing Flexus components..."));
     Stat::getStatManager()->initialize();
+    Telemetry::configure(ComponentManager::getComponentManager().systemWidth());
+    Sampling::configure(ComponentManager::getComponentManager().systemWidth());
     parseConfiguration(config_file);
     ConfigurationManager::getConfigurationManager().checkAllOverrides();
     ComponentManager::getComponentManager().initComponents();
     theInitialized = true;
+    Telemetry::mark(Sampling::phaseName(Sampling::phase()), theCycleCount);
 
     cpu_watchdogs.reserve(ComponentManager::getComponentManager().systemWidth());
 
@@ -151,6 +160,44 @@ FlexusImpl::advanceCycles(int64_t aCycleCount)
     Flexus::Dbg::Debugger::theDebugger->checkAt();
 
     Stat::getStatManager()->tick(aCycleCount);
+
+    Telemetry::cycle(theCycleCount);
+
+    if (Sampling::phase() != Sampling::kOff &&
+        Sampling::cycle(theCycleCount,
+                        theQuiesceRequested && ComponentManager::getComponentManager().isQuiesced())) {
+        sampled();
+    }
+}
+
+void
+FlexusImpl::fastForward()
+{
+    // Every QEMU core runs a batch on its own; the drives, the stats and the
+    // watchdogs stand still
+    uint64_t steps = Sampling::fastForwardSteps();
+    for (std::size_t i = 0; i < Qemu::API::qemu_api.get_num_cores(); ++i) {
+        Qemu::Processor::getProcessor(i).advance_batch(steps);
+    }
+    if (Sampling::fastForwarded(steps)) sampled();
+}
+
+// Acts on a phase change of the sampling controller
+void
+FlexusImpl::sampled()
+{
+    Telemetry::mark(Sampling::phaseName(Sampling::phase()), theCycleCount);
+    theQuiesceRequested = (Sampling::phase() == Sampling::kDraining);
+
+    if (Sampling::phase() == Sampling::kDone) {
+        terminateSimulation();
+    } else if (Sampling::phase() == Sampling::kWarming && Sampling::saveWindows()) {
+        std::string dir = "sample." + boost::padded_string_cast<6, '0'>(Sampling::windows());
+        mkdir(dir.c_str(), 0755);
+        doSave(dir);
+    }
+    // The cores did not commit while fetch was stopped or QEMU ran alone
+    if (Sampling::phase() == Sampling::kWarming) std::fill(cpu_watchdogs.begin(), cpu_watchdogs.end(), 0);
 }
 
 uint32_t
@@ -164,6 +211,11 @@ FlexusImpl::doCycle()
 {
     FLEXUS_PROFILE();
 
+    if (Sampling::phase() == Sampling::kFastForward) {
+        fastForward();
+        return;
+    }
+
     FLEXUS_DBG("--------------START FLEXUS CYCLE " << theCycleCount << " ------------------------");
 
 
@@ -204,11 +256,24 @@ FlexusImpl::set_log_delay(uint64_t aValue)
     DBG_(Dev, Set((Source) << "flexus")(<< "Set LOG delay to : " << cycle_delay_log));
 }
 
+void
+FlexusImpl::setFrequency(std::string const& aSpec)
+{
+    std::stringstream ss(aSpec);
+    std::string assignment;
+    while (std::getline(ss, assignment, ',')) {
+        if (!ComponentManager::getComponentManager().clockDomains().set(assignment)) {
+            DBG_(Crit, (<< "Invalid clock domain assignment: " << assignment));
+        }
+    }
+}
+
 void
 FlexusImpl::setStopCycle(uint64_t aValue)
 {
     theStopCycle = aValue;
     DBG_(Dev, Set((Source) << "flexus")(<< "Set STOP to : " << theStopCycle));
+    Telemetry::mark("stop=" + std::to_string(theStopCycle), theCycleCount);
 }
 
 void
@@ -237,14 +302,20 @@ void
 FlexusImpl::doLoad(std::string const& aDirName)
 {
     DBG_(Crit, (<< "Loading Flexus state from subdirectory " << aDirName));
+    std::string phase(Telemetry::phase());
+    Telemetry::mark("load", theCycleCount);
     ComponentManager::getComponentManager().doLoad(aDirName);
+    Telemetry::mark(phase, theCycleCount);
 }
 
 void
 FlexusImpl::doSave(std::string const& aDirName)
 {
     DBG_(Crit, (<< "Saving Flexus state in subdirectory " << aDirName));
+    std::string phase(Telemetry::phase());
+    Telemetry::mark("save", theCycleCount);
     ComponentManager::getComponentManager().doSave(aDirName);
+    Telemetry::mark(phase, theCycleCount);
 }
 void
 FlexusImpl::setDebug(std::string const& aDebugSeverity)
@@ -292,6 +363,22 @@ FlexusImpl::terminateSimulation()
     ComponentManager::getComponentManager().finalizeComponents();
 
     writeMeasurement("all", "all.measurement.end.log");
+
+    Telemetry::finish(theCycleCount);
+    std::ostringstream telemetry;
+    Telemetry::report(telemetry);
+    DBG_(Dev, Core()(<< telemetry.str()));
+    if (Sampling::phase() != Sampling::kOff) {
+        std::ostringstream sampling;
+        Sampling::report(sampling);
+        DBG_(Dev, Core()(<< sampling.str()));
+    }
+
+#ifdef PROFILING_ENABLED
+    std::ofstream profile("profile.out");
+    nProfile::ProfileManager::profileManager()->report(profile);
+#endif
+
     Flexus::Qemu::API::qemu_api.stop("Simulation terminated by flexus.");
     exit(0);
 }
@@ -31,6 +31,7 @@ class FlexusInterface
     virtual void setStatInterval(uint64_t aValue)            = 0;
     virtual void setStopCycle(uint64_t aValue)               = 0;
     virtual void set_log_delay(uint64_t aValue)              = 0;
+    virtual void setFrequency(std::string const& aSpec)      = 0;
 
     virtual void doLoad(std::string const& aDirName)         = 0;
     virtual void doSave(std::string const& aDirName)         = 0;
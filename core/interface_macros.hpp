@@ -23,6 +23,8 @@
 
 #define FLEXUS_IFACE_DRIVE(Name) ((Drive, Name, #Name, xx, 0)) /**/
 
+#define FLEXUS_IFACE_INDEPENDENT_DRIVE(Name) ((IndependentDrive, Name, #Name, xx, 0)) /**/
+
 #define FLEXUS_IFACE_PORT_SPEC(Name, Type, Payload, Array)                                                             \
     struct Name                                                                                                        \
     {                                                                                                                  \
@@ -62,9 +64,26 @@
         {                                                                                                              \
             return IfaceStr "::" NameStr;                                                                              \
         }                                                                                                              \
+        static const bool independent = false;                                                                         \
     };                                                                                                                 \
     virtual void drive(Name const&) = 0; /**/
 
+// The elements of an independent drive only touch their own state in drive(),
+// which may run concurrently for all of them; everything they push out waits
+// in their own queues for commit(), called in index order once all have been
+// driven (see core/drive.hpp).
+#define FLEXUS_IFACE_INDEPENDENT_DRIVE_SPEC(IfaceStr, Name, NameStr)                                                   \
+    struct Name                                                                                                        \
+    {                                                                                                                  \
+        static std::string name()                                                                                      \
+        {                                                                                                              \
+            return IfaceStr "::" NameStr;                                                                              \
+        }                                                                                                              \
+        static const bool independent = true;                                                                          \
+    };                                                                                                                 \
+    virtual void drive(Name const&)  = 0;                                                                              \
+    virtual void commit(Name const&) = 0; /**/
+
 #define FLEXUS_IFACE_GENERATE_PushOutput(Iface, IfaceStr, Name, NameStr, Payload, Width)                               \
     FLEXUS_IFACE_PORT_SPEC(Name, push, Payload, false) /**/
 
@@ -118,6 +137,9 @@
 #define FLEXUS_IFACE_GENERATE_Drive(Iface, IfaceStr, Name, NameStr, Payload, Width)                                    \
     FLEXUS_IFACE_DRIVE_SPEC(IfaceStr, Name, NameStr) /**/
 
+#define FLEXUS_IFACE_GENERATE_IndependentDrive(Iface, IfaceStr, Name, NameStr, Payload, Width)                         \
+    FLEXUS_IFACE_INDEPENDENT_DRIVE_SPEC(IfaceStr, Name, NameStr) /**/
+
 #define FLEXUS_IFACE_GENERATE(R, InterfaceName, ParameterTuple)                                                        \
     BOOST_PP_CAT(FLEXUS_IFACE_GENERATE_, BOOST_PP_TUPLE_ELEM(FLEXUS_i_IT_LEN, FLEXUS_i_IT_Type, ParameterTuple))       \
     (InterfaceName,                                                                                                    \
@@ -145,6 +167,7 @@
 #define FLEXUS_IFACE_JUMPTABLE_PullOutputArray(x)    /**/
 #define FLEXUS_IFACE_JUMPTABLE_PullOutputDynArray(x) /**/
 #define FLEXUS_IFACE_JUMPTABLE_Drive(x)              /**/
+#define FLEXUS_IFACE_JUMPTABLE_IndependentDrive(x)   /**/
 
 #define FLEXUS_IFACE_JUMPTABLE(R, x, ParameterTuple)                                                                   \
     BOOST_PP_CAT(FLEXUS_IFACE_JUMPTABLE_, BOOST_PP_TUPLE_ELEM(FLEXUS_i_IT_LEN, FLEXUS_i_IT_Type, ParameterTuple))      \
@@ -166,6 +189,7 @@
 #define FLEXUS_IFACE_JUMPTABLE_INIT_PullOutputArray(x)    /**/
 #define FLEXUS_IFACE_JUMPTABLE_INIT_PullOutputDynArray(x) /**/
 #define FLEXUS_IFACE_JUMPTABLE_INIT_Drive(x)              /**/
+#define FLEXUS_IFACE_JUMPTABLE_INIT_IndependentDrive(x)   /**/
 
 #define FLEXUS_IFACE_JUMPTABLE_INIT(R, x, ParameterTuple)                                                              \
     BOOST_PP_CAT(FLEXUS_IFACE_JUMPTABLE_INIT_, BOOST_PP_TUPLE_ELEM(FLEXUS_i_IT_LEN, FLEXUS_i_IT_Type, ParameterTuple)) \
@@ -193,6 +217,7 @@
 #define FLEXUS_IFACE_JUMPTABLE_CHECK_PullOutputArray(x, y)    /**/
 #define FLEXUS_IFACE_JUMPTABLE_CHECK_PullOutputDynArray(x, y) /**/
 #define FLEXUS_IFACE_JUMPTABLE_CHECK_Drive(x, y)              /**/
+#define FLEXUS_IFACE_JUMPTABLE_CHECK_IndependentDrive(x, y)   /**/
 
 #define FLEXUS_IFACE_JUMPTABLE_CHECK(R, x, ParameterTuple)                                                             \
     BOOST_PP_CAT(FLEXUS_IFACE_JUMPTABLE_CHECK_,                                                                        \
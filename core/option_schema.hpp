@@ -0,0 +1,258 @@
+#ifndef FLEXUS_CORE_OPTION_SCHEMA_HPP_INCLUDED
+#define FLEXUS_CORE_OPTION_SCHEMA_HPP_INCLUDED
+
+#include <cerrno>
+#include <core/debug/debug.hpp>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <strings.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Flexus {
+namespace Core {
+
+namespace aux_ {
+
+template<class T>
+typename std::enable_if<std::is_integral<T>::value, bool>::type
+parseOption(std::string const& aValue, T& aResult)
+{
+    char* end = nullptr;
+    errno     = 0;
+    bool fits;
+    if (std::is_signed<T>::value) {
+        long long value = std::strtoll(aValue.c_str(), &end, 0);
+        fits            = value >= (long long)std::numeric_limits<T>::min() &&
+               value <= (long long)std::numeric_limits<T>::max();
+        aResult = T(value);
+    } else {
+        // strtoull would wrap a negative value around
+        unsigned long long value = std::strtoull(aValue.c_str(), &end, 0);
+        fits    = aValue.find('-') == std::string::npos && value <= std::numeric_limits<T>::max();
+        aResult = T(value);
+    }
+    return !aValue.empty() && *end == '\0' && errno == 0 && fits;
+}
+
+inline bool
+parseOption(std::string const& aValue, double& aResult)
+{
+    char* end = nullptr;
+    errno     = 0;
+    aResult   = std::strtod(aValue.c_str(), &end);
+    return !aValue.empty() && *end == '\0' && errno == 0;
+}
+
+inline bool
+parseOption(std::string const& aValue, bool& aResult)
+{
+    if (aValue == "1" || strcasecmp(aValue.c_str(), "true") == 0) {
+        aResult = true;
+    } else if (aValue == "0" || strcasecmp(aValue.c_str(), "false") == 0) {
+        aResult = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline bool
+parseOption(std::string const& aValue, std::string& aResult)
+{
+    aResult = aValue;
+    return true;
+}
+
+} // namespace aux_
+
+/*
+ * The values of an option that a hot loop is compiled for, such as the
+ * common associativities. dispatch() calls aFunctor with
+ * std::integral_constant<T, V> for the value V equal to aValue, or with
+ * std::integral_constant<T, 0> when it is none of them, which the callee
+ * takes as "use the run-time value". The options struct declares the list
+ * next to the option and passes it to OptionSchema::option(), so the loops
+ * and the valid-options message name the same values.
+ */
+template<class T, T... Values>
+struct Specializations
+{
+    template<class F>
+    static decltype(auto) dispatch(T aValue, F&& aFunctor)
+    {
+        return dispatchIn<F, Values...>(aValue, aFunctor);
+    }
+
+    static std::string describe()
+    {
+        std::ostringstream out;
+        char const* sep = "";
+        for (T value : { Values... }) {
+            out << sep << value;
+            sep = ", ";
+        }
+        return out.str();
+    }
+
+  private:
+    template<class F>
+    static decltype(auto) dispatchIn(T, F& aFunctor)
+    {
+        return aFunctor(std::integral_constant<T, 0>());
+    }
+
+    template<class F, T Value, T... Rest>
+    static decltype(auto) dispatchIn(T aValue, F& aFunctor)
+    {
+        if (aValue == Value) return aFunctor(std::integral_constant<T, Value>());
+        return dispatchIn<F, Rest...>(aValue, aFunctor);
+    }
+};
+
+/*
+ * Typed schema for the option strings that configure component structures
+ * such as cache arrays and directories:
+ *
+ *      [<Type>:]<key>=<value>[:<key>=<value>...]
+ *
+ * A structure declares its options once, as members of a plain struct with
+ * their defaults, along with their aliases and the keys that exclude each
+ * other. parse() fills a copy of that struct in one pass when the component
+ * is built, and stops the simulation on an unknown key, a malformed value,
+ * a key given twice or two conflicting keys, listing the valid keys. A key
+ * without a value stands for <key>=1.
+ */
+template<class Options>
+class OptionSchema
+{
+    struct Option
+    {
+        std::vector<std::string> theKeys;
+        std::string theDescription;
+        std::function<bool(Options&, std::string const&)> theSetter;
+    };
+
+    std::string theWhat;
+    std::vector<Option> theOptions;
+    std::vector<std::pair<std::size_t, std::size_t>> theExclusions;
+
+    std::size_t find(std::string const& aKey) const
+    {
+        for (std::size_t i = 0; i < theOptions.size(); ++i) {
+            for (auto const& key : theOptions[i].theKeys) {
+                if (strcasecmp(key.c_str(), aKey.c_str()) == 0) return i;
+            }
+        }
+        return theOptions.size();
+    }
+
+  public:
+    explicit OptionSchema(std::string const& aWhat)
+      : theWhat(aWhat)
+    {
+    }
+
+    // aKeys lists the key then its aliases, separated by '|'
+    template<class T>
+    OptionSchema& option(std::string const& aKeys, T Options::*aMember, std::string const& aDescription)
+    {
+        Option option;
+        std::istringstream keys(aKeys);
+        for (std::string key; std::getline(keys, key, '|');) {
+            option.theKeys.push_back(key);
+        }
+        option.theDescription = aDescription;
+        option.theSetter      = [aMember](Options& anOptions, std::string const& aValue) {
+            return aux_::parseOption(aValue, anOptions.*aMember);
+        };
+        theOptions.push_back(option);
+        return *this;
+    }
+
+    // An option whose hot loops are compiled for the values of Specializations
+    template<class T, T... Values>
+    OptionSchema& option(std::string const& aKeys,
+                         T Options::*aMember,
+                         std::string const& aDescription,
+                         Specializations<T, Values...> const&)
+    {
+        return option(aKeys,
+                      aMember,
+                      aDescription + " (specialized for " + Specializations<T, Values...>::describe() + ")");
+    }
+
+    // At most one of the two keys may be given
+    OptionSchema& exclusive(std::string const& aKey, std::string const& anOtherKey)
+    {
+        DBG_Assert(find(aKey) < theOptions.size() && find(anOtherKey) < theOptions.size());
+        theExclusions.push_back(std::make_pair(find(aKey), find(anOtherKey)));
+        return *this;
+    }
+
+    std::string describe() const
+    {
+        std::ostringstream out;
+        for (auto const& option : theOptions) {
+            out << "\n    " << option.theKeys[0];
+            for (std::size_t i = 1; i < option.theKeys.size(); ++i) {
+                out << " (or " << option.theKeys[i] << ")";
+            }
+            out << ": " << option.theDescription;
+        }
+        return out.str();
+    }
+
+    Options parse(std::string const& aSpec, Options const& aDefaults = Options()) const
+    {
+        Options options(aDefaults);
+        std::vector<bool> given(theOptions.size(), false);
+
+        std::istringstream spec(aSpec);
+        for (std::string arg; std::getline(spec, arg, ':');) {
+            if (arg.empty()) continue;
+            std::string::size_type equal = arg.find('=');
+            std::string key              = arg.substr(0, equal);
+            std::string value            = (equal == std::string::npos) ? "1" : arg.substr(equal + 1);
+
+            std::size_t i = find(key);
+            if (i == theOptions.size()) {
+                DBG_Assert(false,
+                           (<< "Unknown option '" << key << "' in '" << aSpec << "' for " << theWhat
+                            << ". Valid options are:" << describe()));
+                continue;
+            }
+            DBG_Assert(!given[i], (<< "Option '" << key << "' is given twice in '" << aSpec << "' for " << theWhat));
+            given[i] = true;
+            if (!theOptions[i].theSetter(options, value)) {
+                DBG_Assert(false, (<< "Invalid value '" << value << "' for option '" << key << "' of " << theWhat));
+            }
+        }
+
+        for (auto const& exclusion : theExclusions) {
+            DBG_Assert(!given[exclusion.first] || !given[exclusion.second],
+                       (<< "Options '" << theOptions[exclusion.first].theKeys[0] << "' and '"
+                        << theOptions[exclusion.second].theKeys[0] << "' conflict in '" << aSpec << "' for "
+                        << theWhat));
+        }
+        return options;
+    }
+};
+
+// Splits "<Type>:<options>" into the type and the options
+inline std::pair<std::string, std::string>
+splitOptionType(std::string const& aSpec)
+{
+    std::string::size_type colon = aSpec.find(':');
+    if (colon == std::string::npos) return std::make_pair(aSpec, std::string());
+    return std::make_pair(aSpec.substr(0, colon), aSpec.substr(colon + 1));
+}
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CORE_OPTION_SCHEMA_HPP_INCLUDED
@@ -0,0 +1,120 @@
+#include "perf_counters.hpp"
+
+#include <core/debug/debug.hpp>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace nProfile {
+
+bool PerfCounters::theEnabled = false;
+
+namespace {
+
+struct Event
+{
+    char const* theName;
+    uint32_t theType;
+    uint64_t theConfig;
+};
+
+constexpr uint64_t
+cacheMiss(uint64_t aCache)
+{
+    return aCache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+const Event theEvents[PerfCounters::kEvents] = {
+    { "insns", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { "L1D", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D) },
+    { "LLC", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL) },
+    { "branch", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { "dTLB", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+// The group leader is the first event that opened. The group is read in
+// one go, in the order the members were opened.
+int theLeader = -1;
+int theMembers = 0;
+int theMemberEvent[PerfCounters::kEvents];
+bool theSupported[PerfCounters::kEvents];
+
+int
+open(Event const& anEvent, int aGroup)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = anEvent.theType;
+    attr.config         = anEvent.theConfig;
+    attr.disabled       = (aGroup == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, aGroup, 0);
+}
+
+} // namespace
+
+void
+PerfCounters::configure()
+{
+    char const* spec = getenv("FLEXUS_PROFILE_EVENTS");
+    if (spec == nullptr || std::strtoul(spec, nullptr, 10) == 0 || theEnabled) return;
+
+#ifndef PROFILING_ENABLED
+    DBG_(Crit, (<< "FLEXUS_PROFILE_EVENTS needs a profiling build (FLEXUS_PROFILING=ON), ignored"));
+    return;
+#endif
+
+    for (int32_t i = 0; i < kEvents; ++i) {
+        int fd = open(theEvents[i], theLeader);
+        theSupported[i] = (fd != -1);
+        if (fd == -1) {
+            DBG_(Dev, (<< "FLEXUS_PROFILE_EVENTS: " << theEvents[i].theName << " not counted: " << strerror(errno)));
+            continue;
+        }
+        if (theLeader == -1) theLeader = fd;
+        theMemberEvent[theMembers++] = i;
+    }
+    if (theLeader == -1) {
+        DBG_(Crit, (<< "FLEXUS_PROFILE_EVENTS: no host event can be counted, profiling time only"));
+        return;
+    }
+
+    ioctl(theLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(theLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    theEnabled = true;
+    DBG_(Dev, (<< "Profiler: counting " << theMembers << " host events per drive"));
+}
+
+bool
+PerfCounters::supported(eEvent anEvent)
+{
+    return theSupported[anEvent];
+}
+
+char const*
+PerfCounters::name(eEvent anEvent)
+{
+    return theEvents[anEvent].theName;
+}
+
+void
+PerfCounters::read(Counts& aCounts)
+{
+    // PERF_FORMAT_GROUP: the member count, then one value per member
+    uint64_t values[1 + kEvents];
+    std::memset(&aCounts, 0, sizeof(aCounts));
+    if (::read(theLeader, values, sizeof(values)) < ssize_t(sizeof(uint64_t))) return;
+    for (uint64_t i = 0; i < values[0] && i < uint64_t(theMembers); ++i) {
+        aCounts.theCount[theMemberEvent[i]] = values[1 + i];
+    }
+}
+
+} // namespace nProfile
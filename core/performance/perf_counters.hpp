@@ -0,0 +1,57 @@
+#ifndef FLEXUS_PERF_COUNTERS_HPP_INCLUDED
+#define FLEXUS_PERF_COUNTERS_HPP_INCLUDED
+
+#include <cstdint>
+
+namespace nProfile {
+
+/*
+ * Host hardware event counters for the profiler.
+ *
+ * One perf_event group counting the events below for the simulation thread,
+ * in user space only. A profiler site declared with FLEXUS_PROFILE_EVENTS_N
+ * reads the whole group on entry and exit, so that its events are attributed
+ * exactly like its time, total and self. Each read is one system call, which
+ * is why only the drive sites count events.
+ *
+ * Drives run on uncore pool workers are not counted, only the wait for them.
+ *
+ * The counters are opened at startup when the FLEXUS_PROFILE_EVENTS
+ * environment variable is set to a non-zero value, in profiling builds only
+ * (FLEXUS_PROFILING=ON). Events the host does not support read as zero.
+ */
+class PerfCounters
+{
+  public:
+    enum eEvent
+    {
+        kInstructions,
+        kCycles,
+        kL1DMisses,
+        kLLCMisses,
+        kBranchMisses,
+        kDTLBMisses,
+        kEvents
+    };
+
+    struct Counts
+    {
+        uint64_t theCount[kEvents];
+    };
+
+    // Reads FLEXUS_PROFILE_EVENTS and opens the group.
+    static void configure();
+    static bool enabled() { return theEnabled; }
+    static bool supported(eEvent anEvent);
+    static char const* name(eEvent anEvent);
+
+    // Current value of every event since configure()
+    static void read(Counts& aCounts);
+
+  private:
+    static bool theEnabled;
+};
+
+} // namespace nProfile
+
+#endif // FLEXUS_PERF_COUNTERS_HPP_INCLUDED
@@ -17,13 +17,15 @@ namespace nProfile {
 
 using namespace std::chrono;
 
-ProfileManager* theProfileManager = 0;
-Profiler* theProfileTOS           = 0;
+thread_local Profiler* theProfileTOS  = 0;
+thread_local Profiler* theEventTOS    = 0;
+thread_local bool theProfileSuspended = false;
 
 ProfileManager*
 ProfileManager::profileManager()
 {
-    if (theProfileManager == 0) { theProfileManager = new ProfileManager(); }
+    // Never torn down, and built once even if two threads race to it
+    static ProfileManager* theProfileManager = new ProfileManager();
     return theProfileManager;
 }
 
@@ -39,6 +41,12 @@ sortSelfTime(Profiler* left, Profiler* right)
     return left->selfTime() > right->selfTime();
 }
 
+bool
+sortSelfCycles(Profiler* left, Profiler* right)
+{
+    return left->selfEvents(PerfCounters::kCycles) > right->selfEvents(PerfCounters::kCycles);
+}
+
 std::string
 rightmost(std::string const& aString, uint32_t N)
 {
@@ -129,6 +137,41 @@ ProfileManager::report(std::ostream& out)
         out << std::endl;
     }
     out << "\n";
+
+    if (!PerfCounters::enabled()) return;
+
+    out << "Host events by Self, sorted by Self Cycles (misses per 1000 instructions) \n";
+    std::sort(theProfilers.begin(), theProfilers.end(), &sortSelfCycles);
+
+    out << "File                          "
+        << " ";
+    out << "Function/Name                 "
+        << " ";
+    out << "Self Cycles     "
+        << "  IPC ";
+    for (int32_t e = PerfCounters::kL1DMisses; e < PerfCounters::kEvents; ++e) {
+        out << std::setw(8) << PerfCounters::name(PerfCounters::eEvent(e)) << " ";
+    }
+    out << "\n";
+    for (iter = theProfilers.begin(), end = theProfilers.end(); iter != end; ++iter) {
+        if (!(*iter)->countsEvents()) continue;
+        uint64_t insns = (*iter)->selfEvents(PerfCounters::kInstructions);
+        uint64_t cycles = (*iter)->selfEvents(PerfCounters::kCycles);
+        std::string file_line = (*iter)->file() + ":" + std::to_string((*iter)->line());
+        out << rightmost(file_line, 30) << " ";
+        out << leftmost((*iter)->name(), 30) << " ";
+        out << std::setiosflags(std::ios::right) << std::setw(16) << cycles << " ";
+        out << std::setw(5) << (cycles ? static_cast<float>(insns) / cycles : 0.0f);
+        for (int32_t e = PerfCounters::kL1DMisses; e < PerfCounters::kEvents; ++e) {
+            if (PerfCounters::supported(PerfCounters::eEvent(e)) && insns) {
+                out << " " << std::setw(8) << 1000.0f * (*iter)->selfEvents(PerfCounters::eEvent(e)) / insns;
+            } else {
+                out << " " << std::setw(8) << "-";
+            }
+        }
+        out << std::endl;
+    }
+    out << "\n";
 }
 
 } // namespace nProfile
@@ -2,6 +2,9 @@
 #define FLEXUS_PROFILE_HPP_INCLUDED
 
 #include <boost/preprocessor/cat.hpp>
+#include <chrono>
+#include <core/performance/perf_counters.hpp>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -10,28 +13,46 @@ namespace nProfile {
 inline int64_t
 rdtsc()
 {
-    return 0;
+#if defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
 }
 
 class Timer;
 class ManualTimer;
+class EventTimer;
 class Profiler;
 
 class ProfileManager
 {
     std::vector<Profiler*> theProfilers;
+    std::mutex theLock;
     int64_t theStartTime;
 
   public:
     ProfileManager() { theStartTime = rdtsc(); }
-    void addProfiler(Profiler* aProfiler) { theProfilers.push_back(aProfiler); }
+    // A site may first be reached on an uncore pool worker
+    void addProfiler(Profiler* aProfiler)
+    {
+        std::lock_guard<std::mutex> lock(theLock);
+        theProfilers.push_back(aProfiler);
+    }
     inline int64_t programTime() { return (rdtsc() - theStartTime) / 1000; }
     void report(std::ostream&);
     void reset();
     static ProfileManager* profileManager();
 };
 
-extern Profiler* theProfileTOS;
+extern thread_local Profiler* theProfileTOS;
+extern thread_local Profiler* theEventTOS;
+
+// Set while a thread runs uncore pool tasks. The Profiler of a site is
+// shared by every thread that reaches it and its counters are not atomic,
+// so the sites reached from pool tasks are not timed; the drive site that
+// waits for the pool still is.
+extern thread_local bool theProfileSuspended;
 
 class Profiler
 {
@@ -41,8 +62,13 @@ class Profiler
     int64_t theTimeIn;
     int64_t theTimeAccum;
     int64_t theTimeAccumChildren;
+    bool theCountsEvents;
+    PerfCounters::Counts theEventsIn;
+    PerfCounters::Counts theEventsAccum;
+    PerfCounters::Counts theEventsAccumChildren;
     friend class Timer;
     friend class ManualTimer;
+    friend class EventTimer;
 
   public:
     std::string const& name() const { return theFn; }
@@ -50,23 +76,32 @@ class Profiler
     int64_t line() const { return theLine; }
     int64_t totalTime() const { return theTimeAccum / 1000; }
     int64_t selfTime() const { return (theTimeAccum - theTimeAccumChildren) / 1000; }
+    bool countsEvents() const { return theCountsEvents; }
+    uint64_t selfEvents(PerfCounters::eEvent anEvent) const
+    {
+        return theEventsAccum.theCount[anEvent] - theEventsAccumChildren.theCount[anEvent];
+    }
 
-    Profiler(std::string const& aFn, std::string const& aFile, int64_t aLine)
+    Profiler(std::string const& aFn, std::string const& aFile, int64_t aLine, bool aCountsEvents = false)
       : theFn(aFn)
       , theFile(aFile)
       , theLine(aLine)
       , theTimeIn(0)
       , theTimeAccum(0)
       , theTimeAccumChildren(0)
+      , theCountsEvents(aCountsEvents)
     {
+        reset();
         ProfileManager::profileManager()->addProfiler(this);
     }
 
     void reset()
     {
-        theTimeIn            = 0;
-        theTimeAccum         = 0;
-        theTimeAccumChildren = 0;
+        theTimeIn              = 0;
+        theTimeAccum           = 0;
+        theTimeAccumChildren   = 0;
+        theEventsAccum         = PerfCounters::Counts();
+        theEventsAccumChildren = PerfCounters::Counts();
     }
 };
 
@@ -74,17 +109,21 @@ class Timer
 {
     Profiler& theProfiler;
     Profiler* theParent;
+    bool theActive;
 
   public:
     inline Timer(Profiler& aProfiler)
       : theProfiler(aProfiler)
+      , theActive(!theProfileSuspended)
     {
+        if (!theActive) return;
         theParent             = theProfileTOS;
         theProfileTOS         = &theProfiler;
         theProfiler.theTimeIn = rdtsc();
     }
     inline ~Timer()
     {
+        if (!theActive) return;
         if (theProfiler.theTimeIn != 0) {
             int64_t delta = rdtsc() - theProfiler.theTimeIn;
             if (delta > 0) {
@@ -107,10 +146,14 @@ class ManualTimer
     {
     }
 
-    inline void start() { theProfiler.theTimeIn = rdtsc(); }
+    inline void start()
+    {
+        if (!theProfileSuspended) theProfiler.theTimeIn = rdtsc();
+    }
 
     inline void stop()
     {
+        if (theProfileSuspended) return;
         if (theProfiler.theTimeIn != 0) {
             int64_t delta = rdtsc() - theProfiler.theTimeIn;
             if (delta > 0) { theProfiler.theTimeAccum += delta; }
@@ -119,7 +162,39 @@ class ManualTimer
     }
 };
 
-#undef PROFILING_ENABLED
+// A Timer that also attributes the host events counted by PerfCounters,
+// self and total, through its own stack of event-counting profilers
+class EventTimer : public Timer
+{
+    Profiler& theProfiler;
+    Profiler* theParent;
+
+  public:
+    inline EventTimer(Profiler& aProfiler)
+      : Timer(aProfiler)
+      , theProfiler(aProfiler)
+      , theParent(nullptr)
+    {
+        if (!PerfCounters::enabled() || theProfileSuspended) return;
+        theParent   = theEventTOS;
+        theEventTOS = &theProfiler;
+        PerfCounters::read(theProfiler.theEventsIn);
+    }
+    inline ~EventTimer()
+    {
+        if (!PerfCounters::enabled() || theProfileSuspended) return;
+        PerfCounters::Counts now;
+        PerfCounters::read(now);
+        for (int32_t i = 0; i < PerfCounters::kEvents; ++i) {
+            uint64_t delta = now.theCount[i] - theProfiler.theEventsIn.theCount[i];
+            theProfiler.theEventsAccum.theCount[i] += delta;
+            if (theParent) { theParent->theEventsAccumChildren.theCount[i] += delta; }
+        }
+        theEventTOS = theParent;
+    }
+};
+
+// Defined by the FLEXUS_PROFILING build option
 #ifdef PROFILING_ENABLED
 
 #define FLEXUS_PROFILE()                                                                                               \
@@ -130,10 +205,15 @@ class ManualTimer
     static nProfile::Profiler BOOST_PP_CAT(profiler, __LINE__)(name, __FILE__, __LINE__);                              \
     nProfile::Timer BOOST_PP_CAT(timer, __LINE__)(BOOST_PP_CAT(profiler, __LINE__)) /**/
 
+#define FLEXUS_PROFILE_EVENTS_N(name)                                                                                  \
+    static nProfile::Profiler BOOST_PP_CAT(profiler, __LINE__)(name, __FILE__, __LINE__, true);                        \
+    nProfile::EventTimer BOOST_PP_CAT(timer, __LINE__)(BOOST_PP_CAT(profiler, __LINE__)) /**/
+
 #else
 
-#define FLEXUS_PROFILE()       while (false)
-#define FLEXUS_PROFILE_N(name) while (false)
+#define FLEXUS_PROFILE()              while (false)
+#define FLEXUS_PROFILE_N(name)        while (false)
+#define FLEXUS_PROFILE_EVENTS_N(name) while (false)
 
 #endif
 
@@ -0,0 +1,109 @@
+#include <core/debug/debug.hpp>
+#include <core/flexus.hpp>
+#include <core/port_recorder.hpp>
+
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace Flexus {
+namespace Core {
+
+PortRecorder&
+PortRecorder::recorder()
+{
+    static PortRecorder theRecorder;
+    return theRecorder;
+}
+
+PortRecorder::PortRecorder()
+  : theRecords(0)
+{
+    char const* file  = getenv("FLEXUS_RECORD");
+    char const* wires = getenv("FLEXUS_RECORD_WIRES");
+    if (file == nullptr) return;
+
+    theFileName = file;
+    if (wires != nullptr) {
+        std::string spec(wires);
+        boost::split(theSelection, spec, boost::is_any_of(", \t"), boost::token_compress_on);
+        theSelection.erase(std::remove(theSelection.begin(), theSelection.end(), ""), theSelection.end());
+    }
+    if (theSelection.empty()) {
+        DBG_(Crit, (<< "FLEXUS_RECORD is set but FLEXUS_RECORD_WIRES selects no port; nothing will be recorded"));
+    }
+}
+
+PortRecorder::~PortRecorder()
+{
+    if (theFile.is_open()) {
+        std::cerr << "Recorded " << theRecords << " port records to " << theFileName << std::endl;
+    }
+}
+
+bool
+PortRecorder::selected(std::string const& aDestination) const
+{
+    std::string instance = aDestination.substr(0, aDestination.find('.'));
+    for (auto const& spec : theSelection) {
+        if (spec == aDestination || spec == instance) return true;
+    }
+    return false;
+}
+
+int32_t
+PortRecorder::tap(std::string const& aDestination, std::string const& aWire, char const* aPayload)
+{
+    if (theFileName.empty() || !selected(aDestination)) return -1;
+
+    auto iter = theChannels.find(aDestination);
+    if (iter != theChannels.end()) {
+        DBG_(Dev, (<< "Recording " << aWire << " on channel " << iter->second));
+        return iter->second;
+    }
+
+    if (!theFile.is_open()) {
+        theFile.open(theFileName, std::ios::binary | std::ios::trunc);
+        DBG_Assert(theFile.good(), (<< "Unable to open port recording " << theFileName));
+        theFile.write("FLEXREC1", 8);
+    }
+
+    int32_t channel = theChannels.size();
+    DBG_Assert(channel <= UINT16_MAX, (<< "Too many recorded ports"));
+    theChannels[aDestination] = channel;
+
+    std::string header;
+    PortWriter out(header);
+    out.put<char>('C');
+    out.put<uint16_t>(channel);
+    out.putString(aDestination);
+    out.putString(aPayload);
+    theFile.write(header.data(), header.size());
+
+    DBG_(Dev, (<< "Recording " << aWire << " on channel " << channel << " to " << theFileName));
+    return channel;
+}
+
+void
+PortRecorder::record(int32_t aChannel, index_t anIndex, std::string const& aPayload)
+{
+    char header[1 + sizeof(uint16_t) + sizeof(uint64_t) + 2 * sizeof(uint32_t)];
+    char* cursor = header;
+    auto put     = [&cursor](auto aValue) {
+        std::memcpy(cursor, &aValue, sizeof(aValue));
+        cursor += sizeof(aValue);
+    };
+    put(char('R'));
+    put(uint16_t(aChannel));
+    put(uint64_t(theFlexus->cycleCount()));
+    put(uint32_t(anIndex));
+    put(uint32_t(aPayload.size()));
+
+    theFile.write(header, sizeof(header));
+    theFile.write(aPayload.data(), aPayload.size());
+    ++theRecords;
+}
+
+} // namespace Core
+} // namespace Flexus
@@ -0,0 +1,160 @@
+#ifndef FLEXUS_PORT_RECORDER_HPP_INCLUDED
+#define FLEXUS_PORT_RECORDER_HPP_INCLUDED
+
+#include <core/debug/debug.hpp>
+#include <core/types.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Recording of port traffic, for replaying it into a single component later
+ * (see port_replay.hpp).
+ *
+ * A wire can be tapped when the payload of its destination port has a
+ * port_codec. Taps are chosen when the wiring is connected:
+ *
+ *    FLEXUS_RECORD=<file> FLEXUS_RECORD_WIRES=<dest>[,<dest>]*
+ *
+ * where <dest> is a destination instance (theL1d) or instance and port
+ * (theL1d.FrontSideIn_Request). A tapped wire goes through record_channel,
+ * which stamps every push (or pull) with the Flexus cycle and appends the
+ * encoded payload to the file. Untapped wires keep their direct jump table
+ * entry, so there is no cost when recording is off.
+ *
+ * File layout, in host byte order:
+ *
+ *    "FLEXREC1"                                             header
+ *    'C' u16 channel, str destination, str payload          channel declaration
+ *    'R' u16 channel, u64 cycle, u32 index, u32 size, data  port traffic
+ *
+ * where str is a u32 length followed by the characters. A channel is a
+ * destination port; all wires into it share the channel.
+ */
+
+class PortWriter
+{
+    std::string& theBuffer;
+
+  public:
+    explicit PortWriter(std::string& aBuffer)
+      : theBuffer(aBuffer)
+    {
+    }
+
+    template<class T>
+    void put(T const& aValue)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written directly");
+        theBuffer.append(reinterpret_cast<char const*>(&aValue), sizeof(T));
+    }
+
+    void putString(std::string const& aString)
+    {
+        put<uint32_t>(aString.size());
+        theBuffer.append(aString);
+    }
+};
+
+class PortReader
+{
+    char const* theCursor;
+    char const* theEnd;
+
+  public:
+    PortReader(char const* aBegin, char const* anEnd)
+      : theCursor(aBegin)
+      , theEnd(anEnd)
+    {
+    }
+
+    template<class T>
+    T get()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read directly");
+        DBG_Assert(theCursor + sizeof(T) <= theEnd, (<< "Truncated port record"));
+        T value;
+        std::memcpy(&value, theCursor, sizeof(T));
+        theCursor += sizeof(T);
+        return value;
+    }
+
+    template<class T>
+    void get(T& aValue)
+    {
+        aValue = get<T>();
+    }
+
+    // Skips over aSize bytes, returning where they start
+    char const* take(std::size_t aSize)
+    {
+        DBG_Assert(theCursor + aSize <= theEnd, (<< "Truncated port record"));
+        char const* bytes = theCursor;
+        theCursor += aSize;
+        return bytes;
+    }
+
+    std::string getString()
+    {
+        uint32_t size = get<uint32_t>();
+        return std::string(take(size), size);
+    }
+
+    bool done() const { return theCursor == theEnd; }
+};
+
+// Encoding of a port payload. Specializations set recordable, and provide
+//    static char const* name();
+//    static void write(PortWriter&, Payload&);
+//    static void read(PortReader&, Payload&);
+template<class Payload>
+struct port_codec
+{
+    static const bool recordable = false;
+};
+
+class PortRecorder
+{
+  public:
+    static PortRecorder& recorder();
+    ~PortRecorder();
+
+    // Channel for the destination port aDestination (instance.port), or -1
+    // if it was not selected for recording
+    int32_t tap(std::string const& aDestination, std::string const& aWire, char const* aPayload);
+
+    // Whether FLEXUS_RECORD names a file
+    bool recording() const { return !theFileName.empty(); }
+
+    // Buffer to encode the next payload into
+    std::string& scratch()
+    {
+        theScratch.clear();
+        return theScratch;
+    }
+
+    void record(int32_t aChannel, index_t anIndex, std::string const& aPayload);
+
+  private:
+    PortRecorder();
+    bool selected(std::string const& aDestination) const;
+
+    std::string theFileName;
+    std::vector<std::string> theSelection;
+    std::ofstream theFile;
+    std::map<std::string, int32_t> theChannels;
+    std::string theScratch;
+    uint64_t theRecords;
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_PORT_RECORDER_HPP_INCLUDED
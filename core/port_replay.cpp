@@ -0,0 +1,198 @@
+#include <core/component.hpp>
+#include <core/configuration.hpp>
+#include <core/debug/debug.hpp>
+#include <core/drive_reference.hpp>
+#include <core/flexus.hpp>
+#include <core/port_replay.hpp>
+#include <core/stats.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <unistd.h>
+#include <vector>
+
+namespace Flexus {
+extern std::string oldcwd;
+
+namespace Core {
+
+namespace {
+
+// Stands in for the QEMU driven Flexus object: components only need the
+// cycle count, and the drive is called directly by the replay loop.
+class ReplayFlexus : public FlexusInterface
+{
+  public:
+    uint64_t theCycleCount = 0;
+
+    void initializeComponents() {}
+    void doCycle() { theCycleCount += Flexus::Wiring::theDrive.doCycle(); }
+    void setCycle(uint64_t aCycle) { theCycleCount = aCycle; }
+    bool quiescing() const { return false; }
+    uint64_t cycleCount() const { return theCycleCount; }
+    void reset_core_watchdog(uint32_t) {}
+    void terminateSimulation() {}
+    void setDebug(std::string const& aDebugSeverity) {}
+    void setStatInterval(uint64_t) {}
+    void setStopCycle(uint64_t) {}
+    void set_log_delay(uint64_t) {}
+    void setFrequency(std::string const& aSpec) {}
+    void doLoad(std::string const& aDirName) { ComponentManager::getComponentManager().doLoad(aDirName); }
+    void doSave(std::string const& aDirName) { ComponentManager::getComponentManager().doSave(aDirName); }
+    void writeMeasurement(std::string const& aMeasurement, std::string const& aFilename)
+    {
+        std::ofstream out(aFilename.c_str());
+        Stat::getStatManager()->printMeasurement(aMeasurement, out);
+    }
+};
+
+struct ReplayRecord
+{
+    uint64_t theCycle;
+    replay_event theEvent;
+};
+
+int
+usage(char const* aProgram)
+{
+    std::cerr << "Usage: " << aProgram
+              << " <recording> [-cfg <file>] [-load <checkpoint>] [-core <n>] [-drain <cycles>]"
+                 " [-<parameter> <value>]*"
+              << std::endl;
+    return 1;
+}
+
+} // namespace
+
+int
+runReplay(int anArgc, char** anArgv, void (*aRegister)(ReplayPorts&))
+{
+    if (anArgc < 2) return usage(anArgv[0]);
+
+    std::string recording = anArgv[1];
+    std::string config, checkpoint;
+    index_t instance = 0;
+    uint64_t drain   = 0;
+
+    // Everything that is not a replay option is a component parameter
+    std::vector<char*> parameters(1, anArgv[0]);
+    for (int i = 2; i < anArgc; ++i) {
+        std::string arg(anArgv[i]);
+        if (i + 1 == anArgc) return usage(anArgv[0]);
+        if (arg == "-cfg") {
+            config = anArgv[++i];
+        } else if (arg == "-load") {
+            checkpoint = anArgv[++i];
+        } else if (arg == "-core") {
+            instance = std::strtoul(anArgv[++i], nullptr, 0);
+        } else if (arg == "-drain") {
+            drain = std::strtoull(anArgv[++i], nullptr, 0);
+        } else {
+            parameters.push_back(anArgv[i]);
+            parameters.push_back(anArgv[++i]);
+        }
+    }
+
+    char* cwd = get_current_dir_name();
+    Flexus::oldcwd = cwd;
+    free(cwd);
+
+    static ReplayFlexus theReplayFlexus;
+    theFlexus = &theReplayFlexus;
+    if (std::ifstream(Flexus::oldcwd + "/debug.cfg").good()) Flexus::Dbg::Debugger::theDebugger->initialize();
+
+    ConfigurationManager& configuration = ConfigurationManager::getConfigurationManager();
+    configuration.processCommandLineConfiguration(parameters.size(), parameters.data());
+    if (!config.empty()) {
+        std::ifstream in(config.c_str());
+        DBG_Assert(in.good(), (<< "Unable to open configuration " << config));
+        configuration.parseConfiguration(in);
+    }
+
+    ComponentManager& components = ComponentManager::getComponentManager();
+    components.instantiateComponents(1, nullptr);
+    Stat::getStatManager()->initialize();
+    configuration.checkAllOverrides();
+    components.initComponents();
+    if (!checkpoint.empty()) components.doLoad(checkpoint);
+
+    ReplayPorts ports;
+    aRegister(ports);
+
+    // Decode the whole recording up front so the timed loop only replays
+    std::ifstream in(recording.c_str(), std::ios::binary);
+    DBG_Assert(in.good(), (<< "Unable to open port recording " << recording));
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    DBG_Assert(data.size() >= 8 && std::string(data.data(), 8) == "FLEXREC1",
+               (<< recording << " is not a port recording"));
+
+    std::vector<replay_decoder> channels;
+    std::vector<ReplayRecord> records;
+    uint64_t skipped = 0;
+    PortReader reader(data.data() + 8, data.data() + data.size());
+    while (!reader.done()) {
+        char kind = reader.get<char>();
+        if (kind == 'C') {
+            uint16_t channel        = reader.get<uint16_t>();
+            std::string destination = reader.getString();
+            std::string payload     = reader.getString();
+            if (channels.size() <= channel) channels.resize(channel + 1, nullptr);
+            channels[channel] = ports.find(destination);
+            std::cerr << "Channel " << channel << ": " << destination << " (" << payload << ")"
+                      << (channels[channel] ? "" : " is not replayed by this layout") << std::endl;
+        } else {
+            DBG_Assert(kind == 'R', (<< "Corrupt port recording " << recording));
+            uint16_t channel = reader.get<uint16_t>();
+            uint64_t cycle   = reader.get<uint64_t>();
+            index_t index    = reader.get<uint32_t>();
+            uint32_t size    = reader.get<uint32_t>();
+            DBG_Assert(channel < channels.size(), (<< "Record for undeclared channel " << channel));
+
+            char const* bytes = reader.take(size);
+            replay_event event;
+            if (channels[channel]) {
+                PortReader payload(bytes, bytes + size);
+                event = channels[channel](payload, index, instance);
+            }
+            if (event) {
+                records.push_back(ReplayRecord{ cycle, std::move(event) });
+            } else {
+                ++skipped;
+            }
+        }
+    }
+
+    if (records.empty()) {
+        std::cerr << "Nothing to replay for instance " << instance << " in " << recording << std::endl;
+        return 1;
+    }
+
+    uint64_t first = records.front().theCycle;
+    uint64_t last  = records.back().theCycle + drain;
+    theReplayFlexus.setCycle(first);
+
+    auto start  = std::chrono::steady_clock::now();
+    size_t next = 0;
+    while (theReplayFlexus.cycleCount() <= last) {
+        while (next < records.size() && records[next].theCycle <= theReplayFlexus.cycleCount()) {
+            records[next++].theEvent();
+        }
+        theReplayFlexus.doCycle();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    uint64_t cycles = theReplayFlexus.cycleCount() - first;
+    std::cout << "Replayed " << records.size() << " records (" << skipped << " skipped) over " << cycles
+              << " cycles in " << elapsed.count() / 1e6 << " ms: " << std::fixed << std::setprecision(1)
+              << double(elapsed.count()) / cycles << " ns/cycle" << std::endl;
+
+    components.finalizeComponents();
+    return 0;
+}
+
+} // namespace Core
+} // namespace Flexus
@@ -0,0 +1,84 @@
+#ifndef FLEXUS_PORT_REPLAY_HPP_INCLUDED
+#define FLEXUS_PORT_REPLAY_HPP_INCLUDED
+
+#include <boost/preprocessor/stringize.hpp>
+#include <core/aux_/wiring/channels.hpp>
+#include <core/port_recorder.hpp>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Replay of a port recording (see port_recorder.hpp) into a single component,
+ * without QEMU, to time it in isolation.
+ *
+ * A replay layout is a wiring file that instantiates only the component under
+ * test, leaves its outputs unwired, drives it, and defines
+ *
+ *    void Flexus::Wiring::registerReplayPorts(ReplayPorts&)
+ *
+ * listing the input ports that can be replayed with REPLAY_PORT. Its main()
+ * hands over to runReplay, which takes
+ *
+ *    <recording> [-cfg <file>] [-load <checkpoint>] [-core <n>] [-drain <cycles>]
+ *                [-<parameter> <value>]*
+ *
+ * Records of component instance <n> are pushed into the single replayed
+ * instance at the cycle they were recorded at, and the run reports host ns
+ * per simulated cycle.
+ */
+
+// Decodes one record for an instance; returns an empty function if the record
+// belongs to another instance
+typedef std::function<void()> replay_event;
+typedef replay_event (*replay_decoder)(PortReader& aReader, index_t anIndex, index_t anInstance);
+
+class ReplayPorts
+{
+    std::map<std::string, replay_decoder> theDecoders;
+
+  public:
+    void add(std::string const& aDestination, replay_decoder aDecoder) { theDecoders[aDestination] = aDecoder; }
+
+    replay_decoder find(std::string const& aDestination) const
+    {
+        auto iter = theDecoders.find(aDestination);
+        return iter == theDecoders.end() ? nullptr : iter->second;
+    }
+};
+
+template<class ToInstance, class ToPort>
+struct replay_channel
+{
+    typedef typename ToPort::payload payload;
+    typedef Flexus::Wiring::resolve_channel<ToInstance, ToPort, typename ToPort::port_type, ToPort::is_array> channel;
+
+    static replay_event decode(PortReader& aReader, index_t anIndex, index_t anInstance)
+    {
+        index_t width = 1;
+        if constexpr (ToPort::is_array) {
+            width = ToInstance::iface::width(ToInstance::getInstance().theConfiguration, ToPort());
+        }
+        if (anIndex / width != anInstance) return replay_event();
+
+        payload aPayload;
+        port_codec<payload>::read(aReader, aPayload);
+        index_t index = anIndex % width;
+        return [aPayload, index]() mutable { channel::invoke_manip(index, aPayload); };
+    }
+};
+
+int
+runReplay(int anArgc, char** anArgv, void (*aRegister)(ReplayPorts&));
+
+} // namespace Core
+} // namespace Flexus
+
+#define REPLAY_PORT(Instance, Port)                                                                                    \
+    aPorts.add(BOOST_PP_STRINGIZE(Instance) "." BOOST_PP_STRINGIZE(Port),                                              \
+               &Flexus::Core::replay_channel<Instance, Instance::iface::Port>::decode); /**/
+
+#endif // FLEXUS_PORT_REPLAY_HPP_INCLUDED
@@ -1,5 +1,9 @@
+#include <algorithm>
 #include <cassert>
 #include <core/flexus.hpp>
+#include <core/sampling.hpp>
+#include <core/warming.hpp>
+#include <cstring>
 
 namespace Flexus {
 namespace Qemu {
@@ -8,6 +12,16 @@ namespace API {
 #include "api.h"
 
 QEMU_API_t qemu_api;
+QEMU_API_EXT_t qemu_api_ext;
+
+void
+QEMU_get_api_extensions(QEMU_API_EXT_t const* api)
+{
+    std::memset(&qemu_api_ext, 0, sizeof(qemu_api_ext));
+    if (api == nullptr) return;
+    std::memcpy(&qemu_api_ext, api, std::min(api->api_size, sizeof(qemu_api_ext)));
+    qemu_api_ext.api_size = sizeof(qemu_api_ext);
+}
 
 void
 FLEXUS_get_api(FLEXUS_API_t* api)
@@ -42,10 +56,28 @@ FLEXUS_qmp(qmp_flexus_cmd_t aCMD, const char* anArgs)
     flexus_qmp(aCMD, anArgs);
 }
 
-void __attribute__((weak))
+// QEMU's memory trace: warms the components while it fast-forwards
+void
 FLEXUS_trace_mem(uint64_t idx, memory_transaction_t* tr)
 {
-    // not exposed in timing
+    if (!Sampling::warming()) return;
+
+    generic_transaction_t const& t = tr->s;
+    if (t.inquiry || t.ignore || t.physical_address == physical_address_t(-1)) return;
+
+    Warming::Reference ref;
+    switch (t.type) {
+        case QEMU_Trans_Instr_Fetch: ref.theAccess = Warming::kFetch; break;
+        case QEMU_Trans_Load: ref.theAccess = t.atomic ? Warming::kStore : Warming::kLoad; break;
+        case QEMU_Trans_Store: ref.theAccess = Warming::kStore; break;
+        default: return; // prefetches and cache maintenance
+    }
+    ref.theCore       = idx;
+    ref.thePC         = t.pc;
+    ref.theVirtual    = t.logical_address;
+    ref.thePhysical   = t.physical_address;
+    ref.theBranchType = t.branch_type;
+    Warming::reference(ref);
 }
 
 } // namespace API
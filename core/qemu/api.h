@@ -55,6 +55,8 @@ typedef enum
     QMP_FLEXUS_DOSAVE,
     QMP_FLEXUS_SAVESTATS,
     QMP_FLEXUS_TERMINATESIMULATION,
+    QMP_FLEXUS_SETFREQ,
+    QMP_FLEXUS_TELEMETRY,
 } qmp_flexus_cmd_t;
 
 typedef enum
@@ -102,6 +104,14 @@ typedef enum
     QEMU_PE_No_Exception = 1025,
 } pseudo_exceptions_t;
 
+typedef enum
+{
+    QEMU_EXCP_INTERRUPT = 0x10000, // async interruption
+    QEMU_EXCP_HLT       = 0x10001, // hlt instruction reached
+    QEMU_EXCP_DEBUG     = 0x10002, // cpu stopped after a breakpoint or singlestep
+    QEMU_EXCP_HALTED    = 0x10003, // cpu is halted (waiting for external event)
+} cpu_exec_exit_t;
+
 typedef enum
 {
     QEMU_Non_Branch           = 0,
@@ -200,6 +210,53 @@ typedef struct
 
 } memory_transaction_t;
 
+/**
+ * Result of a batched cpu_exec: how many of the requested steps
+ * retired an instruction, and the return code of the last step.
+ */
+typedef struct
+{
+    uint64_t executed;
+    uint64_t exit_reason;
+} cpu_exec_batch_t;
+
+/**
+ * One register of a batched register read: the register and index as
+ * passed to read_register, and the value QEMU fills in.
+ */
+typedef struct
+{
+    register_type_t reg;
+    size_t reg_info;
+    uint64_t value;
+} register_read_t;
+
+/**
+ * One range of a gathered physical memory read.
+ */
+typedef struct
+{
+    physical_address_t pa;
+    size_t nb_bytes;
+    uint8_t* buffer;
+} memory_read_t;
+
+/**
+ * Run state of one core, as published by QEMU in an array with one entry
+ * per core (see get_run_states). QEMU keeps it current; Flexus only loads
+ * from it. Each entry has a cache line of its own, so that QEMU updating
+ * one core does not take the line Flexus is reading for another.
+ *
+ * halted is set while cpu_exec would return QEMU_EXCP_HALTED, and cleared
+ * as soon as the core has work again.
+ */
+typedef struct
+{
+    uint32_t irq_pending;
+    uint32_t halted;
+    uint8_t padding[56];
+} __attribute__((aligned(64))) cpu_run_state_t;
+
 struct cycles_opts
 {
     uint64_t until_stop;
@@ -237,6 +294,15 @@ typedef size_t (*QEMU_GET_NUM_CORES_t)(void);
 typedef logical_address_t (*QEMU_GET_PC_t)(size_t core_index);
 typedef bool (*QEMU_GET_IRQ_t)(size_t core_index);
 typedef uint64_t (*QEMU_CPU_EXEC_t)(size_t core_index, bool count);
+typedef cpu_exec_batch_t (*QEMU_CPU_EXEC_BATCH_t)(size_t core_index, uint64_t nb_steps, bool count);
+typedef void (*QEMU_READ_REGS_t)(size_t core_index, register_read_t* regs, size_t nb_regs);
+typedef void (*QEMU_GET_PAS_t)(size_t core_index,
+                               logical_address_t const* vas,
+                               physical_address_t* pas,
+                               size_t nb_addresses,
+                               bool unprivileged);
+typedef void (*QEMU_GET_MEMS_t)(memory_read_t* reads, size_t nb_reads);
+typedef cpu_run_state_t* (*QEMU_GET_RUN_STATES_t)(void);
 typedef void (*QEMU_TICK_t)(void);
 typedef void (*QEMU_GET_MEM_t)(uint8_t* buffer, physical_address_t pa, size_t nb_bytes);
 typedef void (*QEMU_STOP_t)(char const* const msg);
@@ -273,7 +339,24 @@ typedef struct QEMU_API_t
     QEMU_CPU_BUSY_t is_busy;
 } QEMU_API_t;
 
+// Optional entries, not part of QEMU_API_t so that its layout stays the one
+// every QEMU passes to flexus_init. A QEMU that has them calls
+// flexus_api_extensions before flexus_init, with api_size set to the size of
+// its own copy of this struct. Only the entries that fit in api_size are
+// copied; the others, and all of them on a QEMU that never calls it, stay
+// NULL. New entries go at the end.
+typedef struct QEMU_API_EXT_t
+{
+    size_t api_size;
+    QEMU_CPU_EXEC_BATCH_t cpu_exec_batch;
+    QEMU_READ_REGS_t read_registers;
+    QEMU_GET_PAS_t translate_va2pa_batch;
+    QEMU_GET_MEMS_t get_mem_batch;
+    QEMU_GET_RUN_STATES_t get_run_states;
+} QEMU_API_EXT_t;
+
 extern QEMU_API_t qemu_api;
+extern QEMU_API_EXT_t qemu_api_ext;
 extern FLEXUS_API_t flexus_api;
 
 #ifdef FLEXUS
@@ -288,6 +371,8 @@ FLEXUS_trace_mem(uint64_t, memory_transaction_t*);
 void
 QEMU_get_api(QEMU_API_t* api);
 void
+QEMU_get_api_extensions(QEMU_API_EXT_t const* api);
+void
 FLEXUS_get_api(FLEXUS_API_t* api);
 #endif
 
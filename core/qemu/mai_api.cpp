@@ -13,6 +13,7 @@
 #include <core/qemu/configuration_api.hpp>
 #include <core/qemu/mai_api.hpp>
 #include <core/qemu/qemu.h>
+#include <core/stats.hpp>
 #include <core/target.hpp>
 #include <core/types.hpp>
 #include <fstream>
@@ -26,5 +27,35 @@ using namespace Flexus::Core;
 namespace Flexus {
 namespace Qemu {
 
+namespace {
+
+struct CrossingStats
+{
+    // Never destroyed: the StatManager keeps pointers to them
+    Stat::StatCounter* theCrossings[kNumQemuCrossings];
+    Stat::StatCounter* theValues[kNumQemuCrossings];
+
+    CrossingStats()
+    {
+        static const char* kNames[kNumQemuCrossings] = { "Register", "SysReg", "Translate", "Memory" };
+        for (int32_t i = 0; i < kNumQemuCrossings; ++i) {
+            theCrossings[i] = new Stat::StatCounter(std::string("sys-qemu-crossings:") + kNames[i]);
+            theValues[i]    = new Stat::StatCounter(std::string("sys-qemu-values:") + kNames[i]);
+        }
+    }
+};
+
+} // namespace
+
+API::cpu_run_state_t const* theRunStates = nullptr;
+
+void
+countCrossing(eQemuCrossing aKind, uint64_t aValues)
+{
+    static CrossingStats theStats;
+    ++*theStats.theCrossings[aKind];
+    *theStats.theValues[aKind] += aValues;
+}
+
 } // end Namespace Qemu
 } // end namespace Flexus
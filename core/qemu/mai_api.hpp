@@ -17,6 +17,25 @@ namespace Qemu {
 using Flexus::SharedTypes::PhysicalMemoryAddress;
 using Flexus::SharedTypes::VirtualMemoryAddress;
 
+// Calls from Processor into QEMU state, counted in the sys-qemu-crossings
+// and sys-qemu-values stats. A batched call is one crossing moving several
+// values.
+enum eQemuCrossing
+{
+    kRegisterCrossing,
+    kSysRegCrossing,
+    kTranslateCrossing,
+    kMemoryCrossing,
+    kNumQemuCrossings
+};
+
+void
+countCrossing(eQemuCrossing aKind, uint64_t aValues = 1);
+
+// The run state QEMU publishes for every core, or nullptr on a QEMU that
+// does not. Set once by flexus_init.
+extern API::cpu_run_state_t const* theRunStates;
+
 class Processor
 {
 
@@ -28,6 +47,16 @@ class Processor
     {
     }
 
+    // Little-endian bytes to a value
+    static bits assemble(uint8_t const* aBuffer, size_t aSize)
+    {
+        bits tmp = 0;
+        for (size_t i = aSize; i-- > 0;) {
+            tmp = (tmp << 8) | aBuffer[i];
+        }
+        return tmp;
+    }
+
   public:
     static Processor getProcessor(uint64_t core_index = 0) { return Processor(core_index); }
 
@@ -38,66 +67,134 @@ class Processor
 
     uint64_t read_register(API::register_type_t reg, std::size_t index = 0xFF)
     {
+        countCrossing(kRegisterCrossing);
         return API::qemu_api.read_register(core_index, reg, index);
     }
 
+    // Fills aRegs[i].value for aCount registers in one crossing
+    void read_registers(API::register_read_t* aRegs, size_t aCount)
+    {
+        if (API::qemu_api_ext.read_registers) {
+            countCrossing(kRegisterCrossing, aCount);
+            API::qemu_api_ext.read_registers(core_index, aRegs, aCount);
+            return;
+        }
+        for (size_t i = 0; i < aCount; ++i) {
+            aRegs[i].value = read_register(aRegs[i].reg, aRegs[i].reg_info);
+        }
+    }
+
     // Timing implemented
     //
     VirtualMemoryAddress get_pc() const { return VirtualMemoryAddress(API::qemu_api.get_pc(core_index)); }
 
-    uint64_t has_irq() const { return API::qemu_api.has_irq(core_index); }
+    uint64_t has_irq() const
+    {
+        if (theRunStates) return __atomic_load_n(&theRunStates[core_index].irq_pending, __ATOMIC_RELAXED);
+        return API::qemu_api.has_irq(core_index);
+    }
+
+    // True when QEMU publishes that the core is halted with nothing to do,
+    // so advance() would only return QEMU_EXCP_HALTED. Always false on a
+    // QEMU that does not publish run state.
+    bool known_halted() const
+    {
+        return theRunStates && __atomic_load_n(&theRunStates[core_index].halted, __ATOMIC_RELAXED);
+    }
 
     uint64_t advance(bool count_time = true) { return API::qemu_api.cpu_exec(core_index, count_time); }
 
+    // Equivalent to nb_steps consecutive advance() calls, but crosses into
+    // QEMU only once when the batched entry point is available.
+    API::cpu_exec_batch_t advance_batch(uint64_t nb_steps, bool count_time = true)
+    {
+        if (API::qemu_api_ext.cpu_exec_batch) return API::qemu_api_ext.cpu_exec_batch(core_index, nb_steps, count_time);
+
+        API::cpu_exec_batch_t result = { 0, 0 };
+        for (uint64_t i = 0; i < nb_steps; i++) {
+            result.exit_reason = API::qemu_api.cpu_exec(core_index, count_time);
+            if (result.exit_reason != API::QEMU_EXCP_HALTED) result.executed++;
+        }
+        return result;
+    }
+
     PhysicalMemoryAddress translate_va2pa(VirtualMemoryAddress addr, bool unprivileged)
     {
+        countCrossing(kTranslateCrossing);
         return PhysicalMemoryAddress(API::qemu_api.translate_va2pa(core_index, addr, unprivileged));
     }
 
+    // Translates aCount addresses in one crossing
+    void translate_va2pa(API::logical_address_t const* aVAs,
+                         API::physical_address_t* aPAs,
+                         size_t aCount,
+                         bool unprivileged)
+    {
+        if (API::qemu_api_ext.translate_va2pa_batch) {
+            countCrossing(kTranslateCrossing, aCount);
+            API::qemu_api_ext.translate_va2pa_batch(core_index, aVAs, aPAs, aCount, unprivileged);
+            return;
+        }
+        for (size_t i = 0; i < aCount; ++i) {
+            countCrossing(kTranslateCrossing);
+            aPAs[i] = API::qemu_api.translate_va2pa(core_index, aVAs[i], unprivileged);
+        }
+    }
+
     bits read_va(VirtualMemoryAddress anAddress, size_t size, bool unprivileged)
     {
+        DBG_Assert(size <= 16);
         VirtualMemoryAddress finalAddress(((uint64_t)(anAddress) + size - 1) & ~0xFFF);
+        uint8_t buf[16];
 
         if ((finalAddress & 0x1000) != (anAddress & 0x1000)) {
-            // Break the access into two memory accesses on each page, then concaticate their result.
-            bits value1, value2;
-            size_t partial = finalAddress - anAddress; // Partial is the size of the first access.
-            value1         = read_pa(
-              PhysicalMemoryAddress(API::qemu_api.translate_va2pa(core_index, API::logical_address_t(anAddress), unprivileged)),
-              partial);
-            value2 = read_pa(
-              PhysicalMemoryAddress(API::qemu_api.translate_va2pa(core_index,
-              API::logical_address_t(finalAddress), unprivileged)), size - partial);
-            // * 8 convert bytes to bits. value2 si appended to value2
-            value2 = (value2 << (partial * 8)) | value1;
-            return value2;
+            // Break the access into two memory accesses on each page: both pages are translated
+            // in one crossing and read in another, straight into place.
+            size_t partial                = finalAddress - anAddress; // Partial is the size of the first access.
+            API::logical_address_t vas[2] = { API::logical_address_t(anAddress),
+                                              API::logical_address_t(finalAddress) };
+            API::physical_address_t pas[2];
+            translate_va2pa(vas, pas, 2, unprivileged);
+            API::memory_read_t reads[2] = { { pas[0], partial, buf }, { pas[1], size - partial, buf + partial } };
+            read_pa(reads, 2);
+            return assemble(buf, size);
         }
-        return read_pa(
-          PhysicalMemoryAddress(API::qemu_api.translate_va2pa(core_index, API::logical_address_t(anAddress), unprivileged)),
-          size);
+        return read_pa(translate_va2pa(anAddress, unprivileged), size);
     }
 
     uint32_t fetch_inst(VirtualMemoryAddress addr) { return static_cast<uint32_t>(read_va(addr, 4, false)); }
 
+    // Instructions are aligned and never cross a page, so an already
+    // translated fetch needs a single read
+    uint32_t fetch_inst(PhysicalMemoryAddress addr) const { return static_cast<uint32_t>(read_pa(addr, 4)); }
+
     bits read_pa(PhysicalMemoryAddress anAddress, size_t aSize) const
     {
-        uint8_t *buf = new uint8_t[aSize];
+        DBG_Assert(aSize <= 16);
+        uint8_t buf[16];
 
+        countCrossing(kMemoryCrossing);
         API::qemu_api.get_mem(buf, API::physical_address_t(anAddress), aSize);
+        return assemble(buf, aSize);
+    }
 
-        bits tmp = 0;
-        for (size_t i = 0; i < aSize; i++) {
-            const size_t s = i * 8;
-            bits val       = (((bits)buf[i] << s) & ((bits)0xff << s));
-            tmp |= val;
+    // Gathers aCount physical ranges in one crossing
+    void read_pa(API::memory_read_t* aReads, size_t aCount) const
+    {
+        if (API::qemu_api_ext.get_mem_batch) {
+            countCrossing(kMemoryCrossing, aCount);
+            API::qemu_api_ext.get_mem_batch(aReads, aCount);
+            return;
+        }
+        for (size_t i = 0; i < aCount; ++i) {
+            countCrossing(kMemoryCrossing);
+            API::qemu_api.get_mem(aReads[i].buffer, aReads[i].pa, aReads[i].nb_bytes);
         }
-
-        delete[] buf;
-        return tmp;
     }
 
     uint64_t read_sysreg(uint8_t opc0, uint8_t opc1, uint8_t opc2, uint8_t crn, uint8_t crm)
     {
+        countCrossing(kSysRegCrossing);
         return API::qemu_api.read_sys_register(core_index, opc0, opc1, opc2, crn, crm, false);
     }
 
@@ -118,10 +215,16 @@ class Processor
 
     void dump_state(SharedTypes::CPU_State& dump)
     {
-        dump.pc = read_register(API::PC);
+        API::register_read_t regs[33];
+        regs[0] = { API::PC, 0xFF, 0 };
+        for (std::size_t i{ 0 }; i < 32; i++) {
+            regs[i + 1] = { API::GENERAL, i, 0 };
+        }
+        read_registers(regs, 33);
 
+        dump.pc = regs[0].value;
         for (std::size_t i{ 0 }; i < 32; i++) {
-            dump.regs[i] = read_register(API::GENERAL, i);
+            dump.regs[i] = regs[i + 1].value;
         }
     }
 
@@ -3,6 +3,8 @@
 
 #include <core/debug/debug.hpp>
 #include <core/flexus.hpp>
+#include <core/telemetry.hpp>
+#include <fstream>
 #include <iterator>
 #include <map>
 #include <sstream>
@@ -105,6 +107,38 @@ class qmp_terminate_simulation : public qmp_flexus_i
 
 } qmp_terminate_simulation_;
 
+class qmp_set_freq : public qmp_flexus_i
+{
+
+    // <domain>=<GHz>[@<phase ps>][,<domain>=<GHz>[@<phase ps>]]*
+    virtual void execute(std::string anArgs) override
+    {
+        if (!anArgs.empty())
+            theFlexus->setFrequency(anArgs);
+        else
+            DBG_(Crit, (<< "Wrong number of arguments."));
+    }
+
+} qmp_set_freq_;
+
+class qmp_telemetry : public qmp_flexus_i
+{
+
+    // [<file>]: the throughput summary goes to the log, or to <file>
+    virtual void execute(std::string anArgs) override
+    {
+        if (anArgs.empty()) {
+            std::ostringstream report;
+            Telemetry::report(report);
+            DBG_(Dev, (<< report.str()));
+        } else {
+            std::ofstream out(anArgs.c_str());
+            Telemetry::report(out);
+        }
+    }
+
+} qmp_telemetry_;
+
 class qmp_default : public qmp_flexus_i
 {
 
@@ -127,6 +161,8 @@ qmp(qmp_flexus_cmd_t aCMD)
         case QMP_FLEXUS_DOLOAD: return qmp_do_load_;
         case QMP_FLEXUS_DOSAVE: return qmp_do_save_;
         case QMP_FLEXUS_TERMINATESIMULATION: return qmp_terminate_simulation_;
+        case QMP_FLEXUS_SETFREQ: return qmp_set_freq_;
+        case QMP_FLEXUS_TELEMETRY: return qmp_telemetry_;
         default: throw qmp_not_implemented();
     }
 }
@@ -20,6 +20,7 @@ namespace API {
 } // namespace Qemu
 } // namespace Flexus
 
+#include <core/qemu/mai_api.hpp>
 #include <fstream>
 
 // For debug purposes
@@ -122,6 +123,12 @@ std::string license_text = R"(
 extern "C"
 {
 
+    // Called by a QEMU that provides the optional entries, before flexus_init
+    void flexus_api_extensions(Flexus::Qemu::API::QEMU_API_EXT_t const* qemu)
+    {
+        Flexus::Qemu::API::QEMU_get_api_extensions(qemu);
+    }
+
     void flexus_init(Flexus::Qemu::API::QEMU_API_t* qemu,
                      Flexus::Qemu::API::FLEXUS_API_t* flexus,
                      uint32_t ncores,
@@ -139,6 +146,8 @@ extern "C"
 
         Flexus::Qemu::API::qemu_api = *qemu;
         Flexus::Qemu::API::FLEXUS_get_api(flexus);
+        if (Flexus::Qemu::API::qemu_api_ext.get_run_states)
+            Flexus::Qemu::theRunStates = Flexus::Qemu::API::qemu_api_ext.get_run_states();
 
         std::cout << license_text;
 
@@ -0,0 +1,333 @@
+#include <core/debug/debug.hpp>
+#include <core/option_schema.hpp>
+#include <core/sampling.hpp>
+#include <core/stats.hpp>
+#include <core/warming.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+namespace Flexus {
+namespace Core {
+
+const uint64_t Sampling::kFastForwardBatch;
+Sampling::ePhase Sampling::thePhase = Sampling::kOff;
+uint64_t Sampling::theCommitted     = 0;
+uint64_t Sampling::theEpoch         = 0;
+bool Sampling::theWarming           = false;
+
+namespace {
+
+struct SamplingOptions
+{
+    uint64_t skip     = 0;
+    uint64_t warm     = 20000;
+    uint64_t detail   = 10000;
+    uint64_t drain    = 20000;
+    double error      = 0.03;
+    double confidence = 0.997;
+    uint64_t min      = 30;
+    uint64_t max      = 0;
+    bool save         = false;
+    bool unwarmed     = false;
+    std::string log   = "sampling.csv";
+
+    static OptionSchema<SamplingOptions> const& schema()
+    {
+        static const OptionSchema<SamplingOptions> theSchema =
+          OptionSchema<SamplingOptions>("FLEXUS_SAMPLING")
+            .option("skip", &SamplingOptions::skip, "instructions per core fast-forwarded between windows")
+            .option("warm", &SamplingOptions::warm, "detailed cycles before each window, not measured")
+            .option("detail", &SamplingOptions::detail, "measured cycles per window")
+            .option("drain", &SamplingOptions::drain, "cycles at most waiting for quiescence")
+            .option("error", &SamplingOptions::error, "target CPI half width, relative to the mean")
+            .option("confidence", &SamplingOptions::confidence, "confidence level of the interval")
+            .option("min", &SamplingOptions::min, "windows before the error is checked")
+            .option("max", &SamplingOptions::max, "windows at most, 0 for no limit")
+            .option("save", &SamplingOptions::save, "save the component state when every warming but the first starts")
+            .option("unwarmed", &SamplingOptions::unwarmed, "do not warm the caches, TLBs and predictors while skipping")
+            .option("log", &SamplingOptions::log, "per-window CSV log");
+        return theSchema;
+    }
+};
+
+// Running mean and variance of the window samples (Welford)
+struct Estimate
+{
+    uint64_t n  = 0;
+    double mean = 0;
+    double m2   = 0;
+
+    void add(double aSample)
+    {
+        ++n;
+        double delta = aSample - mean;
+        mean += delta / n;
+        m2 += delta * (aSample - mean);
+    }
+
+    // Half width of the confidence interval for z standard errors
+    double halfWidth(double z) const { return n > 1 ? z * std::sqrt(m2 / (n - 1) / n) : INFINITY; }
+};
+
+struct State
+{
+    SamplingOptions theOptions;
+    double theZ;
+    index_t theCores;
+    std::ofstream theLog;
+
+    uint64_t thePhaseStart     = 0;
+    uint64_t theLastCycle      = 0;
+    uint64_t theCommittedStart = 0;
+    uint64_t theSkipped        = 0;
+    uint64_t theIdleWindows    = 0;
+    uint64_t theDrainTimeouts  = 0;
+    uint64_t theUnwarmed       = 0;
+
+    Estimate theCPI;
+    Estimate theIPC;
+
+    Stat::StatCounter theWindowsStat;
+    Stat::StatCounter theMeasuredCyclesStat;
+    Stat::StatCounter theMeasuredInstructionsStat;
+    Stat::StatCounter theSkippedStat;
+    Stat::StatStdDev theCPIStat;
+
+    State()
+      : theWindowsStat("sys-sampling-windows")
+      , theMeasuredCyclesStat("sys-sampling-measured-cycles")
+      , theMeasuredInstructionsStat("sys-sampling-measured-instructions")
+      , theSkippedStat("sys-sampling-skipped-instructions")
+      , theCPIStat("sys-sampling-CPI")
+    {
+    }
+};
+
+// Never torn down: the log is flushed window by window
+State* theState = nullptr;
+
+// Standard normal quantile such that P(|Z| < z) = aConfidence
+double
+zFor(double aConfidence)
+{
+    double low = 0, high = 10;
+    for (int32_t i = 0; i < 64; ++i) {
+        double mid = (low + high) / 2;
+        (std::erf(mid / std::sqrt(2.0)) < aConfidence ? low : high) = mid;
+    }
+    return low;
+}
+
+// Closes the window of aCycles cycles that committed anInstructions and
+// returns whether the estimate is good enough
+bool
+measured(State& s, uint64_t aCycle, uint64_t aCycles, uint64_t anInstructions)
+{
+    s.theMeasuredCyclesStat += aCycles;
+    s.theMeasuredInstructionsStat += anInstructions;
+    ++s.theWindowsStat;
+
+    // A window where every core sat halted has no CPI; it is logged but
+    // left out of the estimate
+    if (anInstructions == 0) {
+        ++s.theIdleWindows;
+    } else {
+        // Cycles per instruction of each core, on average over the cores
+        double cpi = double(aCycles) * s.theCores / anInstructions;
+        s.theCPI.add(cpi);
+        s.theIPC.add(1 / cpi);
+        s.theCPIStat << cpi;
+    }
+
+    double error = s.theCPI.halfWidth(s.theZ) / s.theCPI.mean;
+    if (s.theLog.is_open()) {
+        s.theLog << std::fixed << std::setprecision(4) << s.theCPI.n + s.theIdleWindows << ',' << aCycle << ','
+                 << s.theSkipped << ',' << anInstructions << ','
+                 << (anInstructions ? double(aCycles) * s.theCores / anInstructions : 0.0) << ',' << s.theCPI.mean
+                 << ',' << (s.theCPI.n > 1 ? error : 0.0) << std::endl;
+    }
+
+    uint64_t windows = s.theCPI.n + s.theIdleWindows;
+    if (s.theOptions.max && windows >= s.theOptions.max) {
+        DBG_(Dev, (<< "Sampling: " << windows << " windows measured, stopping at the window limit"));
+        return true;
+    }
+    if (s.theCPI.n >= std::max<uint64_t>(s.theOptions.min, 2) && error <= s.theOptions.error) {
+        DBG_(Dev, (<< "Sampling: CPI error " << error << " reached after " << windows << " windows"));
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void
+Sampling::configure(index_t aCoreCount)
+{
+    char const* spec = getenv("FLEXUS_SAMPLING");
+    if (spec == nullptr || theState != nullptr) return;
+
+    theState             = new State;
+    State& s             = *theState;
+    s.theOptions         = SamplingOptions::schema().parse(spec);
+    s.theCores           = aCoreCount;
+    SamplingOptions& opt = s.theOptions;
+    DBG_Assert(opt.detail > 0, (<< "FLEXUS_SAMPLING: detail must be at least one cycle"));
+    DBG_Assert(opt.confidence > 0 && opt.confidence < 1,
+               (<< "FLEXUS_SAMPLING: confidence " << opt.confidence << " is not between 0 and 1"));
+    s.theZ = zFor(opt.confidence);
+    if (opt.skip && opt.unwarmed) {
+        DBG_(Crit,
+             (<< "FLEXUS_SAMPLING: no functional warming while fast-forwarding; the reported error "
+                 "excludes the warming bias"));
+    }
+
+    s.theLog.open(opt.log.c_str());
+    if (!s.theLog) {
+        DBG_(Crit, (<< "FLEXUS_SAMPLING: cannot open " << opt.log << ", windows are not logged"));
+    } else {
+        s.theLog << "window,cycle,skipped,instructions,cpi,mean_cpi,error" << std::endl;
+    }
+
+    thePhase = kWarming;
+    DBG_(Dev,
+         (<< "Sampling: windows of " << opt.detail << " cycles after " << opt.warm << " warming cycles, "
+          << opt.skip << " instructions per core skipped between windows, until the CPI is within "
+          << opt.error * 100 << "% at " << opt.confidence * 100 << "% confidence"));
+}
+
+char const*
+Sampling::phaseName(ePhase aPhase)
+{
+    switch (aPhase) {
+        case kOff: return "run";
+        case kFastForward: return "fast-forward";
+        case kWarming: return "warming";
+        case kMeasuring: return "measuring";
+        case kDraining: return "draining";
+        case kDone: return "done";
+    }
+    return "unknown";
+}
+
+bool
+Sampling::cycle(uint64_t aCycle, bool aQuiesced)
+{
+    State& s       = *theState;
+    uint64_t spent = aCycle - s.thePhaseStart;
+    s.theLastCycle = aCycle;
+
+    ePhase next = thePhase;
+    switch (thePhase) {
+        case kWarming:
+            if (spent >= s.theOptions.warm) {
+                next                = kMeasuring;
+                s.theCommittedStart = theCommitted;
+            }
+            break;
+        case kMeasuring:
+            if (spent >= s.theOptions.detail) {
+                if (measured(s, aCycle, spent, theCommitted - s.theCommittedStart)) {
+                    next = kDone;
+                } else {
+                    next = s.theOptions.skip ? kDraining : kWarming;
+                }
+            }
+            break;
+        case kDraining:
+            if (aQuiesced || spent >= s.theOptions.drain) {
+                if (!aQuiesced) ++s.theDrainTimeouts;
+                // Warming updates the components in place, which is only
+                // safe once nothing is in flight
+                theWarming = aQuiesced && !s.theOptions.unwarmed;
+                if (!theWarming) ++s.theUnwarmed;
+                next = kFastForward;
+            }
+            break;
+        default: break;
+    }
+    if (next == thePhase) return false;
+    thePhase        = next;
+    s.thePhaseStart = aCycle;
+    return true;
+}
+
+uint64_t
+Sampling::fastForwardSteps()
+{
+    State& s = *theState;
+    return std::min(kFastForwardBatch, s.theOptions.skip - s.theSkipped % s.theOptions.skip);
+}
+
+bool
+Sampling::fastForwarded(uint64_t aSteps)
+{
+    State& s = *theState;
+    s.theSkipped += aSteps;
+    s.theSkippedStat += aSteps;
+    if (s.theSkipped % s.theOptions.skip != 0) return false;
+
+    if (theWarming && Warming::references() == 0) {
+        DBG_(Crit,
+             (<< "FLEXUS_SAMPLING: QEMU traced no memory reference while fast-forwarding, so nothing was "
+                 "warmed; its memory trace must be enabled"));
+    }
+
+    // QEMU ran ahead of the pipelines: warming starts from its state
+    theWarming = false;
+    ++theEpoch;
+    thePhase        = kWarming;
+    s.thePhaseStart = s.theLastCycle;
+    return true;
+}
+
+bool
+Sampling::saveWindows()
+{
+    return theState && theState->theOptions.save;
+}
+
+uint64_t
+Sampling::windows()
+{
+    return theState ? theState->theCPI.n + theState->theIdleWindows : 0;
+}
+
+void
+Sampling::report(std::ostream& anOstream)
+{
+    if (!theState) {
+        anOstream << "Sampling is disabled" << std::endl;
+        return;
+    }
+    State& s = *theState;
+    anOstream << "Sampling: " << windows() << " windows of " << s.theOptions.detail << " cycles";
+    if (s.theIdleWindows) anOstream << " (" << s.theIdleWindows << " idle)";
+    anOstream << ", " << s.theSkipped << " instructions per core fast-forwarded";
+    if (s.theDrainTimeouts) anOstream << ", " << s.theDrainTimeouts << " drains timed out";
+    anOstream << std::endl;
+    if (s.theSkipped) {
+        anOstream << "  " << Warming::references() << " references warmed, " << Warming::misses()
+                  << " private cache misses; " << s.theUnwarmed << " fast-forwards unwarmed" << std::endl;
+    }
+    if (s.theCPI.n < 2) {
+        anOstream << "  too few windows for an estimate" << std::endl;
+        return;
+    }
+    anOstream << std::fixed << std::setprecision(4) << "  CPI " << s.theCPI.mean << " +/- "
+              << s.theCPI.halfWidth(s.theZ) << " (" << 100 * s.theCPI.halfWidth(s.theZ) / s.theCPI.mean << "%)"
+              << std::endl
+              << "  IPC " << s.theIPC.mean << " +/- " << s.theIPC.halfWidth(s.theZ) << " ("
+              << 100 * s.theIPC.halfWidth(s.theZ) / s.theIPC.mean << "%)" << std::endl
+              << "  at " << std::setprecision(1) << 100 * s.theOptions.confidence << "% confidence" << std::endl;
+    if (s.theUnwarmed || (s.theSkipped && Warming::references() == 0)) {
+        anOstream << "  sampling error only: the bias of the unwarmed fast-forwards is not included" << std::endl;
+    }
+}
+
+} // namespace Core
+} // namespace Flexus
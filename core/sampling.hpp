@@ -0,0 +1,109 @@
+#ifndef FLEXUS_CORE_SAMPLING_HPP_INCLUDED
+#define FLEXUS_CORE_SAMPLING_HPP_INCLUDED
+
+#include <core/types.hpp>
+#include <cstdint>
+#include <ostream>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Sampled simulation, after SMARTS.
+ *
+ * Instead of one detailed run up to the stop cycle, the simulation goes
+ * round these phases:
+ *
+ *    fast-forward  QEMU alone runs <skip> instructions on every core; no
+ *                  drive runs and no cycle is counted, but the references
+ *                  it traces warm the caches, TLBs and predictors
+ *    warming       <warm> detailed cycles that refill the pipeline and the
+ *                  queues, not measured
+ *    measuring     <detail> detailed cycles, whose CPI is one sample
+ *    draining      fetch stops until every component is quiesced, or for
+ *                  <drain> cycles at most, then back to fast-forward
+ *
+ * After each window the mean CPI and the half width of its confidence
+ * interval are updated. The simulation ends once <min> windows have been
+ * measured and the half width is below <error> times the mean, or after
+ * <max> windows. The cores resynchronize with QEMU when a fast-forward ends
+ * (see epoch()). With skip=0 the warming and measuring phases alternate
+ * without leaving detailed simulation.
+ *
+ * While QEMU fast-forwards, every fetch, load and store it reports through
+ * its memory trace (FLEXUS_trace_mem) is applied to the components with
+ * Warming (see warming()), so a window starts from the cache, TLB and
+ * predictor state the skipped instructions left. QEMU's memory trace must
+ * be enabled for that. A fast-forward after a drain that timed out is not
+ * warmed, nor is any with unwarmed=1; the confidence interval only covers
+ * the sampling error, not the bias those leave, which report() points out.
+ *
+ * The controller is enabled at startup with the FLEXUS_SAMPLING environment
+ * variable, as a list of <key>=<value> separated by ':' (see configure()
+ * for the keys), e.g.
+ *
+ *    FLEXUS_SAMPLING=skip=1000000:warm=20000:detail=10000:error=0.03
+ *
+ * Every window is appended to sampling.csv and counted in the sys-sampling
+ * stats.
+ */
+class Sampling
+{
+  public:
+    enum ePhase
+    {
+        kOff,
+        kFastForward,
+        kWarming,
+        kMeasuring,
+        kDraining,
+        kDone
+    };
+
+    // Instructions per core QEMU runs in one fast-forward batch
+    static const uint64_t kFastForwardBatch = 10000;
+
+    // Reads FLEXUS_SAMPLING.
+    static void configure(index_t aCoreCount);
+    static ePhase phase() { return thePhase; }
+    static char const* phaseName(ePhase aPhase);
+
+    // One instruction committed by a detailed core
+    static void committed() { ++theCommitted; }
+
+    // Bumped at the end of every fast-forward: a core that sees it change
+    // flushes and resynchronizes with QEMU.
+    static uint64_t epoch() { return theEpoch; }
+
+    // Called once the drives of a detailed cycle ran, with whether the
+    // components are quiesced. True when the phase changed.
+    static bool cycle(uint64_t aCycle, bool aQuiesced);
+
+    // Instructions per core for the next fast-forward batch, then the batch
+    // done. True when the phase changed.
+    static uint64_t fastForwardSteps();
+    static bool fastForwarded(uint64_t aSteps);
+
+    // Whether the references QEMU traces are warming the components: during
+    // a fast-forward that started with every component quiesced
+    static bool warming() { return theWarming; }
+
+    // Whether the component state is saved when a warming starts, and the
+    // number of windows measured so far
+    static bool saveWindows();
+    static uint64_t windows();
+
+    // The estimates and their confidence intervals
+    static void report(std::ostream& anOstream);
+
+  private:
+    static ePhase thePhase;
+    static uint64_t theCommitted;
+    static uint64_t theEpoch;
+    static bool theWarming;
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CORE_SAMPLING_HPP_INCLUDED
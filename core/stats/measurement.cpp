@@ -881,6 +881,56 @@ SimpleMeasurement ::reduceNodes()
     }
 }
 
+void
+LiveStats::subscribe(Stat* aStat, Measurement* aMeasurement, std::function<void(StatValueBase const&)> aMerge)
+{
+    LiveStat& live = theLiveStats[aStat];
+    if (live.theSubscriptions.empty()) { live.theValue = aStat->createValue(); }
+    live.theSubscriptions.push_back(Subscription{ aMeasurement, aMerge });
+}
+
+void
+LiveStats::unsubscribe(Measurement* aMeasurement)
+{
+    std::map<Stat*, LiveStat>::iterator iter = theLiveStats.begin();
+    while (iter != theLiveStats.end()) {
+        std::vector<Subscription>& subs = iter->second.theSubscriptions;
+        subs.erase(std::remove_if(subs.begin(),
+                                  subs.end(),
+                                  [aMeasurement](Subscription const& aSub) {
+                                      return aSub.theMeasurement == aMeasurement;
+                                  }),
+                   subs.end());
+        if (subs.empty()) {
+            // Releasing the handle unlinks its updater from the stat
+            iter = theLiveStats.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void
+LiveStats::cut()
+{
+    for (auto& entry : theLiveStats) {
+        LiveStat& live                              = entry.second;
+        boost::intrusive_ptr<StatValueBase> segment = live.theValue.getValue();
+        live.theValue                               = entry.first->createValue();
+        for (auto& sub : live.theSubscriptions) {
+            sub.theMerge(*segment);
+        }
+    }
+}
+
+LiveStats&
+liveStats()
+{
+    // Leaked for the same reason as the StatManager: stats outlive it
+    static LiveStats* theLiveStats = new LiveStats();
+    return *theLiveStats;
+}
+
 PeriodicMeasurement::PeriodicMeasurement(std::string const& aName,
                                          std::string const& aStatExpression,
                                          int64_t aPeriod,
@@ -898,28 +948,38 @@ PeriodicMeasurement::PeriodicMeasurement(std::string const& aName,
     }
 }
 
+PeriodicMeasurement::~PeriodicMeasurement()
+{
+    liveStats().unsubscribe(this);
+}
+
 void
 PeriodicMeasurement ::addToMeasurement(Stat* aStat)
 {
     // Check if the stat should be included in this measurement
-    if (includeStat(aStat)) { theStats[aStat->name()] = aStat->createValueArray(); }
+    if (includeStat(aStat)) {
+        StatValueArrayHandle& handle = theStats[aStat->name()];
+        handle                       = aStat->createValueArray();
+        // Periods are filled from the shared live value
+        handle.releaseUpdater();
+        liveStats().subscribe(aStat, this, [&handle](StatValueBase const& aSegment) { handle.mergeCurrent(aSegment); });
+    }
 }
 
 void
 PeriodicMeasurement ::close()
 {
-    theCancelled                   = true;
-    stat_handle_map::iterator iter = theStats.begin();
-    stat_handle_map::iterator end  = theStats.end();
-    while (iter != end) {
-        iter->second.releaseUpdater();
-        ++iter;
+    if (!theCancelled) {
+        liveStats().cut();
+        liveStats().unsubscribe(this);
     }
+    theCancelled = true;
 }
 
 void
 PeriodicMeasurement ::print(std::ostream& anOstream, std::string const& options)
 {
+    if (!theCancelled) { liveStats().cut(); }
     stat_handle_map::iterator iter = theStats.begin();
     stat_handle_map::iterator end  = theStats.end();
     anOstream << *this << std::endl;
@@ -932,6 +992,7 @@ PeriodicMeasurement ::print(std::ostream& anOstream, std::string const& options)
 void
 PeriodicMeasurement ::format(std::ostream& anOstream, std::string const& aField, std::string const& options)
 {
+    if (!theCancelled) { liveStats().cut(); }
     stat_handle_map::iterator iter = theStats.find(aField);
     if (iter != theStats.end()) {
         iter->second.print(anOstream, options);
@@ -944,6 +1005,7 @@ void
 PeriodicMeasurement ::fire()
 {
     if (!theCancelled) {
+        liveStats().cut();
         stat_handle_map::iterator iter = theStats.begin();
         stat_handle_map::iterator end  = theStats.end();
         while (iter != end) {
@@ -977,27 +1039,45 @@ LoggedPeriodicMeasurement::LoggedPeriodicMeasurement(std::string const& aName,
     }
 }
 
+LoggedPeriodicMeasurement::~LoggedPeriodicMeasurement()
+{
+    liveStats().unsubscribe(this);
+}
+
 void
 LoggedPeriodicMeasurement ::addToMeasurement(Stat* aStat)
 {
     // Check if the stat should be included in this measurement
-    if (includeStat(aStat)) { theStats[aStat->name()] = aStat->createValue(); }
+    if (includeStat(aStat)) {
+        StatValueHandle& handle = theStats[aStat->name()];
+        handle                  = aStat->createValue();
+        handle.releaseUpdater();
+        theSources.push_back(aStat);
+        liveStats().subscribe(aStat, this, [&handle](StatValueBase const& aSegment) {
+            handle.getValue()->reduceSum(aSegment);
+        });
+    }
 }
 
 void
 LoggedPeriodicMeasurement ::close()
 {
-    theCancelled                   = true;
-    stat_handle_map::iterator iter = theStats.begin();
-    stat_handle_map::iterator end  = theStats.end();
-    while (iter != end) {
-        iter->second.releaseUpdater();
-        ++iter;
+    if (!theCancelled) {
+        liveStats().cut();
+        liveStats().unsubscribe(this);
     }
+    theCancelled = true;
 }
 
 void
 LoggedPeriodicMeasurement ::print(std::ostream& anOstream, std::string const& options)
+{
+    if (!theCancelled) { liveStats().cut(); }
+    printRow(anOstream);
+}
+
+void
+LoggedPeriodicMeasurement ::printRow(std::ostream& anOstream)
 {
     stat_handle_map::iterator iter = theStats.begin();
     stat_handle_map::iterator end  = theStats.end();
@@ -1013,6 +1093,7 @@ LoggedPeriodicMeasurement ::print(std::ostream& anOstream, std::string const& op
 void
 LoggedPeriodicMeasurement ::format(std::ostream& anOstream, std::string const& aField, std::string const& options)
 {
+    if (!theCancelled) { liveStats().cut(); }
     stat_handle_map::iterator iter = theStats.find(aField);
     if (iter != theStats.end()) {
         iter->second.print(anOstream, options);
@@ -1037,18 +1118,17 @@ LoggedPeriodicMeasurement ::fire()
             theFirst = false;
         }
 
-        print(theOstream);
+        liveStats().cut();
+        printRow(theOstream);
         theOstream.flush();
 
         if (theAccumulationType == accumulation_type::Reset) {
-            for (auto& aStat : theStats)
-                aStat.second.reset();
-            // stat_handle_map::iterator iter = theStats.begin();
-            // stat_handle_map::iterator end = theStats.end();
-            // while (iter != end) {
-            //   iter->second.reset();
-            //   ++iter;
-            // }
+            // The handles have no updater to reset through; start each from
+            // a fresh value instead
+            for (auto* aStat : theSources) {
+                StatValueHandle fresh = aStat->createValue();
+                theStats[aStat->name()].setValue(fresh.getValue());
+            }
         }
 
         getStatManager()->addEvent(getStatManager()->ticks() + thePeriod, [this]() {
@@ -227,6 +227,11 @@ StatValueArrayHandle::newValue(accumulation_type aType)
     theValue->newValue(aType);
 }
 void
+StatValueArrayHandle::mergeCurrent(StatValueBase const& aSegment)
+{
+    (*theValue)[theValue->size() - 1].reduceSum(aSegment);
+}
+void
 StatValueArrayHandle::print(std::ostream& anOstream, std::string const& options)
 {
     if (theValue) {
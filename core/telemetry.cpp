@@ -0,0 +1,271 @@
+#include <core/debug/debug.hpp>
+#include <core/telemetry.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Flexus {
+namespace Core {
+
+bool Telemetry::theTiming = false;
+
+namespace {
+
+struct Totals
+{
+    std::string thePhase;
+    uint64_t theCycles       = 0;
+    uint64_t theInstructions = 0;
+    int64_t theHostNs        = 0;
+};
+
+struct State
+{
+    uint64_t theInterval;
+    std::ofstream theLog;
+
+    std::vector<uint64_t> theCommitted;
+    std::vector<uint64_t> theCommittedAtSample;
+    std::vector<std::string> theDriveNames;
+    std::vector<int64_t> theDriveNs;
+
+    // Rows wait for the drives to register, so that the header has their
+    // share columns
+    bool theHeaderWritten = false;
+    std::vector<std::string> thePendingRows;
+
+    // Start of the current interval
+    uint64_t theSampleCycle = 0;
+    int64_t theSampleTime   = 0;
+    uint64_t theNextSample  = 0;
+    int64_t theStartTime    = 0;
+
+    // Per phase, in the order the phases first started
+    std::vector<Totals> thePhases;
+    std::size_t theCurrentPhase = 0;
+    std::string theLastRow;
+};
+
+// Never torn down: the log is flushed row by row
+State* theState = nullptr;
+
+// Writes the header and the rows taken before it, whose drive shares are
+// left empty
+void
+writeHeader(State& s)
+{
+    s.theHeaderWritten = true;
+    if (!s.theLog.is_open()) return;
+
+    s.theLog << "cycle,host_s,phase,cycles,ns_per_cycle,kips";
+    for (index_t i = 0; i < s.theCommitted.size(); ++i) {
+        s.theLog << ",kips_c" << i;
+    }
+    for (auto const& name : s.theDriveNames) {
+        s.theLog << ",share_" << name;
+    }
+    s.theLog << '\n';
+    for (auto const& row : s.thePendingRows) {
+        s.theLog << row << std::string(s.theDriveNames.size(), ',') << '\n';
+    }
+    s.theLog.flush();
+    s.thePendingRows.clear();
+}
+
+// Closes the interval ending at aCycle
+void
+sample(State& s, uint64_t aCycle)
+{
+    int64_t now           = Telemetry::now();
+    int64_t ns            = now - s.theSampleTime;
+    uint64_t cycles       = aCycle - s.theSampleCycle;
+    uint64_t instructions = 0;
+    for (index_t i = 0; i < s.theCommitted.size(); ++i) {
+        instructions += s.theCommitted[i] - s.theCommittedAtSample[i];
+    }
+    int64_t drive_ns = 0;
+    for (int64_t d : s.theDriveNs) {
+        drive_ns += d;
+    }
+
+    Totals& phase = s.thePhases[s.theCurrentPhase];
+    phase.theCycles += cycles;
+    phase.theInstructions += instructions;
+    phase.theHostNs += ns;
+
+    // instructions per ns * 1e6 = thousands of instructions per second
+    auto kips = [ns](uint64_t anInstructions) { return ns > 0 ? anInstructions * 1e6 / ns : 0.0; };
+
+    std::ostringstream row;
+    row << std::fixed << std::setprecision(3) << aCycle << ',' << (now - s.theStartTime) / 1e9 << ','
+        << phase.thePhase << ',' << cycles << ',' << (cycles ? double(ns) / cycles : 0.0) << ',' << kips(instructions);
+    for (index_t i = 0; i < s.theCommitted.size(); ++i) {
+        row << ',' << kips(s.theCommitted[i] - s.theCommittedAtSample[i]);
+        s.theCommittedAtSample[i] = s.theCommitted[i];
+    }
+    for (int64_t& d : s.theDriveNs) {
+        row << ',' << (drive_ns ? 100.0 * d / drive_ns : 0.0);
+        d = 0;
+    }
+    s.theLastRow = row.str();
+    if (!s.theHeaderWritten) {
+        s.thePendingRows.push_back(s.theLastRow);
+    } else if (s.theLog.is_open()) {
+        s.theLog << s.theLastRow << std::endl;
+    }
+
+    s.theSampleCycle = aCycle;
+    s.theSampleTime  = now;
+    s.theNextSample  = aCycle + s.theInterval;
+}
+
+} // namespace
+
+void
+Telemetry::configure(index_t aCoreCount)
+{
+    if (theState != nullptr) return;
+
+    char const* spec = getenv("FLEXUS_TELEMETRY");
+    if (spec == nullptr) return;
+
+    uint64_t interval = 100000;
+    std::string file("telemetry.csv");
+    std::string args(spec);
+    std::size_t sep = args.find(',');
+    if (sep != 0 && !args.empty()) interval = std::strtoull(args.c_str(), nullptr, 10);
+    if (sep != std::string::npos) file = args.substr(sep + 1);
+    if (interval == 0) return;
+
+    theState                = new State;
+    theState->theInterval   = interval;
+    theState->theNextSample = interval;
+    theState->theCommitted.assign(aCoreCount, 0);
+    theState->theCommittedAtSample.assign(aCoreCount, 0);
+    theState->theStartTime  = now();
+    theState->theSampleTime = theState->theStartTime;
+    theState->thePhases.push_back(Totals());
+    theState->thePhases.back().thePhase = "init";
+
+    theState->theLog.open(file.c_str());
+    if (!theState->theLog) {
+        DBG_(Crit, (<< "FLEXUS_TELEMETRY: cannot open " << file << ", telemetry is only kept in memory"));
+    }
+    DBG_(Dev, (<< "Telemetry: one sample every " << interval << " cycles into " << file));
+}
+
+bool
+Telemetry::enabled()
+{
+    return theState != nullptr;
+}
+
+void
+Telemetry::committed(index_t aCore)
+{
+    if (theState && aCore < theState->theCommitted.size()) ++theState->theCommitted[aCore];
+}
+
+void
+Telemetry::registerDrives(std::vector<std::string> const& aNames)
+{
+    if (!theState || theState->theHeaderWritten) return;
+    theState->theDriveNames = aNames;
+    theState->theDriveNs.assign(aNames.size(), 0);
+    writeHeader(*theState);
+}
+
+int64_t
+Telemetry::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void
+Telemetry::timed(index_t aDrive, int64_t aStart)
+{
+    theState->theDriveNs[aDrive] += now() - aStart;
+}
+
+void
+Telemetry::cycle(uint64_t aCycle)
+{
+    if (!theState) return;
+    theTiming = !theState->theDriveNs.empty() && (aCycle % kTimedCycleRatio) == 0;
+    if (aCycle >= theState->theNextSample) sample(*theState, aCycle);
+}
+
+void
+Telemetry::mark(std::string const& aPhase, uint64_t aCycle)
+{
+    if (!theState) return;
+    State& s = *theState;
+    sample(s, aCycle);
+
+    s.theCurrentPhase = 0;
+    while (s.theCurrentPhase < s.thePhases.size() && s.thePhases[s.theCurrentPhase].thePhase != aPhase) {
+        ++s.theCurrentPhase;
+    }
+    if (s.theCurrentPhase == s.thePhases.size()) {
+        s.thePhases.push_back(Totals());
+        s.thePhases.back().thePhase = aPhase;
+    }
+    DBG_(Dev, (<< "Telemetry: phase " << aPhase << " starts at cycle " << aCycle));
+}
+
+std::string const&
+Telemetry::phase()
+{
+    static const std::string none;
+    return theState ? theState->thePhases[theState->theCurrentPhase].thePhase : none;
+}
+
+void
+Telemetry::finish(uint64_t aCycle)
+{
+    if (!theState) return;
+    if (aCycle > theState->theSampleCycle) sample(*theState, aCycle);
+    if (!theState->theHeaderWritten) writeHeader(*theState);
+}
+
+void
+Telemetry::report(std::ostream& anOstream)
+{
+    if (!theState) {
+        anOstream << "Telemetry is disabled" << std::endl;
+        return;
+    }
+    State& s = *theState;
+
+    Totals all;
+    for (auto const& p : s.thePhases) {
+        all.theCycles += p.theCycles;
+        all.theInstructions += p.theInstructions;
+        all.theHostNs += p.theHostNs;
+    }
+    auto line = [&](std::string const& aName, Totals const& t) {
+        anOstream << std::setw(16) << std::left << aName << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << t.theHostNs / 1e9 << " s " << std::setw(14) << t.theCycles << " cycles "
+                  << std::setw(16) << t.theInstructions << " insns " << std::setw(12)
+                  << (t.theHostNs ? t.theInstructions * 1e6 / t.theHostNs : 0.0) << " KIPS " << std::setw(10)
+                  << (t.theCycles ? double(t.theHostNs) / t.theCycles : 0.0) << " ns/cycle" << std::endl;
+    };
+
+    anOstream << "Telemetry up to cycle " << s.theSampleCycle << std::endl;
+    line("all", all);
+    for (auto const& p : s.thePhases) {
+        line("  " + p.thePhase, p);
+    }
+    for (index_t i = 0; i < s.theCommitted.size(); ++i) {
+        anOstream << "  core " << i << ": " << s.theCommittedAtSample[i] << " insns, "
+                  << (all.theHostNs ? s.theCommittedAtSample[i] * 1e6 / all.theHostNs : 0.0) << " KIPS" << std::endl;
+    }
+    if (!s.theLastRow.empty()) anOstream << "Last interval: " << s.theLastRow << std::endl;
+}
+
+} // namespace Core
+} // namespace Flexus
@@ -0,0 +1,76 @@
+#ifndef FLEXUS_CORE_TELEMETRY_HPP_INCLUDED
+#define FLEXUS_CORE_TELEMETRY_HPP_INCLUDED
+
+#include <core/types.hpp>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Simulation throughput telemetry.
+ *
+ * Every interval of simulated cycles one CSV row is appended to the telemetry
+ * log with the host time, the host ns per simulated cycle, the committed
+ * instructions per host second (KIPS) overall and per core, and the share of
+ * the drive time taken by each drive. Drive times are measured on one cycle
+ * in kTimedCycleRatio only, so that timing costs nothing measurable.
+ *
+ * Rows carry the phase they were taken in. mark() closes the current
+ * interval early and starts a new phase, so that checkpoint loads and saves
+ * show up as their own rows instead of as a slow interval.
+ *
+ * The log is selected at startup with the FLEXUS_TELEMETRY environment
+ * variable:
+ *
+ *    FLEXUS_TELEMETRY=<cycles>[,<file>]
+ *
+ * Telemetry is off unless the variable is set. The interval defaults to
+ * 100000 cycles when it is left empty, and the file to telemetry.csv; 0
+ * turns it off.
+ */
+class Telemetry
+{
+  public:
+    static const uint64_t kTimedCycleRatio = 64;
+
+    // Reads FLEXUS_TELEMETRY and sizes the per-core counters.
+    static void configure(index_t aCoreCount);
+    static bool enabled();
+
+    // One instruction committed by aCore
+    static void committed(index_t aCore);
+
+    // Names of the drive slots passed to timed(), in slot order. Rows taken
+    // before the drives register are held back and get empty shares.
+    static void registerDrives(std::vector<std::string> const& aNames);
+
+    // Whether the drives of the current cycle are being timed.
+    static bool timing() { return theTiming; }
+    static int64_t now();
+    static void timed(index_t aDrive, int64_t aStart);
+
+    // Called once the drives of a cycle ran; writes a row at interval ends.
+    static void cycle(uint64_t aCycle);
+
+    // Ends the current phase at aCycle and starts aPhase.
+    static void mark(std::string const& aPhase, uint64_t aCycle);
+    static std::string const& phase();
+
+    // Closes the last interval at the end of the simulation.
+    static void finish(uint64_t aCycle);
+
+    // Totals up to the last row, overall and per phase, and that row.
+    static void report(std::ostream& anOstream);
+
+  private:
+    static bool theTiming;
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CORE_TELEMETRY_HPP_INCLUDED
@@ -0,0 +1,158 @@
+#include <core/boost_extensions/intrusive_ptr.hpp>
+#include <core/debug/debug.hpp>
+#include <core/performance/profile.hpp>
+#include <core/port_recorder.hpp>
+#include <core/uncore_pool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace Flexus {
+namespace Core {
+
+namespace {
+
+// Uncore drives come back every cycle, so an idle worker polls this many
+// times for the next batch before it goes to sleep. It yields between polls
+// so that an oversubscribed host still gets to run the simulation thread.
+const int kSpins = 1 << 10;
+
+struct Pool
+{
+    index_t theWorkers;
+
+    std::mutex theLock;
+    std::condition_variable theWakeup;
+
+    // A batch is published by bumping theGeneration; theTask and theCount
+    // are written before it and only read after it.
+    std::atomic<uint64_t> theGeneration{ 0 };
+    void (*theTask)(index_t) = nullptr;
+    index_t theCount         = 0;
+    std::atomic<index_t> theNext{ 0 };
+
+    // Workers done with the current batch. run() waits for all of them, so
+    // no worker can still be reaching for a task when the next batch starts.
+    std::atomic<index_t> theCheckedIn{ 0 };
+
+    void drain()
+    {
+        nProfile::theProfileSuspended = true;
+        for (index_t i = theNext.fetch_add(1); i < theCount; i = theNext.fetch_add(1)) {
+            theTask(i);
+        }
+        nProfile::theProfileSuspended = false;
+    }
+
+    void work()
+    {
+        uint64_t seen = 0;
+        while (true) {
+            for (int32_t i = 0; i < kSpins && theGeneration.load(std::memory_order_acquire) == seen; ++i) {
+                std::this_thread::yield();
+            }
+            if (theGeneration.load(std::memory_order_acquire) == seen) {
+                std::unique_lock<std::mutex> lock(theLock);
+                theWakeup.wait(lock, [&] { return theGeneration.load(std::memory_order_acquire) != seen; });
+            }
+            seen = theGeneration.load(std::memory_order_acquire);
+            drain();
+            theCheckedIn.fetch_add(1, std::memory_order_release);
+        }
+    }
+};
+
+// Never torn down: the workers live as long as the simulator
+Pool* thePool = nullptr;
+
+// Numbers drawn outside of any element, and the sequence of the element
+// being driven on this thread. Sequence i starts at i << kSerialBits.
+const int32_t kSerialBits = 40;
+uint64_t theSharedSerials[UncorePool::kSerials];
+uint64_t theSequences                          = 0;
+thread_local UncorePool::SerialSequence* theSequence = nullptr;
+
+} // namespace
+
+void
+UncorePool::configure()
+{
+    char const* spec = getenv("FLEXUS_UNCORE_THREADS");
+    if (spec == nullptr || thePool != nullptr) return;
+
+    index_t threads = std::strtoul(spec, nullptr, 10);
+    if (threads <= 1) return;
+    if (PortRecorder::recorder().recording()) {
+        DBG_(Crit, (<< "FLEXUS_UNCORE_THREADS is ignored while ports are recorded (FLEXUS_RECORD)"));
+        return;
+    }
+
+    // Before any worker runs: transports and their slices may now be
+    // referenced from several threads
+    boost::counted_base::theThreadShared = true;
+
+    thePool             = new Pool;
+    thePool->theWorkers = threads - 1;
+    for (index_t i = 0; i < thePool->theWorkers; ++i) {
+        std::thread([] { thePool->work(); }).detach();
+    }
+
+    DBG_(Dev, (<< "Uncore pool: independent uncore drives run on " << threads << " threads"));
+}
+
+bool
+UncorePool::enabled()
+{
+    return thePool != nullptr;
+}
+
+void
+UncorePool::run(index_t aCount, void (*aTask)(index_t))
+{
+    Pool& pool    = *thePool;
+    pool.theTask  = aTask;
+    pool.theCount = aCount;
+    pool.theNext.store(0, std::memory_order_relaxed);
+    pool.theCheckedIn.store(0, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(pool.theLock);
+        pool.theGeneration.fetch_add(1, std::memory_order_release);
+    }
+    pool.theWakeup.notify_all();
+
+    pool.drain();
+    while (pool.theCheckedIn.load(std::memory_order_acquire) != pool.theWorkers) {
+        std::this_thread::yield();
+    }
+}
+
+UncorePool::SerialSequence::SerialSequence()
+{
+    ++theSequences;
+    for (int32_t i = 0; i < kSerials; ++i) {
+        theNext[i] = theSequences << kSerialBits;
+    }
+}
+
+UncorePool::SerialScope::SerialScope(SerialSequence& aSequence)
+  : thePrevious(theSequence)
+{
+    theSequence = &aSequence;
+}
+
+UncorePool::SerialScope::~SerialScope()
+{
+    theSequence = thePrevious;
+}
+
+uint64_t
+UncorePool::nextSerial(eSerial aKind)
+{
+    return theSequence ? ++theSequence->theNext[aKind] : ++theSharedSerials[aKind];
+}
+
+} // namespace Core
+} // namespace Flexus
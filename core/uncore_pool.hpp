@@ -0,0 +1,81 @@
+#ifndef FLEXUS_CORE_UNCORE_POOL_HPP_INCLUDED
+#define FLEXUS_CORE_UNCORE_POOL_HPP_INCLUDED
+
+#include <core/types.hpp>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Worker threads for the independent uncore drives.
+ *
+ * The elements of a component array declared with INDEPENDENT_DRIVE (the L2
+ * banks) only interact through the network, between cycles. When the pool is
+ * enabled, do_cycle_uncore drives all of them concurrently, then commits their
+ * outbound messages one element at a time in index order, so that the
+ * downstream components see what a run without the pool shows them.
+ *
+ * What the drives share is made safe for that:
+ *
+ *  - the objects they create are numbered from a sequence of the element
+ *    being driven (see nextSerial()), with or without the pool, so that the
+ *    numbers do not depend on the threads or the order the elements run in
+ *  - reference counts are atomic once the pool is started
+ *  - profiler sites are not timed while a thread runs pool tasks
+ *  - the pool is not started while ports are recorded, since the recorder
+ *    keeps one buffer and one file
+ *
+ * The pool is selected at startup with the FLEXUS_UNCORE_THREADS environment
+ * variable, the number of threads driving an array including the simulation
+ * thread itself. Unset, 0 or 1 keeps every drive serial.
+ */
+class UncorePool
+{
+  public:
+    // Reads FLEXUS_UNCORE_THREADS and starts the workers.
+    static void configure();
+    static bool enabled();
+
+    // Calls aTask(i) for every i < aCount, spread over the workers and the
+    // calling thread, and returns once all calls have finished.
+    static void run(index_t aCount, void (*aTask)(index_t));
+
+    enum eSerial
+    {
+        kMessageSerial,
+        kTrackerSerial,
+        kSerials
+    };
+
+    // The numbers of one independent element, made current on the thread
+    // that drives it by a SerialScope. Each sequence has its own range, so
+    // numbers stay unique across elements.
+    class SerialSequence
+    {
+        uint64_t theNext[kSerials];
+        friend class UncorePool;
+
+      public:
+        SerialSequence();
+    };
+
+    class SerialScope
+    {
+        SerialSequence* thePrevious;
+
+      public:
+        explicit SerialScope(SerialSequence& aSequence);
+        ~SerialScope();
+        SerialScope(SerialScope const&)            = delete;
+        SerialScope& operator=(SerialScope const&) = delete;
+    };
+
+    // Next number of kind aKind: from the sequence of the element being
+    // driven on this thread, or else from the simulation thread's
+    static uint64_t nextSerial(eSerial aKind);
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CORE_UNCORE_POOL_HPP_INCLUDED
@@ -0,0 +1,143 @@
+#include <core/debug/debug.hpp>
+#include <core/warming.hpp>
+
+#include <vector>
+
+namespace Flexus {
+namespace Core {
+
+namespace {
+
+struct State
+{
+    std::vector<std::vector<Warming::Observer*>> theObservers;
+    std::vector<Warming::PrivateCache*> thePrivate;
+    std::vector<Warming::SharedCache*> theShared;
+    std::function<index_t(uint64_t)> theHome;
+
+    uint64_t theReferences = 0;
+    uint64_t theMisses     = 0;
+};
+
+State&
+state()
+{
+    static State theState;
+    return theState;
+}
+
+template<typename T>
+void
+place(std::vector<T*>& aVector, size_t anIndex, T* anEntry)
+{
+    if (aVector.size() <= anIndex) aVector.resize(anIndex + 1, nullptr);
+    aVector[anIndex] = anEntry;
+}
+
+Warming::PrivateCache*
+privateCache(int32_t aSharer)
+{
+    State& s = state();
+    return size_t(aSharer) < s.thePrivate.size() ? s.thePrivate[aSharer] : nullptr;
+}
+
+Warming::SharedCache*
+home(uint64_t anAddress)
+{
+    State& s = state();
+    if (!s.theHome) return s.theShared.size() == 1 ? s.theShared[0] : nullptr;
+    index_t bank = s.theHome(anAddress);
+    return bank < s.theShared.size() ? s.theShared[bank] : nullptr;
+}
+
+} // namespace
+
+void
+Warming::observe(index_t aCore, Observer* anObserver)
+{
+    State& s = state();
+    if (s.theObservers.size() <= aCore) s.theObservers.resize(aCore + 1);
+    s.theObservers[aCore].push_back(anObserver);
+}
+
+void
+Warming::attachPrivate(int32_t aSharer, PrivateCache* aCache)
+{
+    DBG_Assert(aSharer >= 0);
+    place(state().thePrivate, aSharer, aCache);
+}
+
+void
+Warming::attachShared(index_t aBank, SharedCache* aCache)
+{
+    place(state().theShared, aBank, aCache);
+}
+
+void
+Warming::setHome(std::function<index_t(uint64_t)> aHome)
+{
+    state().theHome = std::move(aHome);
+}
+
+void
+Warming::reference(Reference const& aReference)
+{
+    State& s = state();
+    ++s.theReferences;
+
+    if (aReference.theCore < s.theObservers.size()) {
+        for (Observer* observer : s.theObservers[aReference.theCore]) {
+            observer->warm(aReference);
+        }
+    }
+
+    int32_t requester   = sharer(aReference.theCore, aReference.theAccess == kFetch);
+    PrivateCache* cache = privateCache(requester);
+    if (cache == nullptr || cache->warmHit(aReference.thePhysical, aReference.theAccess)) return;
+    ++s.theMisses;
+
+    eGrant grant;
+    if (SharedCache* shared = home(aReference.thePhysical)) {
+        grant = shared->warmRequest(requester, aReference.thePhysical, aReference.theAccess);
+    } else {
+        switch (aReference.theAccess) {
+            case kFetch: grant = kShared; break;
+            case kLoad: grant = kExclusive; break;
+            default: grant = kModified; break;
+        }
+    }
+    if (grant == kNone) return;
+
+    std::pair<eGrant, uint64_t> victim = cache->warmFill(aReference.thePhysical, grant);
+    if (victim.first == kNone) return;
+    if (SharedCache* shared = home(victim.second)) shared->warmEvict(requester, victim.second, victim.first);
+}
+
+Warming::eGrant
+Warming::invalidate(int32_t aSharer, uint64_t anAddress)
+{
+    PrivateCache* cache = privateCache(aSharer);
+    return cache ? cache->warmInvalidate(anAddress) : kNone;
+}
+
+Warming::eGrant
+Warming::downgrade(int32_t aSharer, uint64_t anAddress)
+{
+    PrivateCache* cache = privateCache(aSharer);
+    return cache ? cache->warmDowngrade(anAddress) : kNone;
+}
+
+uint64_t
+Warming::references()
+{
+    return state().theReferences;
+}
+
+uint64_t
+Warming::misses()
+{
+    return state().theMisses;
+}
+
+} // namespace Core
+} // namespace Flexus
@@ -0,0 +1,123 @@
+#ifndef FLEXUS_CORE_WARMING_HPP_INCLUDED
+#define FLEXUS_CORE_WARMING_HPP_INCLUDED
+
+#include <core/types.hpp>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace Flexus {
+namespace Core {
+
+/*
+ * Functional warming of the caches, TLBs and branch predictors while QEMU
+ * fast-forwards (see Sampling).
+ *
+ * QEMU reports every instruction fetch, load and store it executes through
+ * FLEXUS_trace_mem. While Sampling::warming() is set, each one becomes a
+ * Reference handed to reference(), which updates the components in place,
+ * with no message, no timing and no statistic:
+ *
+ *  - the observers of the core (TLBs, branch predictor) see every reference
+ *  - the private cache of the core (L1i for a fetch, L1d otherwise) is
+ *    looked up; on a miss, or a store without write permission, the home
+ *    bank of the shared cache grants a state the way its protocol would,
+ *    invalidating or downgrading the other private caches, and the block is
+ *    filled, its victim being evicted to its own home bank
+ *
+ * The components attach themselves when they are initialized. A private
+ * cache is known by its sharer number in the directory, twice the core index
+ * for the L1d and one more for the L1i, as SplitDestinationMapper numbers
+ * them. A core without a shared cache gets the state it asks for.
+ */
+class Warming
+{
+  public:
+    enum eAccess
+    {
+        kFetch,
+        kLoad,
+        kStore
+    };
+
+    // State of a block in a private cache, from the shared cache's view
+    enum eGrant
+    {
+        kNone,
+        kShared,
+        kExclusive,
+        kModified
+    };
+
+    struct Reference
+    {
+        index_t theCore;
+        eAccess theAccess;
+        uint64_t thePC;
+        uint64_t theVirtual;
+        uint64_t thePhysical;
+        // The QEMU branch type of a fetch (QEMU_Non_Branch otherwise)
+        uint32_t theBranchType;
+    };
+
+    class Observer
+    {
+      public:
+        virtual ~Observer() {}
+        virtual void warm(Reference const& aReference) = 0;
+    };
+
+    class PrivateCache
+    {
+      public:
+        virtual ~PrivateCache() {}
+
+        // True when the block is present with enough permission for
+        // anAccess; the access is recorded, and a store makes it modified.
+        virtual bool warmHit(uint64_t anAddress, eAccess anAccess) = 0;
+
+        // Fills the block in aGrant, and returns the victim with what its
+        // eviction tells the shared cache (kNone when nothing is sent)
+        virtual std::pair<eGrant, uint64_t> warmFill(uint64_t anAddress, eGrant aGrant) = 0;
+
+        // Snoops from the shared cache, returning the state the block was in
+        virtual eGrant warmInvalidate(uint64_t anAddress) = 0;
+        virtual eGrant warmDowngrade(uint64_t anAddress)  = 0;
+    };
+
+    class SharedCache
+    {
+      public:
+        virtual ~SharedCache() {}
+
+        // The state aSharer gets for anAccess, after the other sharers were
+        // snooped through Warming::invalidate() and Warming::downgrade()
+        virtual eGrant warmRequest(int32_t aSharer, uint64_t anAddress, eAccess anAccess) = 0;
+
+        // aSharer dropped the block; aGrant is what its eviction carries
+        virtual void warmEvict(int32_t aSharer, uint64_t anAddress, eGrant aGrant) = 0;
+    };
+
+    static int32_t sharer(index_t aCore, bool anInstruction) { return (aCore << 1) + (anInstruction ? 1 : 0); }
+
+    static void observe(index_t aCore, Observer* anObserver);
+    static void attachPrivate(int32_t aSharer, PrivateCache* aCache);
+    static void attachShared(index_t aBank, SharedCache* aCache);
+    // The bank of the shared cache a physical address belongs to
+    static void setHome(std::function<index_t(uint64_t)> aHome);
+
+    static void reference(Reference const& aReference);
+
+    // Snoops a private cache on behalf of the shared cache
+    static eGrant invalidate(int32_t aSharer, uint64_t anAddress);
+    static eGrant downgrade(int32_t aSharer, uint64_t anAddress);
+
+    // References warmed so far, and those that missed the private cache
+    static uint64_t references();
+    static uint64_t misses();
+};
+
+} // namespace Core
+} // namespace Flexus
+
+#endif // FLEXUS_CORE_WARMING_HPP_INCLUDED
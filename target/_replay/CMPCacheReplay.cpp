@@ -0,0 +1,73 @@
+// Replay layout for the CMPCache component: instantiates a single, unwired
+// CMPCache and replays recorded port traffic into it (see core/port_replay.hpp).
+#define FLEXUS_WIRING_FILE
+#include <core/simulator_layout.hpp>
+
+#include <core/simulator_name.hpp>
+namespace Flexus {
+std::string theSimulatorName = "CMPCacheReplay v1.0";
+}
+
+#include FLEXUS_BEGIN_DECLARATION_SECTION()
+
+#include <components/CMPCache/CMPCache.hpp>
+
+#include <components/CommonQEMU/PortCodecs.hpp>
+
+#include FLEXUS_END_DECLARATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_CONFIGURATION_SECTION()
+
+CREATE_CONFIGURATION(CMPCache, "L2", theL2Cfg);
+
+// Parameters come from the configuration of the recorded run (-cfg) and the
+// command line, so anything left unset keeps its default.
+bool initializeParameters() {
+  return false;
+}
+
+#include FLEXUS_END_COMPONENT_CONFIGURATION_SECTION()
+
+// clang-format off
+#include FLEXUS_BEGIN_COMPONENT_INSTANTIATION_SECTION()
+
+FLEXUS_INSTANTIATE_COMPONENT_ARRAY( CMPCache, theL2Cfg, theL2, SCALE_WITH_SYSTEM_WIDTH, DIVIDE, 1 );
+
+#include FLEXUS_END_COMPONENT_INSTANTIATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_WIRING_SECTION()
+
+// Outputs are left unwired: whatever the replayed component sends is dropped
+
+#include FLEXUS_END_COMPONENT_WIRING_SECTION()
+
+#include FLEXUS_BEGIN_DRIVE_ORDER_SECTION()
+
+  mpl::vector < >
+,  mpl::vector <
+  DRIVE( theL2, CMPCacheDrive ) >
+
+#include FLEXUS_END_DRIVE_ORDER_SECTION()
+// clang-format on
+
+#include <core/port_replay.hpp>
+
+namespace Flexus {
+namespace Wiring {
+
+void
+registerReplayPorts(Flexus::Core::ReplayPorts& aPorts)
+{
+    REPLAY_PORT(theL2, Request_In)
+    REPLAY_PORT(theL2, Snoop_In)
+    REPLAY_PORT(theL2, Reply_In)
+}
+
+} // namespace Wiring
+} // namespace Flexus
+
+int
+main(int argc, char** argv)
+{
+    return Flexus::Core::runReplay(argc, argv, &Flexus::Wiring::registerReplayPorts);
+}
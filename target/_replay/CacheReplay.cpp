@@ -0,0 +1,75 @@
+// Replay layout for the Cache component: instantiates a single, unwired
+// Cache and replays recorded port traffic into it (see core/port_replay.hpp).
+#define FLEXUS_WIRING_FILE
+#include <core/simulator_layout.hpp>
+
+#include <core/simulator_name.hpp>
+namespace Flexus {
+std::string theSimulatorName = "CacheReplay v1.0";
+}
+
+#include FLEXUS_BEGIN_DECLARATION_SECTION()
+
+#include <components/Cache/Cache.hpp>
+
+#include <components/CommonQEMU/PortCodecs.hpp>
+
+#include FLEXUS_END_DECLARATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_CONFIGURATION_SECTION()
+
+CREATE_CONFIGURATION(Cache, "L1d", theL1dCfg);
+
+// Parameters come from the configuration of the recorded run (-cfg) and the
+// command line, so anything left unset keeps its default.
+bool initializeParameters() {
+  return false;
+}
+
+#include FLEXUS_END_COMPONENT_CONFIGURATION_SECTION()
+
+// clang-format off
+#include FLEXUS_BEGIN_COMPONENT_INSTANTIATION_SECTION()
+
+FLEXUS_INSTANTIATE_COMPONENT_ARRAY( Cache, theL1dCfg, theL1d, SCALE_WITH_SYSTEM_WIDTH, MULTIPLY, 1);
+
+#include FLEXUS_END_COMPONENT_INSTANTIATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_WIRING_SECTION()
+
+// Outputs are left unwired: whatever the replayed component sends is dropped
+
+#include FLEXUS_END_COMPONENT_WIRING_SECTION()
+
+#include FLEXUS_BEGIN_DRIVE_ORDER_SECTION()
+
+  mpl::vector <
+  DRIVE( theL1d, CacheDrive ) >
+,  mpl::vector < >
+
+#include FLEXUS_END_DRIVE_ORDER_SECTION()
+// clang-format on
+
+#include <core/port_replay.hpp>
+
+namespace Flexus {
+namespace Wiring {
+
+void
+registerReplayPorts(Flexus::Core::ReplayPorts& aPorts)
+{
+    REPLAY_PORT(theL1d, FrontSideIn_Snoop)
+    REPLAY_PORT(theL1d, FrontSideIn_Request)
+    REPLAY_PORT(theL1d, FrontSideIn_Prefetch)
+    REPLAY_PORT(theL1d, BackSideIn_Request)
+    REPLAY_PORT(theL1d, BackSideIn_Reply)
+}
+
+} // namespace Wiring
+} // namespace Flexus
+
+int
+main(int argc, char** argv)
+{
+    return Flexus::Core::runReplay(argc, argv, &Flexus::Wiring::registerReplayPorts);
+}
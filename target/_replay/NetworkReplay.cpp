@@ -0,0 +1,71 @@
+// Replay layout for the MemoryNetwork component: instantiates a single, unwired
+// MemoryNetwork and replays recorded port traffic into it (see core/port_replay.hpp).
+#define FLEXUS_WIRING_FILE
+#include <core/simulator_layout.hpp>
+
+#include <core/simulator_name.hpp>
+namespace Flexus {
+std::string theSimulatorName = "NetworkReplay v1.0";
+}
+
+#include FLEXUS_BEGIN_DECLARATION_SECTION()
+
+#include <components/NetShim/MemoryNetwork.hpp>
+
+#include <components/CommonQEMU/PortCodecs.hpp>
+
+#include FLEXUS_END_DECLARATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_CONFIGURATION_SECTION()
+
+CREATE_CONFIGURATION(MemoryNetwork, "network", theNetworkCfg);
+
+// Parameters come from the configuration of the recorded run (-cfg) and the
+// command line, so anything left unset keeps its default.
+bool initializeParameters() {
+  return false;
+}
+
+#include FLEXUS_END_COMPONENT_CONFIGURATION_SECTION()
+
+// clang-format off
+#include FLEXUS_BEGIN_COMPONENT_INSTANTIATION_SECTION()
+
+FLEXUS_INSTANTIATE_COMPONENT( MemoryNetwork, theNetworkCfg, theNetwork );
+
+#include FLEXUS_END_COMPONENT_INSTANTIATION_SECTION()
+
+#include FLEXUS_BEGIN_COMPONENT_WIRING_SECTION()
+
+// Outputs are left unwired: whatever the replayed component sends is dropped
+
+#include FLEXUS_END_COMPONENT_WIRING_SECTION()
+
+#include FLEXUS_BEGIN_DRIVE_ORDER_SECTION()
+
+  mpl::vector < >
+,  mpl::vector <
+  DRIVE( theNetwork, NetworkDrive ) >
+
+#include FLEXUS_END_DRIVE_ORDER_SECTION()
+// clang-format on
+
+#include <core/port_replay.hpp>
+
+namespace Flexus {
+namespace Wiring {
+
+void
+registerReplayPorts(Flexus::Core::ReplayPorts& aPorts)
+{
+    REPLAY_PORT(theNetwork, FromNode)
+}
+
+} // namespace Wiring
+} // namespace Flexus
+
+int
+main(int argc, char** argv)
+{
+    return Flexus::Core::runReplay(argc, argv, &Flexus::Wiring::registerReplayPorts);
+}
@@ -25,6 +25,8 @@ std::string theSimulatorName = "SemiKraken v1.0";
 #include <components/uFetch/uFetch.hpp>
 #include <components/PhantomCPU/PhantomCPU.hpp>
 
+#include <components/CommonQEMU/PortCodecs.hpp>
+
 #include FLEXUS_END_DECLARATION_SECTION()
 
 #include FLEXUS_BEGIN_COMPONENT_CONFIGURATION_SECTION()
@@ -62,6 +64,13 @@ bool initializeParameters() {
   theFAGCfg.MaxBPred.initialize(1);
   theFAGCfg.BTBSets.initialize(512);
   theFAGCfg.BTBWays.initialize(4);
+  theFAGCfg.TageTables.initialize(7);
+  theFAGCfg.TageLogBimodal.initialize(13);
+  theFAGCfg.TageLogTagged.initialize(9);
+  theFAGCfg.TageTagBits.initialize(12);
+  theFAGCfg.TageCounterBits.initialize(3);
+  theFAGCfg.TageMaxHistory.initialize(131);
+  theFAGCfg.TageMinHistory.initialize(5);
 
   theuFetchCfg.Threads.initialize(1);
   theuFetchCfg.FAQSize.initialize(1000);
@@ -237,6 +246,8 @@ bool initializeParameters() {
   theMMUCfg.PerfectTLB.initialize(true);
 
   thePhantomCfg.EstimatedIPC.initialize(5);
+  thePhantomCfg.BatchCycles.initialize(1);
+  thePhantomCfg.MaxBatchCycles.initialize(0);
 
   theFlexus->setStatInterval(100000);
 